@@ -6,6 +6,7 @@
 
 #include "common/base/Cord.h"
 #include "common/base/Logging.h"
+#include <folly/io/IOBuf.h>
 
 namespace nebula {
 
@@ -127,6 +128,44 @@ std::string Cord::str() const {
 }
 
 
+std::unique_ptr<folly::IOBuf> Cord::moveToIOBuf() {
+    std::unique_ptr<folly::IOBuf> buf;
+
+    char* next = head_;
+    while (next != nullptr) {
+        char* blk = next;
+        size_t len = blockContentSize_;
+        if (blk == tail_) {
+            next = nullptr;
+            len = blockPt_;
+        } else {
+            // Get the pointer to the next block before handing over the current one
+            memcpy(reinterpret_cast<char*>(&next),
+                   blk + blockContentSize_,
+                   sizeof(char*));
+        }
+        // The block is released by free() with the IOBuf
+        auto seg = folly::IOBuf::takeOwnership(blk, blockContentSize_, len);
+        if (buf) {
+            buf->prependChain(std::move(seg));
+        } else {
+            buf = std::move(seg);
+        }
+    }
+
+    // All blocks are owned by the chain now
+    blockPt_ = blockContentSize_;
+    len_ = 0;
+    head_ = nullptr;
+    tail_ = nullptr;
+
+    if (!buf) {
+        buf = folly::IOBuf::create(0);
+    }
+    return buf;
+}
+
+
 Cord& Cord::write(const char* value, size_t len) {
     if (len == 0) {
         return *this;
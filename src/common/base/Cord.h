@@ -9,8 +9,13 @@
 
 #include <stdlib.h>
 #include <functional>
+#include <memory>
 #include <string>
 
+namespace folly {
+class IOBuf;
+}   // namespace folly
+
 namespace nebula {
 
 class Cord {
@@ -30,6 +35,9 @@ public:
     size_t appendTo(std::string& str) const;
     // Convert the cord content to a new string
     std::string str() const;
+    // Move the cord content to an IOBuf chain, whose segments are the cord blocks
+    // themselves, so that nothing is copied. The cord is empty afterwards.
+    std::unique_ptr<folly::IOBuf> moveToIOBuf();
 
     void clear();
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "common/base/Base.h"
+#include <folly/io/IOBuf.h>
 
 namespace nebula {
 
@@ -47,8 +48,8 @@ public:
 
         len_ = 0;
 
-        head_ = nullptr;
-        tail_ = nullptr;
+        head_ = inlineBlock_;
+        tail_ = head_;
     }
 
     // Apply each block to the visitor until the end or the visitor
@@ -101,6 +102,36 @@ public:
         return buf;
     }
 
+    // Move the cord content to an IOBuf chain without flattening, e.g. to set a thrift
+    // binary field or a proxygen response body. The allocated blocks are handed over
+    // to the chain as is, only the inline block is copied. The cord is empty afterwards.
+    std::unique_ptr<folly::IOBuf> moveToIOBuf() {
+        if (empty()) {
+            return folly::IOBuf::create(0);
+        }
+
+        std::size_t lengthModSize = lengthMod();
+        std::size_t lastLength = lengthModSize == 0 ? kBlockContentSize : lengthModSize;
+
+        auto buf = folly::IOBuf::copyBuffer(head_,
+                                            head_ == tail_ ? lastLength : kBlockContentSize);
+        char* n = next(head_);
+        while (n != nullptr) {
+            // Get the next block before handing over the current one
+            char* following = next(n);
+            buf->prependChain(folly::IOBuf::takeOwnership(
+                n, kBlockContentSize, n == tail_ ? lastLength : kBlockContentSize));
+            n = following;
+        }
+
+        // All allocated blocks are owned by the chain now
+        len_ = 0;
+        head_ = inlineBlock_;
+        tail_ = head_;
+
+        return buf;
+    }
+
     ICord<kBlockContentSize>& write(const char* value, size_t len) {
         if (len == 0) {
             return *this;
@@ -0,0 +1,268 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/StringKernels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+namespace nebula {
+namespace strings {
+
+namespace {
+
+// To flip the case of the bytes within [lo, hi]
+void flipCase(folly::StringPiece src, char *dst, char lo, char hi) {
+    auto size = src.size();
+    const auto *data = src.data();
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Bytes above 0x7f are negative, thus never in range
+    const auto loV = _mm_set1_epi8(static_cast<char>(lo - 1));
+    const auto hiV = _mm_set1_epi8(static_cast<char>(hi + 1));
+    const auto flip = _mm_set1_epi8(0x20);
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto inRange = _mm_and_si128(_mm_cmpgt_epi8(v, loV), _mm_cmplt_epi8(v, hiV));
+        v = _mm_xor_si128(v, _mm_and_si128(inRange, flip));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+#endif
+    for (; i < size; i++) {
+        auto c = data[i];
+        dst[i] = (c >= lo && c <= hi) ? static_cast<char>(c ^ 0x20) : c;
+    }
+}
+
+// Candidates are filtered by both the first and the last byte of the needle,
+// then verified by the bytes in between.
+// The kernels search `s' for the needle `n' of `m' bytes, `m' >= 2, starting at
+// no later than `last', and return the offset found or kNotFound.
+size_t findScalar(const char *s, size_t last, const char *n, size_t m) {
+    for (size_t i = 0; i <= last; i++) {
+        if (s[i] == n[0] && s[i + m - 1] == n[m - 1] &&
+            std::memcmp(s + i + 1, n + 1, m - 2) == 0) {
+            return i;
+        }
+    }
+    return kNotFound;
+}
+
+#if defined(__SSE2__)
+size_t findSse2(const char *s, size_t last, const char *n, size_t m) {
+    if (last < 15) {
+        return findScalar(s, last, n, m);
+    }
+    const auto firstV = _mm_set1_epi8(n[0]);
+    const auto lastV = _mm_set1_epi8(n[m - 1]);
+    // 16 candidates per round, the last of which starts at `i + 15'
+    for (size_t i = 0; i <= last; i += 16) {
+        if (i + 15 > last) {
+            // Overlapping the previous round, whose candidates have been rejected
+            i = last - 15;
+        }
+        auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+        auto eq = _mm_and_si128(_mm_cmpeq_epi8(firstV, blockFirst),
+                                _mm_cmpeq_epi8(lastV, blockLast));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        while (mask != 0) {
+            auto offset = i + __builtin_ctz(mask);
+            if (std::memcmp(s + offset + 1, n + 1, m - 2) == 0) {
+                return offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return kNotFound;
+}
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+// Compiled for AVX2 regardless of the target of the build, and only called if the CPU has it
+__attribute__((target("avx2")))
+size_t findAvx2(const char *s, size_t last, const char *n, size_t m) {
+    if (last < 31) {
+        return findSse2(s, last, n, m);
+    }
+    const auto firstV = _mm256_set1_epi8(n[0]);
+    const auto lastV = _mm256_set1_epi8(n[m - 1]);
+    for (size_t i = 0; i <= last; i += 32) {
+        if (i + 31 > last) {
+            i = last - 31;
+        }
+        auto blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+        auto eq = _mm256_and_si256(_mm256_cmpeq_epi8(firstV, blockFirst),
+                                   _mm256_cmpeq_epi8(lastV, blockLast));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        while (mask != 0) {
+            auto offset = i + __builtin_ctz(mask);
+            if (std::memcmp(s + offset + 1, n + 1, m - 2) == 0) {
+                return offset;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return kNotFound;
+}
+#endif
+
+struct FindKernel {
+    size_t    (*fn)(const char*, size_t, const char*, size_t);
+    const char *name;
+};
+
+// The widest kernel supported by the CPU
+FindKernel selectFind() {
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {&findAvx2, "avx2"};
+    }
+#endif
+#if defined(__SSE2__)
+    return {&findSse2, "sse2"};
+#else
+    return {&findScalar, "scalar"};
+#endif
+}
+
+}   // namespace
+
+void toLowerAscii(folly::StringPiece src, char *dst) {
+    flipCase(src, dst, 'A', 'Z');
+}
+
+void toUpperAscii(folly::StringPiece src, char *dst) {
+    flipCase(src, dst, 'a', 'z');
+}
+
+std::string toLower(folly::StringPiece src) {
+    std::string result(src.size(), '\0');
+    toLowerAscii(src, &result[0]);
+    return result;
+}
+
+std::string toUpper(folly::StringPiece src) {
+    std::string result(src.size(), '\0');
+    toUpperAscii(src, &result[0]);
+    return result;
+}
+
+size_t find(folly::StringPiece haystack, folly::StringPiece needle, size_t from) {
+    if (from > haystack.size()) {
+        return kNotFound;
+    }
+    const auto m = needle.size();
+    if (m == 0) {
+        return from;
+    }
+    const auto *s = haystack.data() + from;
+    const auto len = haystack.size() - from;
+    if (len < m) {
+        return kNotFound;
+    }
+    if (m == 1) {
+        const auto *found = static_cast<const char*>(std::memchr(s, needle[0], len));
+        return found == nullptr ? kNotFound : found - haystack.data();
+    }
+    static const auto impl = selectFind();
+    auto offset = impl.fn(s, len - m, needle.data(), m);
+    return offset == kNotFound ? kNotFound : from + offset;
+}
+
+const char* findKernel() {
+    return selectFind().name;
+}
+
+Searcher::Searcher(std::string needle) : needle_(std::move(needle)) {
+    const auto m = needle_.size();
+    if (m < kMinHorspoolSize) {
+        return;
+    }
+    shifts_.assign(256, static_cast<uint32_t>(m));
+    for (size_t i = 0; i + 1 < m; i++) {
+        shifts_[static_cast<uint8_t>(needle_[i])] = static_cast<uint32_t>(m - 1 - i);
+    }
+}
+
+size_t Searcher::find(folly::StringPiece haystack) const {
+    if (shifts_.empty()) {
+        return strings::find(haystack, needle_);
+    }
+    const auto m = needle_.size();
+    if (haystack.size() < m) {
+        return kNotFound;
+    }
+    const auto *s = haystack.data();
+    const auto *n = needle_.data();
+    const auto lastByte = n[m - 1];
+    const auto last = haystack.size() - m;
+    for (size_t i = 0; i <= last; ) {
+        auto c = s[i + m - 1];
+        if (c == lastByte && std::memcmp(s + i, n, m - 1) == 0) {
+            return i;
+        }
+        i += shifts_[static_cast<uint8_t>(c)];
+    }
+    return kNotFound;
+}
+
+std::string replaceAll(folly::StringPiece src, folly::StringPiece from, folly::StringPiece to) {
+    if (from.empty()) {
+        return src.str();
+    }
+    // Count first, to write the result in one pass
+    size_t count = 0;
+    for (auto pos = find(src, from); pos != kNotFound; pos = find(src, from, pos + from.size())) {
+        count++;
+    }
+    if (count == 0) {
+        return src.str();
+    }
+    std::string result(src.size() - count * from.size() + count * to.size(), '\0');
+    auto *out = &result[0];
+    size_t begin = 0;
+    for (auto pos = find(src, from); pos != kNotFound; pos = find(src, from, begin)) {
+        std::memcpy(out, src.data() + begin, pos - begin);
+        out += pos - begin;
+        std::memcpy(out, to.data(), to.size());
+        out += to.size();
+        begin = pos + from.size();
+    }
+    std::memcpy(out, src.data() + begin, src.size() - begin);
+    return result;
+}
+
+std::string reverse(folly::StringPiece src) {
+    return std::string(src.rbegin(), src.rend());
+}
+
+std::string pad(folly::StringPiece src, size_t size, folly::StringPiece pad, bool left) {
+    if (size <= src.size()) {
+        return src.subpiece(0, size).str();
+    }
+    if (pad.empty()) {
+        return src.str();
+    }
+    std::string result(size, '\0');
+    auto padSize = size - src.size();
+    auto *padding = &result[left ? 0 : src.size()];
+    std::memcpy(&result[left ? padSize : 0], src.data(), src.size());
+    // `pad' repeated, and then its prefix for the remainder
+    for (size_t i = 0; i < padSize; i += pad.size()) {
+        std::memcpy(padding + i, pad.data(), std::min(pad.size(), padSize - i));
+    }
+    return result;
+}
+
+}   // namespace strings
+}   // namespace nebula
@@ -0,0 +1,109 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_STRINGKERNELS_H_
+#define COMMON_BASE_STRINGKERNELS_H_
+
+#include "common/base/Base.h"
+
+/**
+ * Kernels of the string functions, which read from views and write each result
+ * exactly once into a pre-sized buffer.
+ *
+ * Case conversion is vectorized with SSE2 when it is available, and falls back
+ * to a scalar loop otherwise. It is ASCII only, other bytes are kept as they are.
+ * Search picks the widest kernel the CPU supports at runtime, of AVX2, SSE2
+ * and a scalar one.
+ */
+
+namespace nebula {
+namespace strings {
+
+constexpr size_t kNotFound = std::string::npos;
+
+// `dst' has at least `src.size()' bytes, which could be `src.data()' itself
+void toLowerAscii(folly::StringPiece src, char *dst);
+void toUpperAscii(folly::StringPiece src, char *dst);
+
+std::string toLower(folly::StringPiece src);
+std::string toUpper(folly::StringPiece src);
+
+/**
+ * The offset of the first occurrence of `needle' in `haystack' from `from',
+ * or kNotFound. An empty `needle' is found at `from' if it is within `haystack'.
+ */
+size_t find(folly::StringPiece haystack, folly::StringPiece needle, size_t from = 0);
+
+// Name of the search kernel picked for the CPU
+const char* findKernel();
+
+inline bool contains(folly::StringPiece haystack, folly::StringPiece needle) {
+    return find(haystack, needle) != kNotFound;
+}
+
+inline bool startsWith(folly::StringPiece str, folly::StringPiece prefix) {
+    return str.size() >= prefix.size() &&
+           std::memcmp(str.data(), prefix.data(), prefix.size()) == 0;
+}
+
+inline bool endsWith(folly::StringPiece str, folly::StringPiece suffix) {
+    return str.size() >= suffix.size() &&
+           std::memcmp(str.data() + str.size() - suffix.size(),
+                       suffix.data(),
+                       suffix.size()) == 0;
+}
+
+/**
+ * A search of the same `needle' over many haystacks, e.g. for CONTAINS with
+ * a constant pattern, which is prepared once.
+ *
+ * Needles of at least kMinHorspoolSize bytes are searched by Horspool's algorithm,
+ * which skips up to the size of the needle per mismatch, the others by find(),
+ * which beats it on the short ones.
+ */
+class Searcher final {
+public:
+    static constexpr size_t kMinHorspoolSize = 32;
+
+    explicit Searcher(std::string needle);
+
+    // The offset of the first occurrence of the needle, or kNotFound
+    size_t find(folly::StringPiece haystack) const;
+
+    bool contains(folly::StringPiece haystack) const {
+        return find(haystack) != kNotFound;
+    }
+
+    const std::string& needle() const {
+        return needle_;
+    }
+
+private:
+    std::string                             needle_;
+    // Shifts by the last byte of the window, empty unless Horspool's is used
+    std::vector<uint32_t>                   shifts_;
+};
+
+/**
+ * To replace all the non-overlapping occurrences of `from' with `to',
+ * leftmost first. `src' is returned as it is if `from' is empty.
+ */
+std::string replaceAll(folly::StringPiece src, folly::StringPiece from, folly::StringPiece to);
+
+// Byte-wise reversal
+std::string reverse(folly::StringPiece src);
+
+/**
+ * To pad `src' to `size' bytes with `pad' repeated, on the left or the right,
+ * or to truncate it to `size' bytes if it is longer.
+ * `src' is returned as it is if `pad' is empty.
+ */
+std::string pad(folly::StringPiece src, size_t size, folly::StringPiece pad, bool left);
+
+}   // namespace strings
+}   // namespace nebula
+
+#endif  // COMMON_BASE_STRINGKERNELS_H_
@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+#ifndef COMMON_BASE_WYHASH_H_
+#define COMMON_BASE_WYHASH_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace nebula {
+
+/**
+ * This is an implementation of wyhash (final version 4), which reads the bytes 16 at a time
+ * and mixes them by the 128-bit products, several times faster than MurmurHash2 on the
+ * strings longer than a word while as good in quality.
+ *
+ * It is for the hashes in memory only, e.g. of the hash tables of the values. Those kept
+ * or sent, e.g. of the partitions of the vids, have to stay with MurmurHash2.
+ */
+class WyHash {
+    template <typename T>
+    static constexpr bool is_char_v = std::is_same<T, char>::value ||
+                                      std::is_same<T, signed char>::value ||
+                                      std::is_same<T, unsigned char>::value;
+
+public:
+    static constexpr uint64_t kSecret[4] = {
+        0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+        0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL,
+    };
+
+    // std::string
+    size_t operator()(const std::string &str) const noexcept {
+        return this->operator()(str.data(), str.length());
+    }
+
+    // literal string(without decay)
+    template <size_t N, typename T, typename = std::enable_if_t<is_char_v<T>>>
+    size_t operator()(const T (&str)[N]) const noexcept {
+        return this->operator()(str, N - 1);
+    }
+
+    // raw bytes array
+    template <typename T, typename = std::enable_if_t<is_char_v<T>>>
+    size_t operator()(const T *str, size_t size, uint64_t seed = 0) const noexcept {
+        auto *p = reinterpret_cast<const uint8_t*>(str);
+        seed ^= mix(seed ^ kSecret[0], kSecret[1]);
+        uint64_t a, b;
+        if (size <= 16) {
+            if (size >= 4) {
+                auto offset = (size >> 3) << 2;
+                a = (read4(p) << 32) | read4(p + offset);
+                b = (read4(p + size - 4) << 32) | read4(p + size - 4 - offset);
+            } else if (size > 0) {
+                a = (static_cast<uint64_t>(p[0]) << 16) |
+                    (static_cast<uint64_t>(p[size >> 1]) << 8) |
+                    p[size - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            auto i = size;
+            if (i > 48) {
+                auto seed1 = seed;
+                auto seed2 = seed;
+                do {
+                    seed = mix(read8(p) ^ kSecret[1], read8(p + 8) ^ seed);
+                    seed1 = mix(read8(p + 16) ^ kSecret[2], read8(p + 24) ^ seed1);
+                    seed2 = mix(read8(p + 32) ^ kSecret[3], read8(p + 40) ^ seed2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while (i > 16) {
+                seed = mix(read8(p) ^ kSecret[1], read8(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+        }
+        a ^= kSecret[1];
+        b ^= seed;
+        multiply(a, b);
+        return mix(a ^ kSecret[0] ^ size, b ^ kSecret[1]);
+    }
+
+    // Of two words, e.g. to combine two hashes
+    static uint64_t mix(uint64_t a, uint64_t b) noexcept {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+private:
+    // The low and the high halves of the product
+    static void multiply(uint64_t &a, uint64_t &b) noexcept {
+        auto product = static_cast<__uint128_t>(a) * b;
+        a = static_cast<uint64_t>(product);
+        b = static_cast<uint64_t>(product >> 64);
+    }
+
+    static uint64_t read8(const uint8_t *p) noexcept {
+        uint64_t v;
+        ::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t read4(const uint8_t *p) noexcept {
+        uint32_t v;
+        ::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+};
+
+}   // namespace nebula
+
+#endif  // COMMON_BASE_WYHASH_H_
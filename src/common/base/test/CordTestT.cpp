@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 #include "common/base/Base.h"
+#include <folly/io/IOBuf.h>
 
 // The testing template for Cord/ICord together
 
@@ -179,6 +180,32 @@ TEST(CordTest, cordStream) {
     EXPECT_EQ(str1 + str2, c1.str());
 }
 
+TEST(CordTest, moveToIOBuf) {
+    {
+        Cord cord;
+        auto buf = cord.moveToIOBuf();
+        EXPECT_EQ(0, buf->computeChainDataLength());
+    }
+    // Within one block, full blocks and a partial last block
+    for (auto size : {10UL, 1024UL * 3, 10000UL}) {
+        Cord cord;
+        std::string expected;
+        for (auto i = 0UL; i < size; i++) {
+            expected.push_back('a' + i % 26);
+        }
+        cord << expected;
+
+        auto buf = cord.moveToIOBuf();
+        EXPECT_TRUE(cord.empty());
+        EXPECT_EQ(size, buf->computeChainDataLength());
+        EXPECT_EQ(expected, buf->moveToFbString().toStdString());
+
+        // The cord is still usable
+        cord << "Hello world!";
+        EXPECT_EQ("Hello world!", cord.str());
+    }
+}
+
 }   // namespace nebula
 
 int main(int argc, char** argv) {
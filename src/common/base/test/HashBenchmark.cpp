@@ -6,8 +6,10 @@
 #include "common/base/Base.h"
 #include <folly/Benchmark.h>
 #include "common/base/MurmurHash2.h"
+#include "common/base/WyHash.h"
 
 using nebula::MurmurHash2;
+using nebula::WyHash;
 
 std::string makeString(size_t size) {
     std::string str;
@@ -46,47 +48,75 @@ size_t MurmurHash2Test(size_t iters, size_t size) {
     return iters * ops;
 }
 
+size_t WyHashTest(size_t iters, size_t size) {
+    constexpr size_t ops = 1000000UL;
+
+    WyHash hash;
+    auto str = makeString(size);
+    auto i = 0UL;
+    while (i++ < ops * iters) {
+        auto hv = hash(str);
+        folly::doNotOptimizeAway(hv);
+    }
+
+    return iters * ops;
+}
+
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 1Byte, 1UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 1Byte, 1UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 1Byte, 1UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 2Byte, 2UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 2Byte, 2UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 2Byte, 2UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 3Byte, 3UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 3Byte, 3UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 3Byte, 3UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 4Byte, 4UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 4Byte, 4UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 4Byte, 4UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 5Byte, 5UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 5Byte, 5UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 5Byte, 5UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 6Byte, 6UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 6Byte, 6UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 6Byte, 6UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 7Byte, 7UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 7Byte, 7UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 7Byte, 7UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 8Byte, 8UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 8Byte, 8UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 8Byte, 8UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 9Byte, 9UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 9Byte, 9UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 9Byte, 9UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 10Byte, 10UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 10Byte, 10UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 10Byte, 10UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 64Byte, 64UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 64Byte, 64UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 64Byte, 64UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 256Byte, 256UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 256Byte, 256UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 256Byte, 256UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 1024Byte, 1024UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 1024Byte, 1024UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 1024Byte, 1024UL)
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM_MULTI(StdHashTest, 4096Byte, 4096UL)
 BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(MurmurHash2Test, 4096Byte, 4096UL)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(WyHashTest, 4096Byte, 4096UL)
 
 int
 main(int argc, char **argv) {
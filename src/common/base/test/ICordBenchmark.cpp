@@ -8,6 +8,7 @@
 #include <folly/Benchmark.h>
 #include "common/base/ICord.h"
 #include "common/base/Cord.h"
+#include <folly/io/IOBuf.h>
 
 using nebula::ICord;
 using nebula::Cord;
@@ -121,6 +122,51 @@ BENCHMARK_RELATIVE(cord_512_mix, iters) {
     }
 }
 
+BENCHMARK_DRAW_LINE();
+
+// Build a query result of about 1MB, then emit it as a whole
+template <typename C>
+static void buildResult(C &cord) {
+    for (int j = 0; j < 20000; j++) {
+        cord << "\"player" << folly::to<std::string>(j) << "\","
+             << "\"Tim Duncan\"," << folly::to<std::string>(42 + j % 10)
+             << ",\"2020-11-19T10:20:30.000000\"\n";
+    }
+}
+
+BENCHMARK(icord_1m_result_str, iters) {
+    for (auto i = 0u; i < iters; i++) {
+        ICord<> cord;
+        buildResult(cord);
+        std::string str = cord.str();
+        folly::doNotOptimizeAway(&str);
+    }
+}
+BENCHMARK_RELATIVE(icord_1m_result_iobuf, iters) {
+    for (auto i = 0u; i < iters; i++) {
+        ICord<> cord;
+        buildResult(cord);
+        auto buf = cord.moveToIOBuf();
+        folly::doNotOptimizeAway(buf.get());
+    }
+}
+BENCHMARK_RELATIVE(cord_1m_result_str, iters) {
+    for (auto i = 0u; i < iters; i++) {
+        Cord cord;
+        buildResult(cord);
+        std::string str = cord.str();
+        folly::doNotOptimizeAway(&str);
+    }
+}
+BENCHMARK_RELATIVE(cord_1m_result_iobuf, iters) {
+    for (auto i = 0u; i < iters; i++) {
+        Cord cord;
+        buildResult(cord);
+        auto buf = cord.moveToIOBuf();
+        folly::doNotOptimizeAway(buf.get());
+    }
+}
+
 int main(int argc, char** argv) {
     folly::init(&argc, &argv, true);
 
@@ -0,0 +1,118 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include <boost/algorithm/string/replace.hpp>
+#include "common/base/StringKernels.h"
+
+namespace nebula {
+
+// Made of few distinct bytes, including the non-ASCII ones and the neighbours of letters,
+// so that partial matches are frequent
+static std::string randomString(size_t maxSize) {
+    static const char kAlphabet[] = "abAB\x80\xff@[`{zZ";
+    auto size = folly::Random::rand32(maxSize + 1);
+    std::string str(size, '\0');
+    for (auto &c : str) {
+        c = kAlphabet[folly::Random::rand32(sizeof(kAlphabet) - 1)];
+    }
+    return str;
+}
+
+TEST(StringKernels, Case) {
+    EXPECT_EQ("", strings::toLower(""));
+    EXPECT_EQ("hello, world@[`{", strings::toLower("HeLLo, World@[`{"));
+    EXPECT_EQ("HELLO, WORLD@[`{", strings::toUpper("HeLLo, World@[`{"));
+    for (auto i = 0; i < 1000; i++) {
+        auto str = randomString(100);
+        auto lower = str;
+        auto upper = str;
+        folly::toLowerAscii(lower);
+        std::transform(upper.begin(), upper.end(), upper.begin(), [] (char c) {
+            return (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+        });
+        EXPECT_EQ(lower, strings::toLower(str));
+        EXPECT_EQ(upper, strings::toUpper(str));
+        // In place
+        strings::toUpperAscii(str, &str[0]);
+        EXPECT_EQ(upper, str);
+    }
+}
+
+TEST(StringKernels, Find) {
+    EXPECT_EQ(0, strings::find("", ""));
+    EXPECT_EQ(strings::kNotFound, strings::find("", "a"));
+    EXPECT_EQ(strings::kNotFound, strings::find("abc", "", 4));
+    EXPECT_EQ(39, strings::find(std::string(40, 'a') + "bc", "abc"));
+    EXPECT_TRUE(strings::contains("nebula graph", "graph"));
+    EXPECT_FALSE(strings::contains("nebula graph", "Graph"));
+    EXPECT_TRUE(strings::startsWith("nebula", ""));
+    EXPECT_TRUE(strings::startsWith("nebula", "neb"));
+    EXPECT_FALSE(strings::startsWith("neb", "nebula"));
+    EXPECT_TRUE(strings::endsWith("nebula", "ula"));
+    EXPECT_FALSE(strings::endsWith("nebula", "nebul"));
+    for (auto i = 0; i < 10000; i++) {
+        auto haystack = randomString(100);
+        auto needle = randomString(5);
+        auto from = folly::Random::rand32(haystack.size() + 2);
+        auto expected = from > haystack.size() ? std::string::npos : haystack.find(needle, from);
+        EXPECT_EQ(expected, strings::find(haystack, needle, from))
+            << "haystack: " << folly::hexlify(haystack) << ", needle: " << folly::hexlify(needle);
+    }
+}
+
+TEST(StringKernels, Searcher) {
+    EXPECT_EQ(0, strings::Searcher("").find("abc"));
+    EXPECT_EQ(strings::kNotFound, strings::Searcher("abc").find("ab"));
+    std::string longNeedle(strings::Searcher::kMinHorspoolSize, 'a');
+    longNeedle.back() = 'b';
+    EXPECT_EQ(1, strings::Searcher(longNeedle).find("a" + longNeedle + "a"));
+    EXPECT_EQ(strings::kNotFound, strings::Searcher(longNeedle).find(std::string(100, 'a')));
+    for (auto i = 0; i < 10000; i++) {
+        // Across the sizes searched by find() and by Horspool's
+        auto haystack = randomString(200);
+        auto needle = randomString(2 * strings::Searcher::kMinHorspoolSize);
+        if (!needle.empty() && needle.size() < haystack.size() && folly::Random::oneIn(2)) {
+            auto pos = folly::Random::rand32(haystack.size() - needle.size());
+            haystack.replace(pos, needle.size(), needle);
+        }
+        strings::Searcher searcher(needle);
+        EXPECT_EQ(haystack.find(needle), searcher.find(haystack))
+            << "haystack: " << folly::hexlify(haystack) << ", needle: " << folly::hexlify(needle);
+    }
+}
+
+TEST(StringKernels, ReplaceAll) {
+    EXPECT_EQ("abZZZfghi", strings::replaceAll("abcdefghi", "cde", "ZZZ"));
+    EXPECT_EQ("abc", strings::replaceAll("abc", "", "Z"));
+    EXPECT_EQ("ba", strings::replaceAll("aaaa", "aaa", "b"));
+    for (auto i = 0; i < 10000; i++) {
+        auto src = randomString(100);
+        auto from = randomString(3);
+        auto to = randomString(3);
+        if (from.empty()) {
+            continue;
+        }
+        EXPECT_EQ(boost::replace_all_copy(src, from, to), strings::replaceAll(src, from, to));
+    }
+}
+
+TEST(StringKernels, Pad) {
+    EXPECT_EQ("1231abcdefghijkl", strings::pad("abcdefghijkl", 16, "123", true));
+    EXPECT_EQ("abcdefghijkl1231", strings::pad("abcdefghijkl", 16, "123", false));
+    EXPECT_EQ("abc", strings::pad("abcdefghijkl", 3, "123", true));
+    EXPECT_EQ("abc", strings::pad("abc", 3, "123", false));
+    EXPECT_EQ("abc", strings::pad("abc", 10, "", false));
+    EXPECT_EQ("", strings::pad("abc", 0, "1", true));
+}
+
+TEST(StringKernels, Reverse) {
+    EXPECT_EQ("", strings::reverse(""));
+    EXPECT_EQ("ytrewq", strings::reverse("qwerty"));
+}
+
+}   // namespace nebula
@@ -0,0 +1,137 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/base/StringKernels.h"
+
+using nebula::strings::Searcher;
+
+// Log-like lines of 60 to 300 bytes, of which about 1% are errors
+static std::vector<std::string> makeLines() {
+    static const std::vector<std::string> modules = {
+        "storaged", "metad", "graphd", "raftex", "rocksdb",
+    };
+    static const std::vector<std::string> messages = {
+        "request processed",
+        "leader changed, term ",
+        "compaction finished for part ",
+        "heartbeat sent to meta server",
+        "slow query detected, statement: GO FROM \"player100\" OVER follow YIELD follow._dst",
+    };
+    std::vector<std::string> lines;
+    lines.reserve(10000);
+    for (auto i = 0; i < 10000; i++) {
+        auto isError = folly::Random::oneIn(100);
+        auto line = folly::stringPrintf(
+            "2020-11-03 12:%02u:%02u.%03u %s [%s] %s%u",
+            folly::Random::rand32(60),
+            folly::Random::rand32(60),
+            folly::Random::rand32(1000),
+            isError ? "ERROR" : "INFO",
+            modules[folly::Random::rand32(modules.size())].c_str(),
+            isError ? "Failed to connect to the meta server, will retry later "
+                    : messages[folly::Random::rand32(messages.size())].c_str(),
+            folly::Random::rand32(100000));
+        // Random payloads, e.g. of keys and values
+        auto payload = folly::Random::rand32(200);
+        for (auto j = 0U; j < payload; j++) {
+            line += static_cast<char>(folly::Random::rand32(0x21, 0x7F));
+        }
+        line += " took ";
+        line += folly::to<std::string>(folly::Random::rand32(10000));
+        line += "us";
+        lines.emplace_back(std::move(line));
+    }
+    return lines;
+}
+
+static const std::vector<std::string> kLines = makeLines();
+
+static const std::string kShort = "ERROR";
+static const std::string kMedium = "[storaged]";
+static const std::string kLong = "Failed to connect to the meta server, will retry later";
+
+size_t stdFind(size_t iters, const std::string &needle) {
+    size_t found = 0;
+    for (auto i = 0UL; i < iters; i++) {
+        for (const auto &line : kLines) {
+            found += line.find(needle) != std::string::npos;
+        }
+    }
+    folly::doNotOptimizeAway(found);
+    return iters * kLines.size();
+}
+
+size_t kernelFind(size_t iters, const std::string &needle) {
+    size_t found = 0;
+    for (auto i = 0UL; i < iters; i++) {
+        for (const auto &line : kLines) {
+            found += nebula::strings::contains(line, needle);
+        }
+    }
+    folly::doNotOptimizeAway(found);
+    return iters * kLines.size();
+}
+
+size_t searcherFind(size_t iters, const std::string &needle) {
+    size_t found = 0;
+    Searcher searcher(needle);
+    for (auto i = 0UL; i < iters; i++) {
+        for (const auto &line : kLines) {
+            found += searcher.contains(line);
+        }
+    }
+    folly::doNotOptimizeAway(found);
+    return iters * kLines.size();
+}
+
+size_t stdStartsWith(size_t iters, const std::string &prefix) {
+    size_t found = 0;
+    for (auto i = 0UL; i < iters; i++) {
+        for (const auto &line : kLines) {
+            found += line.size() >= prefix.size() && line.find(prefix) == 0;
+        }
+    }
+    folly::doNotOptimizeAway(found);
+    return iters * kLines.size();
+}
+
+size_t kernelStartsWith(size_t iters, const std::string &prefix) {
+    size_t found = 0;
+    for (auto i = 0UL; i < iters; i++) {
+        for (const auto &line : kLines) {
+            found += nebula::strings::startsWith(line, prefix);
+        }
+    }
+    folly::doNotOptimizeAway(found);
+    return iters * kLines.size();
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(stdFind, short, kShort)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(kernelFind, short, kShort)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(searcherFind, short, kShort)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(stdFind, medium, kMedium)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(kernelFind, medium, kMedium)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(searcherFind, medium, kMedium)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(stdFind, long, kLong)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(kernelFind, long, kLong)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(searcherFind, long, kLong)
+BENCHMARK_DRAW_LINE();
+// A prefix which misses at its last byte
+BENCHMARK_NAMED_PARAM_MULTI(stdStartsWith, prefix, std::string("2020-11-03 12:00:00.000 X"))
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(kernelStartsWith,
+                                     prefix,
+                                     std::string("2020-11-03 12:00:00.000 X"))
+
+int main(int argc, char **argv) {
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    LOG(INFO) << "Search kernel: " << nebula::strings::findKernel();
+    folly::runBenchmarks();
+    return 0;
+}
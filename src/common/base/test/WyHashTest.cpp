@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/base/WyHash.h"
+
+namespace nebula {
+
+TEST(WyHash, Basic) {
+    WyHash hash;
+    {
+#define LITERAL "Another one bites the dust"
+        const char *cstr = LITERAL;
+        std::string str = cstr;
+        auto hv1 = hash(LITERAL);
+        auto hv2 = hash(cstr, ::strlen(cstr));
+        auto hv3 = hash(str);
+        ASSERT_EQ(hv1, hv2);
+        ASSERT_EQ(hv2, hv3);
+        ASSERT_NE(hv3, hash(cstr, ::strlen(cstr), 1));
+#undef LITERAL
+    }
+    // Of every length up to beyond the blocks of 48 bytes
+    {
+        std::string str;
+        std::unordered_set<size_t> hashes;
+        for (size_t size = 0; size < 200; size++) {
+            hashes.emplace(hash(str));
+            str.push_back('\0');
+        }
+        ASSERT_EQ(200, hashes.size());
+    }
+    // A flipped bit flips about half of the hash
+    {
+        for (size_t size : {1UL, 3UL, 4UL, 8UL, 16UL, 17UL, 48UL, 49UL, 100UL}) {
+            auto str = folly::to<std::string>(folly::Random::rand64());
+            str.resize(size, 'x');
+            auto hv = hash(str);
+            size_t flipped = 0;
+            for (size_t bit = 0; bit < size * 8; bit++) {
+                auto other = str;
+                other[bit / 8] ^= 1 << (bit % 8);
+                flipped += __builtin_popcountll(hv ^ hash(other));
+            }
+            auto ratio = static_cast<double>(flipped) / (size * 8 * 64);
+            EXPECT_GT(ratio, 0.4) << size;
+            EXPECT_LT(ratio, 0.6) << size;
+        }
+    }
+}
+
+}   // namespace nebula
@@ -26,16 +26,90 @@ GraphStorageClient::getNeighbors(GraphSpaceID space,
                                  int64_t limit,
                                  std::string filter,
                                  folly::EventBase* evb) {
+    auto requests = getNeighborsRequests(space, std::move(colNames), vertices,
+                                         edgeTypes, edgeDirection, statProps,
+                                         vertexProps, edgeProps, expressions,
+                                         dedup, random, orderBy, limit, std::move(filter));
+    if (!requests.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
+            std::runtime_error(requests.status().toString()));
+    }
+
+    return collectResponse(
+        evb, std::move(requests).value(),
+        [] (cpp2::GraphStorageServiceAsyncClient* client,
+            const cpp2::GetNeighborsRequest& r) {
+            return client->future_getNeighbors(r);
+        });
+}
+
+
+StatusOr<std::shared_ptr<GraphStorageClient::GetNeighborsStream>>
+GraphStorageClient::getNeighborsStream(GraphSpaceID space,
+                                       std::vector<std::string> colNames,
+                                       const std::vector<Row>& vertices,
+                                       const std::vector<EdgeType>& edgeTypes,
+                                       cpp2::EdgeDirection edgeDirection,
+                                       const std::vector<cpp2::StatProp>* statProps,
+                                       const std::vector<cpp2::VertexProp>* vertexProps,
+                                       const std::vector<cpp2::EdgeProp>* edgeProps,
+                                       const std::vector<cpp2::Expr>* expressions,
+                                       int64_t chunkBytes,
+                                       bool dedup,
+                                       bool random,
+                                       const std::vector<cpp2::OrderBy>& orderBy,
+                                       int64_t limit,
+                                       std::string filter,
+                                       folly::EventBase* evb) {
+    auto requests = getNeighborsRequests(space, std::move(colNames), vertices,
+                                         edgeTypes, edgeDirection, statProps,
+                                         vertexProps, edgeProps, expressions,
+                                         dedup, random, orderBy, limit, std::move(filter));
+    NG_RETURN_IF_ERROR(requests);
+
+    std::vector<std::pair<HostAddr, cpp2::GetNeighborsRequest>> chunked;
+    chunked.reserve(requests.value().size());
+    for (auto& request : requests.value()) {
+        request.second.set_chunk_bytes(chunkBytes);
+        chunked.emplace_back(request.first, std::move(request.second));
+    }
+
+    return GetNeighborsStream::start(
+        std::move(chunked),
+        [this, evb] (const HostAddr& host, const cpp2::GetNeighborsRequest& req) {
+            return getResponse(
+                evb, std::make_pair(host, req),
+                [] (cpp2::GraphStorageServiceAsyncClient* client,
+                    const cpp2::GetNeighborsRequest& r) {
+                    return client->future_getNeighbors(r);
+                });
+        });
+}
+
+
+StatusOr<std::unordered_map<HostAddr, cpp2::GetNeighborsRequest>>
+GraphStorageClient::getNeighborsRequests(GraphSpaceID space,
+                                         std::vector<std::string> colNames,
+                                         const std::vector<Row>& vertices,
+                                         const std::vector<EdgeType>& edgeTypes,
+                                         cpp2::EdgeDirection edgeDirection,
+                                         const std::vector<cpp2::StatProp>* statProps,
+                                         const std::vector<cpp2::VertexProp>* vertexProps,
+                                         const std::vector<cpp2::EdgeProp>* edgeProps,
+                                         const std::vector<cpp2::Expr>* expressions,
+                                         bool dedup,
+                                         bool random,
+                                         const std::vector<cpp2::OrderBy>& orderBy,
+                                         int64_t limit,
+                                         std::string filter) {
     auto cbStatus = getIdFromRow(space, false);
     if (!cbStatus.ok()) {
-        return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
-            std::runtime_error(cbStatus.status().toString()));
+        return cbStatus.status();
     }
 
     auto status = clusterIdsToHosts(space, vertices, std::move(cbStatus).value());
     if (!status.ok()) {
-        return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
-            std::runtime_error(status.status().toString()));
+        return status.status();
     }
 
     auto& clusters = status.value();
@@ -72,14 +146,9 @@ GraphStorageClient::getNeighbors(GraphSpaceID space,
             spec.set_filter(filter);
         }
         req.set_traverse_spec(std::move(spec));
+        req.set_accept_packed_rows(true);
     }
-
-    return collectResponse(
-        evb, std::move(requests),
-        [] (cpp2::GraphStorageServiceAsyncClient* client,
-            const cpp2::GetNeighborsRequest& r) {
-            return client->future_getNeighbors(r);
-        });
+    return requests;
 }
 
 
@@ -540,6 +609,56 @@ GraphStorageClient::scanVertex(cpp2::ScanVertexRequest req,
         });
 }
 
+StatusOr<std::shared_ptr<GraphStorageClient::ScanEdgeStream>>
+GraphStorageClient::scanEdgeStream(std::vector<cpp2::ScanEdgeRequest> reqs,
+                                   int64_t chunkBytes,
+                                   folly::EventBase* evb) {
+    std::vector<std::pair<HostAddr, cpp2::ScanEdgeRequest>> requests;
+    requests.reserve(reqs.size());
+    for (auto& req : reqs) {
+        auto host = this->getLeader(req.get_space_id(), req.get_part_id());
+        NG_RETURN_IF_ERROR(host);
+        req.set_chunk_bytes(chunkBytes);
+        requests.emplace_back(std::move(host).value(), std::move(req));
+    }
+
+    return ScanEdgeStream::start(
+        std::move(requests),
+        [this, evb] (const HostAddr& host, const cpp2::ScanEdgeRequest& req) {
+            return getResponse(
+                evb, std::make_pair(host, req),
+                [] (cpp2::GraphStorageServiceAsyncClient* client,
+                    const cpp2::ScanEdgeRequest& r) {
+                    return client->future_scanEdge(r);
+                });
+        });
+}
+
+StatusOr<std::shared_ptr<GraphStorageClient::ScanVertexStream>>
+GraphStorageClient::scanVertexStream(std::vector<cpp2::ScanVertexRequest> reqs,
+                                     int64_t chunkBytes,
+                                     folly::EventBase* evb) {
+    std::vector<std::pair<HostAddr, cpp2::ScanVertexRequest>> requests;
+    requests.reserve(reqs.size());
+    for (auto& req : reqs) {
+        auto host = this->getLeader(req.get_space_id(), req.get_part_id());
+        NG_RETURN_IF_ERROR(host);
+        req.set_chunk_bytes(chunkBytes);
+        requests.emplace_back(std::move(host).value(), std::move(req));
+    }
+
+    return ScanVertexStream::start(
+        std::move(requests),
+        [this, evb] (const HostAddr& host, const cpp2::ScanVertexRequest& req) {
+            return getResponse(
+                evb, std::make_pair(host, req),
+                [] (cpp2::GraphStorageServiceAsyncClient* client,
+                    const cpp2::ScanVertexRequest& r) {
+                    return client->future_scanVertex(r);
+                });
+        });
+}
+
 StatusOr<std::function<const VertexID&(const Row&)>> GraphStorageClient::getIdFromRow(
     GraphSpaceID space, bool isEdgeProps) const {
     auto vidTypeStatus = metaClient_->getSpaceVidType(space);
@@ -11,6 +11,7 @@
 #include <gtest/gtest_prod.h>
 #include "common/interface/gen-cpp2/GraphStorageServiceAsyncClient.h"
 #include "common/clients/storage/StorageClientBase.h"
+#include "common/clients/storage/StorageStream.h"
 
 
 namespace nebula {
@@ -27,6 +28,11 @@ class GraphStorageClient : public StorageClientBase<cpp2::GraphStorageServiceAsy
     using Parent = StorageClientBase<cpp2::GraphStorageServiceAsyncClient>;
 
 public:
+    using GetNeighborsStream = StorageStream<cpp2::GetNeighborsRequest,
+                                             cpp2::GetNeighborsResponse>;
+    using ScanEdgeStream = StorageStream<cpp2::ScanEdgeRequest, cpp2::ScanEdgeResponse>;
+    using ScanVertexStream = StorageStream<cpp2::ScanVertexRequest, cpp2::ScanVertexResponse>;
+
     GraphStorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
                        meta::MetaClient* metaClient)
         : Parent(ioThreadPool, metaClient) {}
@@ -50,6 +56,27 @@ public:
         std::string filter = std::string(),
         folly::EventBase* evb = nullptr);
 
+    // As getNeighbors(), but each storage returns the vertices in the chunks of about
+    // `chunkBytes', which are taken as soon as they arrive
+    StatusOr<std::shared_ptr<GetNeighborsStream>> getNeighborsStream(
+        GraphSpaceID space,
+        std::vector<std::string> colNames,
+        // The first column has to be the VertexID
+        const std::vector<Row>& vertices,
+        const std::vector<EdgeType>& edgeTypes,
+        cpp2::EdgeDirection edgeDirection,
+        const std::vector<cpp2::StatProp>* statProps,
+        const std::vector<cpp2::VertexProp>* vertexProps,
+        const std::vector<cpp2::EdgeProp>* edgeProps,
+        const std::vector<cpp2::Expr>* expressions,
+        int64_t chunkBytes,
+        bool dedup = false,
+        bool random = false,
+        const std::vector<cpp2::OrderBy>& orderBy = std::vector<cpp2::OrderBy>(),
+        int64_t limit = std::numeric_limits<int64_t>::max(),
+        std::string filter = std::string(),
+        folly::EventBase* evb = nullptr);
+
     folly::SemiFuture<StorageRpcResponse<cpp2::GetPropResponse>> getProps(
         GraphSpaceID space,
         const DataSet& input,
@@ -133,7 +160,34 @@ public:
         cpp2::ScanVertexRequest req,
         folly::EventBase* evb = nullptr);
 
+    // The scans of some parts, each of which is resumed by its cursor until done
+    StatusOr<std::shared_ptr<ScanEdgeStream>> scanEdgeStream(
+        std::vector<cpp2::ScanEdgeRequest> reqs,
+        int64_t chunkBytes,
+        folly::EventBase* evb = nullptr);
+
+    StatusOr<std::shared_ptr<ScanVertexStream>> scanVertexStream(
+        std::vector<cpp2::ScanVertexRequest> reqs,
+        int64_t chunkBytes,
+        folly::EventBase* evb = nullptr);
+
 private:
+    StatusOr<std::unordered_map<HostAddr, cpp2::GetNeighborsRequest>> getNeighborsRequests(
+        GraphSpaceID space,
+        std::vector<std::string> colNames,
+        const std::vector<Row>& vertices,
+        const std::vector<EdgeType>& edgeTypes,
+        cpp2::EdgeDirection edgeDirection,
+        const std::vector<cpp2::StatProp>* statProps,
+        const std::vector<cpp2::VertexProp>* vertexProps,
+        const std::vector<cpp2::EdgeProp>* edgeProps,
+        const std::vector<cpp2::Expr>* expressions,
+        bool dedup,
+        bool random,
+        const std::vector<cpp2::OrderBy>& orderBy,
+        int64_t limit,
+        std::string filter);
+
     StatusOr<std::function<const VertexID&(const Row&)>>
         getIdFromRow(GraphSpaceID space, bool isEdgeProps) const;
 
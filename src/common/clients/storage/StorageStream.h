@@ -0,0 +1,214 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CLIENTS_STORAGE_STORAGESTREAM_H_
+#define COMMON_CLIENTS_STORAGE_STORAGESTREAM_H_
+
+#include "common/base/Base.h"
+#include <folly/Optional.h>
+#include <folly/futures/Future.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+#include "common/base/StatusOr.h"
+#include "common/datatypes/HostAddr.h"
+#include "common/interface/gen-cpp2/storage_types.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * The chunks of the responses of some requests, each of which is resumed with the cursor of
+ * its last chunk until the storage returns no more. A host is asked for its next chunk only
+ * after the last one is taken by next(), so that at most one chunk of each host is buffered,
+ * however large the whole result is.
+ *
+ * The chunks come in the order received. A failed request ends the chunks of its host, with
+ * the error returned by next() in place of a chunk. So does a part in the failed_parts of
+ * a chunk, which ends the chunks of that part only, and is not asked for again.
+ * An absent or empty cursor ends the chunks of a host.
+ */
+template<class Request, class Response>
+class StorageStream final
+    : public std::enable_shared_from_this<StorageStream<Request, Response>> {
+public:
+    using Fetch = std::function<folly::Future<StatusOr<Response>>(const HostAddr&,
+                                                                  const Request&)>;
+
+    static std::shared_ptr<StorageStream> start(
+            std::vector<std::pair<HostAddr, Request>> requests,
+            Fetch fetch) {
+        std::shared_ptr<StorageStream> stream(new StorageStream(std::move(fetch)));
+        stream->ongoing_ = requests.size();
+        for (auto &request : requests) {
+            stream->fetch(std::move(request));
+        }
+        return stream;
+    }
+
+    // The next chunk of any host, or none after the last one
+    folly::SemiFuture<StatusOr<folly::Optional<Response>>> next() {
+        Chunk chunk;
+        folly::Promise<StatusOr<folly::Optional<Response>>> promise;
+        auto future = promise.getSemiFuture();
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            if (chunks_.empty()) {
+                if (ongoing_ == 0) {
+                    return folly::makeSemiFuture(
+                        StatusOr<folly::Optional<Response>>(folly::Optional<Response>()));
+                }
+                waiters_.emplace_back(std::move(promise));
+                return future;
+            }
+            chunk = std::move(chunks_.front());
+            chunks_.pop_front();
+        }
+        take(std::move(chunk), std::move(promise));
+        return future;
+    }
+
+private:
+    struct Chunk {
+        StatusOr<Response>                                  response;
+        // The request for the next chunk of the same host
+        folly::Optional<std::pair<HostAddr, Request>>       resume;
+        // Whether it ends the chunks of its host if not resumed, unlike a failed part
+        bool                                                ending{true};
+    };
+
+    explicit StorageStream(Fetch fetch) : fetch_(std::move(fetch)) {}
+
+    static const std::string* nonEmpty(const std::string *cursor) {
+        return cursor != nullptr && !cursor->empty() ? cursor : nullptr;
+    }
+
+    static const std::string* nextCursor(const cpp2::GetNeighborsResponse &resp) {
+        return nonEmpty(resp.get_next_cursor());
+    }
+
+    static const std::string* nextCursor(const cpp2::ScanVertexResponse &resp) {
+        return resp.get_has_next() ? nonEmpty(resp.get_next_cursor()) : nullptr;
+    }
+
+    static const std::string* nextCursor(const cpp2::ScanEdgeResponse &resp) {
+        return resp.get_has_next() ? nonEmpty(resp.get_next_cursor()) : nullptr;
+    }
+
+    // To drop `failed' from `req', and return whether any part of it is left
+    static bool dropParts(cpp2::GetNeighborsRequest &req,
+                          const std::vector<cpp2::PartitionResult> &failed) {
+        for (const auto &part : failed) {
+            (*req.parts_ref()).erase(part.get_part_id());
+        }
+        return !req.get_parts().empty();
+    }
+
+    // A scan is of a single part
+    template <class ScanRequest>
+    static bool dropParts(ScanRequest&, const std::vector<cpp2::PartitionResult> &failed) {
+        return failed.empty();
+    }
+
+    void fetch(std::pair<HostAddr, Request> request) {
+        auto self = this->shared_from_this();
+        auto host = request.first;
+        fetch_(host, request.second)
+            .thenTry([self, request = std::move(request)]
+                     (folly::Try<StatusOr<Response>>&& t) mutable {
+                StatusOr<Response> resp;
+                if (t.hasException()) {
+                    resp = Status::Error("RPC failure in StorageStream: %s",
+                                         t.exception().what().c_str());
+                } else {
+                    resp = std::move(t).value();
+                }
+                Chunk chunk;
+                std::vector<Chunk> failures;
+                bool left = true;
+                if (resp.ok()) {
+                    const auto &failed = resp.value().get_result().get_failed_parts();
+                    for (const auto &part : failed) {
+                        Chunk failure;
+                        failure.response = Status::Error(
+                            "Part %d failed in StorageStream: %s",
+                            part.get_part_id(),
+                            apache::thrift::util::enumNameSafe(part.get_code()).c_str());
+                        failure.ending = false;
+                        failures.emplace_back(std::move(failure));
+                    }
+                    left = dropParts(request.second, failed);
+                    auto *cursor = nextCursor(resp.value());
+                    if (left && cursor != nullptr) {
+                        request.second.set_cursor(*cursor);
+                        chunk.resume = std::move(request);
+                    }
+                }
+                if (!left) {
+                    // Nothing but the failures, the last one of which ends the host
+                    failures.back().ending = true;
+                } else {
+                    chunk.response = std::move(resp);
+                }
+                for (auto &failure : failures) {
+                    self->put(std::move(failure));
+                }
+                if (left) {
+                    self->put(std::move(chunk));
+                }
+            });
+    }
+
+    void put(Chunk chunk) {
+        folly::Promise<StatusOr<folly::Optional<Response>>> waiter;
+        std::vector<folly::Promise<StatusOr<folly::Optional<Response>>>> ended;
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            if (chunk.ending && !chunk.resume) {
+                --ongoing_;
+            }
+            if (waiters_.empty()) {
+                chunks_.emplace_back(std::move(chunk));
+                return;
+            }
+            waiter = std::move(waiters_.front());
+            waiters_.pop_front();
+            if (ongoing_ == 0) {
+                // No more chunks for the others waiting
+                ended.reserve(waiters_.size());
+                std::move(waiters_.begin(), waiters_.end(), std::back_inserter(ended));
+                waiters_.clear();
+            }
+        }
+        take(std::move(chunk), std::move(waiter));
+        for (auto &p : ended) {
+            p.setValue(folly::Optional<Response>());
+        }
+    }
+
+    // Hands `chunk' to `promise' and asks for the next one of its host
+    void take(Chunk chunk, folly::Promise<StatusOr<folly::Optional<Response>>> promise) {
+        if (chunk.resume) {
+            fetch(std::move(chunk.resume).value());
+        }
+        if (chunk.response.ok()) {
+            promise.setValue(folly::Optional<Response>(std::move(chunk.response).value()));
+        } else {
+            promise.setValue(chunk.response.status());
+        }
+    }
+
+private:
+    const Fetch                                                             fetch_;
+    std::mutex                                                              lock_;
+    // The hosts of which the last chunk is not received yet
+    size_t                                                                  ongoing_{0};
+    std::deque<Chunk>                                                       chunks_;
+    std::deque<folly::Promise<StatusOr<folly::Optional<Response>>>>        waiters_;
+};
+
+}   // namespace storage
+}   // namespace nebula
+
+#endif  // COMMON_CLIENTS_STORAGE_STORAGESTREAM_H_
@@ -0,0 +1,233 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/clients/storage/StorageStream.h"
+
+namespace nebula {
+namespace storage {
+
+// The storage answering each request fetched when told to, on the calling thread
+template<class Request, class Response>
+class FakeStorage final {
+public:
+    using Stream = StorageStream<Request, Response>;
+
+    struct Call {
+        HostAddr                                host;
+        Request                                 req;
+        folly::Promise<StatusOr<Response>>      promise;
+    };
+
+    typename Stream::Fetch fetch() {
+        return [this] (const HostAddr& host, const Request& req) {
+            calls.emplace_back(Call{host, req, folly::Promise<StatusOr<Response>>()});
+            return calls.back().promise.getFuture();
+        };
+    }
+
+    std::deque<Call>                            calls;
+};
+
+using ScanStorage = FakeStorage<cpp2::ScanEdgeRequest, cpp2::ScanEdgeResponse>;
+using NeighborsStorage = FakeStorage<cpp2::GetNeighborsRequest, cpp2::GetNeighborsResponse>;
+
+static const HostAddr kHost1("host1", 9779);
+static const HostAddr kHost2("host2", 9779);
+
+static cpp2::ResponseCommon result(std::vector<cpp2::PartitionResult> failed = {}) {
+    cpp2::ResponseCommon common;
+    common.set_failed_parts(std::move(failed));
+    common.set_latency_in_us(0);
+    return common;
+}
+
+static cpp2::PartitionResult failedPart(PartitionID part) {
+    cpp2::PartitionResult failed;
+    failed.set_code(nebula::cpp2::ErrorCode::E_PART_NOT_FOUND);
+    failed.set_part_id(part);
+    return failed;
+}
+
+static std::pair<HostAddr, cpp2::ScanEdgeRequest> scanRequest(const HostAddr& host,
+                                                              PartitionID part) {
+    cpp2::ScanEdgeRequest req;
+    req.set_space_id(1);
+    req.set_part_id(part);
+    return std::make_pair(host, std::move(req));
+}
+
+// A chunk told by the name of its only column
+static cpp2::ScanEdgeResponse scanChunk(const std::string& name,
+                                        folly::Optional<std::string> cursor = folly::none) {
+    cpp2::ScanEdgeResponse resp;
+    resp.set_result(result());
+    resp.set_edge_data(DataSet({name}));
+    resp.set_has_next(cursor.hasValue());
+    if (cursor.hasValue()) {
+        resp.set_next_cursor(*cursor);
+    }
+    return resp;
+}
+
+template<class Response>
+static StatusOr<folly::Optional<Response>> get(
+        folly::SemiFuture<StatusOr<folly::Optional<Response>>> future) {
+    EXPECT_TRUE(future.isReady());
+    return std::move(future).get();
+}
+
+static std::string nameOf(const StatusOr<folly::Optional<cpp2::ScanEdgeResponse>>& chunk) {
+    EXPECT_TRUE(chunk.ok());
+    EXPECT_TRUE(chunk.value().hasValue());
+    return chunk.value()->get_edge_data().colNames.front();
+}
+
+TEST(StorageStream, Interleave) {
+    ScanStorage storage;
+    auto stream = ScanStorage::Stream::start(
+        {scanRequest(kHost1, 1), scanRequest(kHost2, 2)}, storage.fetch());
+    ASSERT_EQ(2, storage.calls.size());
+
+    // In the order received, no matter the parts
+    storage.calls[1].promise.setValue(scanChunk("2a", std::string("c2")));
+    storage.calls[0].promise.setValue(scanChunk("1a", std::string("c1")));
+    // Resumed only after the last chunk is taken
+    EXPECT_EQ(2, storage.calls.size());
+    EXPECT_EQ("2a", nameOf(get(stream->next())));
+    ASSERT_EQ(3, storage.calls.size());
+    EXPECT_EQ(2, storage.calls[2].req.get_part_id());
+    EXPECT_EQ("c2", *storage.calls[2].req.get_cursor());
+
+    auto pending = stream->next();
+    EXPECT_EQ("1a", nameOf(get(std::move(pending))));
+    ASSERT_EQ(4, storage.calls.size());
+    EXPECT_EQ(kHost1, storage.calls[3].host);
+    EXPECT_EQ("c1", *storage.calls[3].req.get_cursor());
+
+    pending = stream->next();
+    EXPECT_FALSE(pending.isReady());
+    storage.calls[3].promise.setValue(scanChunk("1b"));
+    EXPECT_EQ("1b", nameOf(get(std::move(pending))));
+    storage.calls[2].promise.setValue(scanChunk("2b"));
+    EXPECT_EQ("2b", nameOf(get(stream->next())));
+
+    auto end = get(stream->next());
+    ASSERT_TRUE(end.ok());
+    EXPECT_FALSE(end.value().hasValue());
+    EXPECT_EQ(4, storage.calls.size());
+}
+
+TEST(StorageStream, EmptyCursor) {
+    ScanStorage storage;
+    auto stream = ScanStorage::Stream::start({scanRequest(kHost1, 1)}, storage.fetch());
+    // Of more but without a cursor to resume
+    storage.calls[0].promise.setValue(scanChunk("1a", std::string("")));
+    EXPECT_EQ("1a", nameOf(get(stream->next())));
+    EXPECT_EQ(1, storage.calls.size());
+    auto end = get(stream->next());
+    ASSERT_TRUE(end.ok());
+    EXPECT_FALSE(end.value().hasValue());
+}
+
+TEST(StorageStream, RpcError) {
+    ScanStorage storage;
+    auto stream = ScanStorage::Stream::start(
+        {scanRequest(kHost1, 1), scanRequest(kHost2, 2)}, storage.fetch());
+    storage.calls[0].promise.setValue(scanChunk("1a", std::string("c1")));
+    EXPECT_EQ("1a", nameOf(get(stream->next())));
+    ASSERT_EQ(3, storage.calls.size());
+
+    // Part way through, which ends the chunks of its host only
+    storage.calls[2].promise.setException(std::runtime_error("Connection reset"));
+    auto error = get(stream->next());
+    EXPECT_FALSE(error.ok());
+    EXPECT_EQ(3, storage.calls.size());
+
+    storage.calls[1].promise.setValue(Status::Error("Leader not found"));
+    EXPECT_FALSE(get(stream->next()).ok());
+    auto end = get(stream->next());
+    ASSERT_TRUE(end.ok());
+    EXPECT_FALSE(end.value().hasValue());
+}
+
+TEST(StorageStream, ReleaseWaiters) {
+    ScanStorage storage;
+    auto stream = ScanStorage::Stream::start({scanRequest(kHost1, 1)}, storage.fetch());
+    auto first = stream->next();
+    auto second = stream->next();
+    auto third = stream->next();
+    EXPECT_FALSE(first.isReady());
+    EXPECT_FALSE(second.isReady());
+
+    // The last chunk goes to the first one, and the others are told there is no more
+    storage.calls[0].promise.setValue(scanChunk("1a"));
+    EXPECT_EQ("1a", nameOf(get(std::move(first))));
+    for (auto *future : {&second, &third}) {
+        auto end = get(std::move(*future));
+        ASSERT_TRUE(end.ok());
+        EXPECT_FALSE(end.value().hasValue());
+    }
+}
+
+TEST(StorageStream, FailedParts) {
+    {
+        // A scan of a failed part ends with the error
+        ScanStorage storage;
+        auto stream = ScanStorage::Stream::start({scanRequest(kHost1, 1)}, storage.fetch());
+        auto chunk = scanChunk("1a", std::string("c1"));
+        chunk.set_result(result({failedPart(1)}));
+        storage.calls[0].promise.setValue(std::move(chunk));
+        EXPECT_FALSE(get(stream->next()).ok());
+        auto end = get(stream->next());
+        ASSERT_TRUE(end.ok());
+        EXPECT_FALSE(end.value().hasValue());
+        EXPECT_EQ(1, storage.calls.size());
+    }
+    {
+        // The other parts of the host go on
+        NeighborsStorage storage;
+        cpp2::GetNeighborsRequest req;
+        req.set_space_id(1);
+        std::unordered_map<PartitionID, std::vector<Row>> parts;
+        parts[1].emplace_back(Row({"1"}));
+        parts[2].emplace_back(Row({"2"}));
+        req.set_parts(std::move(parts));
+        auto stream = NeighborsStorage::Stream::start({{kHost1, std::move(req)}},
+                                                      storage.fetch());
+        cpp2::GetNeighborsResponse chunk;
+        chunk.set_result(result({failedPart(2)}));
+        chunk.set_next_cursor("c1");
+        storage.calls[0].promise.setValue(std::move(chunk));
+
+        auto error = get(stream->next());
+        ASSERT_FALSE(error.ok());
+        EXPECT_NE(std::string::npos, error.status().toString().find("Part 2"));
+        auto taken = get(stream->next());
+        ASSERT_TRUE(taken.ok());
+        EXPECT_TRUE(taken.value().hasValue());
+
+        ASSERT_EQ(2, storage.calls.size());
+        const auto& resumed = storage.calls[1].req;
+        EXPECT_EQ(1, resumed.get_parts().size());
+        EXPECT_EQ(1, resumed.get_parts().count(1));
+        EXPECT_EQ("c1", *resumed.get_cursor());
+
+        // Of all the parts left
+        cpp2::GetNeighborsResponse last;
+        last.set_result(result({failedPart(1)}));
+        storage.calls[1].promise.setValue(std::move(last));
+        EXPECT_FALSE(get(stream->next()).ok());
+        auto end = get(stream->next());
+        ASSERT_TRUE(end.ok());
+        EXPECT_FALSE(end.value().hasValue());
+        EXPECT_EQ(2, storage.calls.size());
+    }
+}
+
+}   // namespace storage
+}   // namespace nebula
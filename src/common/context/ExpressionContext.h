@@ -14,6 +14,8 @@
 
 namespace nebula {
 
+class Expression;
+
 /***************************************************************************
  *
  * The base class for all ExpressionContext implementations
@@ -75,8 +77,165 @@ public:
 
     virtual void setVar(const std::string& var, Value val) = 0;
 
+    /**
+     * Slot-resolved property access.
+     *
+     * A context working on rows of known schemas could resolve a (symbol, property) pair
+     * to an integer slot once, and then serve the property of every row by the slot,
+     * by reference, without hashing any string or copying the value.
+     *
+     * Resolved slots are valid as long as `slotEpoch()' stays the same. A context supporting
+     * slots takes a new epoch from `nextSlotEpoch()' on construction and whenever
+     * its slots change, so that epochs are never shared by two contexts.
+     * The default epoch 0 means slots are not supported, and the string-keyed getters
+     * are used instead.
+     */
+    static constexpr int32_t kNoSlot = -1;
+
+    static uint64_t nextSlotEpoch() {
+        static std::atomic<uint64_t> epoch{0};
+        return ++epoch;
+    }
+
+    virtual uint64_t slotEpoch() const {
+        return 0;
+    }
+
+    // Resolve the property to a slot, or kNoSlot if it could not be resolved
+    virtual int32_t getEdgePropSlot(const std::string& edgeType,
+                                    const std::string& prop) const {
+        UNUSED(edgeType);
+        UNUSED(prop);
+        return kNoSlot;
+    }
+
+    virtual int32_t getTagPropSlot(const std::string& tag,
+                                   const std::string& prop) const {
+        UNUSED(tag);
+        UNUSED(prop);
+        return kNoSlot;
+    }
+
+    virtual int32_t getSrcPropSlot(const std::string& tag,
+                                   const std::string& prop) const {
+        UNUSED(tag);
+        UNUSED(prop);
+        return kNoSlot;
+    }
+
+    virtual int32_t getDstPropSlot(const std::string& tag,
+                                   const std::string& prop) const {
+        UNUSED(tag);
+        UNUSED(prop);
+        return kNoSlot;
+    }
+
+    virtual int32_t getInputPropSlot(const std::string& prop) const {
+        UNUSED(prop);
+        return kNoSlot;
+    }
+
+    // Get the property of the current row by a slot resolved above
+    virtual const Value& getEdgePropBySlot(int32_t slot) const {
+        LOG(FATAL) << "Slot " << slot << " of edge property is not supported";
+        return Value::kNullBadType;
+    }
+
+    virtual const Value& getTagPropBySlot(int32_t slot) const {
+        LOG(FATAL) << "Slot " << slot << " of tag property is not supported";
+        return Value::kNullBadType;
+    }
+
+    virtual const Value& getSrcPropBySlot(int32_t slot) const {
+        LOG(FATAL) << "Slot " << slot << " of source property is not supported";
+        return Value::kNullBadType;
+    }
+
+    virtual const Value& getDstPropBySlot(int32_t slot) const {
+        LOG(FATAL) << "Slot " << slot << " of destination property is not supported";
+        return Value::kNullBadType;
+    }
+
+    virtual const Value& getInputPropBySlot(int32_t slot) const {
+        LOG(FATAL) << "Slot " << slot << " of input property is not supported";
+        return Value::kNullBadType;
+    }
+
+    /**
+     * Local variables of the iterating expressions, such as `n' of [n IN list WHERE n > 1].
+     *
+     * They live in a stack of frames, one per iteration in scope, and each of them is
+     * bound to a value by reference, so that neither is the name hashed nor the element
+     * copied per row. The referred values must outlive the frame.
+     * Variable expressions resolved to a slot are served here instead of `getVar()'.
+     *
+     * Each frame is tagged by its owner, i.e. the expression declaring the variables, so that
+     * a variable bound to the slot of one owner is never served by the frame of another one.
+     *
+     * A slot could also be bound to an expression instead, which is evaluated by the variable
+     * reading it first, so that nothing is evaluated unless it is read.
+     */
+    class LocalFrame final {
+    public:
+        LocalFrame(ExpressionContext& ctx, size_t num, const void* owner)
+            : ctx_(ctx), base_(ctx.locals_.size()) {
+            ctx_.locals_.resize(base_ + num, Local{&Value::kEmpty, owner, nullptr});
+        }
+
+        ~LocalFrame() {
+            ctx_.locals_.resize(base_);
+        }
+
+        // Slot of the first variable of the frame, the others follow it
+        size_t base() const {
+            return base_;
+        }
+
+    private:
+        ExpressionContext&  ctx_;
+        size_t              base_;
+    };
+
+    size_t numLocals() const {
+        return locals_.size();
+    }
+
+    void bindLocal(size_t slot, const Value& val) {
+        DCHECK_LT(slot, locals_.size());
+        locals_[slot].value = &val;
+        locals_[slot].pending = nullptr;
+    }
+
+    void bindLocalLazily(size_t slot, Expression* expr) {
+        DCHECK_LT(slot, locals_.size());
+        locals_[slot].pending = expr;
+    }
+
+    // The expression `slot' is bound to, which is not evaluated yet
+    Expression* pendingLocal(size_t slot) const {
+        DCHECK_LT(slot, locals_.size());
+        return locals_[slot].pending;
+    }
+
+    const Value& getLocal(size_t slot) const {
+        DCHECK_LT(slot, locals_.size());
+        return *locals_[slot].value;
+    }
+
+    // Whether `slot' is in a frame of `owner'
+    bool isLocalOf(size_t slot, const void* owner) const {
+        return slot < locals_.size() && locals_[slot].owner == owner;
+    }
+
 private:
+    struct Local {
+        const Value*                            value;
+        const void*                             owner;
+        Expression*                             pending;
+    };
+
     std::unordered_map<std::string, std::regex> regex_;
+    std::vector<Local>                          locals_;
 };
 
 }  // namespace nebula
@@ -24,6 +24,7 @@ struct Map;
 struct Set;
 struct List;
 struct DataSet;
+class Props;
 }   // namespace nebula
 
 namespace apache::thrift {
@@ -43,6 +44,7 @@ SPECIALIZE_CPP2OPS(nebula::Map);
 SPECIALIZE_CPP2OPS(nebula::Set);
 SPECIALIZE_CPP2OPS(nebula::List);
 SPECIALIZE_CPP2OPS(nebula::DataSet);
+SPECIALIZE_CPP2OPS(nebula::Props);
 
 }   // namespace apache::thrift
 
@@ -12,6 +12,7 @@
 #include <sstream>
 #include <string>
 
+#include "common/base/WyHash.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/List.h"
 
@@ -22,21 +23,28 @@ using Row = List;
 struct DataSet {
     std::vector<std::string> colNames;
     std::vector<Row> rows;
+    // Whether the rows are written as PackedRows, which is only for the receivers known to
+    // read them, e.g. of a GetNeighborsRequest with `accept_packed_rows'. It is never set
+    // by reading, so a DataSet received is passed on as the plain rows.
+    bool packRows{false};
 
     DataSet() = default;
     explicit DataSet(std::vector<std::string> columns) : colNames(std::move(columns)) {}
     DataSet(const DataSet& ds) noexcept {
         colNames = ds.colNames;
         rows = ds.rows;
+        packRows = ds.packRows;
     }
     DataSet(DataSet&& ds) noexcept {
         colNames = std::move(ds.colNames);
         rows = std::move(ds.rows);
+        packRows = ds.packRows;
     }
     DataSet& operator=(const DataSet& ds) noexcept {
         if (&ds != this) {
             colNames = ds.colNames;
             rows = ds.rows;
+            packRows = ds.packRows;
         }
         return *this;
     }
@@ -44,6 +52,7 @@ struct DataSet {
         if (&ds != this) {
             colNames = std::move(ds.colNames);
             rows = std::move(ds.rows);
+            packRows = ds.packRows;
         }
         return *this;
     }
@@ -141,6 +150,7 @@ struct DataSet {
 
     void __clear() {
         clear();
+        packRows = false;
     }
 
     std::size_t size() const {
@@ -184,4 +194,22 @@ inline std::ostream &operator<<(std::ostream& os, const DataSet& d) {
 }
 
 }  // namespace nebula
+
+namespace std {
+template<>
+struct hash<nebula::DataSet> {
+    // In the order of the rows, as they are compared
+    std::size_t operator()(const nebula::DataSet& d) const noexcept {
+        using nebula::WyHash;
+        uint64_t seed = WyHash::kSecret[0];
+        for (auto& name : d.colNames) {
+            seed = WyHash::mix(seed ^ WyHash()(name), WyHash::kSecret[1]);
+        }
+        for (auto& row : d.rows) {
+            seed = WyHash::mix(seed ^ hash<nebula::List>()(row), WyHash::kSecret[2]);
+        }
+        return WyHash::mix(seed ^ WyHash::kSecret[2], d.rows.size() ^ WyHash::kSecret[3]);
+    }
+};
+}  // namespace std
 #endif  // COMMON_DATATYPES_DATASET_H_
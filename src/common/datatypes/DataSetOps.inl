@@ -15,6 +15,7 @@
 
 #include "common/datatypes/DataSet.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PackedRows.h"
 
 namespace apache {
 namespace thrift {
@@ -38,6 +39,9 @@ struct TccStructTraits<nebula::DataSet> {
         } else if (_fname == "rows") {
             fid = 2;
             _ftype = apache::thrift::protocol::T_LIST;
+        } else if (_fname == "packed_rows") {
+            fid = 3;
+            _ftype = apache::thrift::protocol::T_STRING;
         }
     }
 };
@@ -63,12 +67,20 @@ uint32_t Cpp2Ops<nebula::DataSet>::write(Protocol* proto,
         >::write(*proto, obj->colNames);
     xfer += proto->writeFieldEnd();
 
-    xfer += proto->writeFieldBegin("rows", apache::thrift::protocol::T_LIST, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::list<type_class::structure>,
-            std::vector<nebula::Row>
-        >::write(*proto, obj->rows);
-    xfer += proto->writeFieldEnd();
+    if (obj->packRows && nebula::PackedRows::packable(obj->rows)) {
+        std::string packed;
+        nebula::PackedRows::encode(obj->rows, packed);
+        xfer += proto->writeFieldBegin("packed_rows", apache::thrift::protocol::T_STRING, 3);
+        xfer += proto->writeBinary(packed);
+        xfer += proto->writeFieldEnd();
+    } else {
+        xfer += proto->writeFieldBegin("rows", apache::thrift::protocol::T_LIST, 2);
+        xfer += detail::pm::protocol_methods<
+                type_class::list<type_class::structure>,
+                std::vector<nebula::Row>
+            >::write(*proto, obj->rows);
+        xfer += proto->writeFieldEnd();
+    }
 
     xfer += proto->writeFieldStop();
     xfer += proto->writeStructEnd();
@@ -84,6 +96,8 @@ void Cpp2Ops<nebula::DataSet>::read(Protocol* proto, nebula::DataSet* obj) {
 
     using apache::thrift::protocol::TProtocolException;
 
+    obj->packRows = false;
+
     if (UNLIKELY(!readState.advanceToNextField(proto, 0, 1, protocol::T_LIST))) {
         goto _loop;
     }
@@ -148,6 +162,14 @@ _loop:
                 goto _skip;
             }
         }
+        case 3:
+        {
+            if (LIKELY(readState.fieldType == apache::thrift::protocol::T_STRING)) {
+                goto _readField_packed_rows;
+            } else {
+                goto _skip;
+            }
+        }
         default:
         {
 _skip:
@@ -157,6 +179,20 @@ _skip:
             goto _loop;
         }
     }
+
+_readField_packed_rows:
+    {
+        // Written only in place of the rows, for the receivers which ask for it
+        folly::IOBuf packed;
+        proto->readBinary(packed);
+        auto status = nebula::PackedRows::decode(packed.coalesce(), obj->rows);
+        if (!status.ok()) {
+            throw TProtocolException(TProtocolException::INVALID_DATA, status.toString());
+        }
+    }
+    readState.readFieldEnd(proto);
+    readState.readFieldBeginNoInline(proto);
+    goto _loop;
 }
 
 
@@ -172,11 +208,17 @@ uint32_t Cpp2Ops<nebula::DataSet>::serializedSize(Protocol const* proto,
             std::vector<std::string>
         >::serializedSize<false>(*proto, obj->colNames);
 
-    xfer += proto->serializedFieldSize("rows", apache::thrift::protocol::T_LIST, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::list<type_class::structure>,
-            std::vector<nebula::Row>
-        >::serializedSize<false>(*proto, obj->rows);
+    if (obj->packRows && nebula::PackedRows::packable(obj->rows)) {
+        xfer += proto->serializedFieldSize("packed_rows", protocol::T_STRING, 3);
+        // With the length of the binary, which is within 5 bytes
+        xfer += 5 + nebula::PackedRows::encodedSize(proto, obj->rows);
+    } else {
+        xfer += proto->serializedFieldSize("rows", protocol::T_LIST, 2);
+        xfer += detail::pm::protocol_methods<
+                type_class::list<type_class::structure>,
+                std::vector<nebula::Row>
+            >::serializedSize<false>(*proto, obj->rows);
+    }
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -195,11 +237,17 @@ uint32_t Cpp2Ops<nebula::DataSet>::serializedSizeZC(Protocol const* proto,
             std::vector<std::string>
         >::serializedSize<false>(*proto, obj->colNames);
 
-    xfer += proto->serializedFieldSize("rows", protocol::T_LIST, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::list<type_class::structure>,
-            std::vector<nebula::Row>
-        >::serializedSize<false>(*proto, obj->rows);
+    if (obj->packRows && nebula::PackedRows::packable(obj->rows)) {
+        xfer += proto->serializedFieldSize("packed_rows", protocol::T_STRING, 3);
+        // With the length of the binary, which is within 5 bytes
+        xfer += 5 + nebula::PackedRows::encodedSize(proto, obj->rows);
+    } else {
+        xfer += proto->serializedFieldSize("rows", protocol::T_LIST, 2);
+        xfer += detail::pm::protocol_methods<
+                type_class::list<type_class::structure>,
+                std::vector<nebula::Row>
+            >::serializedSize<false>(*proto, obj->rows);
+    }
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -5,8 +5,8 @@
  */
 
 #include <cstdint>
+#include <cstring>
 
-#include <folly/String.h>
 #include <folly/hash/Hash.h>
 
 #include "common/datatypes/Date.h"
@@ -95,27 +95,105 @@ Date Date::operator-(int64_t days) const {
     return Date(daysSince - days);
 }
 
+namespace {
+
+// The two digits of each of 0 - 99
+constexpr char kTwoDigits[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Writes `value' as printf() does with "%0<width>ld", returning the end
+char* writeInt(char *buf, int64_t value, int width) {
+    uint64_t abs = value;
+    if (value < 0) {
+        *buf++ = '-';
+        abs = -abs;
+        width--;
+    }
+    // Backward from the end of the digits
+    char digits[24];
+    auto *p = digits + sizeof(digits);
+    while (abs >= 100) {
+        p -= 2;
+        std::memcpy(p, &kTwoDigits[2 * (abs % 100)], 2);
+        abs /= 100;
+    }
+    if (abs >= 10) {
+        p -= 2;
+        std::memcpy(p, &kTwoDigits[2 * abs], 2);
+    } else {
+        *--p = '0' + abs;
+    }
+    auto size = static_cast<int>(digits + sizeof(digits) - p);
+    for (; width > size; width--) {
+        *buf++ = '0';
+    }
+    std::memcpy(buf, p, size);
+    return buf + size;
+}
+
+}  // namespace
+
+size_t Date::format(char *buf) const {
+    // As "%d-%02d-%02d"
+    auto *p = writeInt(buf, year, 0);
+    *p++ = '-';
+    p = writeInt(p, month, 2);
+    *p++ = '-';
+    p = writeInt(p, day, 2);
+    return p - buf;
+}
+
 std::string Date::toString() const {
     // It's in current timezone already
-    return folly::stringPrintf("%d-%02d-%02d", year, month, day);
+    char buf[kTimeFormatBufferSize];
+    return std::string(buf, format(buf));
+}
+
+size_t Time::format(char *buf) const {
+    // As "%02d:%02d:%02d.%06d"
+    auto *p = writeInt(buf, hour, 2);
+    *p++ = ':';
+    p = writeInt(p, minute, 2);
+    *p++ = ':';
+    p = writeInt(p, sec, 2);
+    *p++ = '.';
+    p = writeInt(p, microsec, 6);
+    return p - buf;
 }
 
 std::string Time::toString() const {
     // It's in current timezone already
-    return folly::stringPrintf("%02d:%02d:%02d.%06d", hour, minute, sec, microsec);
+    char buf[kTimeFormatBufferSize];
+    return std::string(buf, format(buf));
+}
+
+size_t DateTime::format(char *buf) const {
+    // As "%hd-%02hhu-%02hhuT%02hhu:%02hhu:%02hhu.%u", where the microseconds are
+    // not padded
+    auto *p = writeInt(buf, static_cast<int16_t>(year), 0);
+    *p++ = '-';
+    p = writeInt(p, static_cast<uint8_t>(month), 2);
+    *p++ = '-';
+    p = writeInt(p, static_cast<uint8_t>(day), 2);
+    *p++ = 'T';
+    p = writeInt(p, static_cast<uint8_t>(hour), 2);
+    *p++ = ':';
+    p = writeInt(p, static_cast<uint8_t>(minute), 2);
+    *p++ = ':';
+    p = writeInt(p, static_cast<uint8_t>(sec), 2);
+    *p++ = '.';
+    p = writeInt(p, static_cast<uint32_t>(microsec), 0);
+    return p - buf;
 }
 
 std::string DateTime::toString() const {
     // It's in current timezone already
-    return folly::stringPrintf("%hd-%02hhu-%02hhu"
-                               "T%02hhu:%02hhu:%02hhu.%u",
-                               static_cast<int16_t>(year),
-                               static_cast<uint8_t>(month),
-                               static_cast<uint8_t>(day),
-                               static_cast<uint8_t>(hour),
-                               static_cast<uint8_t>(minute),
-                               static_cast<uint8_t>(sec),
-                               static_cast<uint32_t>(microsec));
+    char buf[kTimeFormatBufferSize];
+    return std::string(buf, format(buf));
 }
 
 }   // namespace nebula
@@ -138,7 +216,15 @@ std::size_t hash<nebula::Time>::operator()(const nebula::Time& h) const noexcept
 }
 
 std::size_t hash<nebula::DateTime>::operator()(const nebula::DateTime& h) const noexcept {
-    return h.qword;
+    // The qword of the former layout, from the year at the least significant bits, so that
+    // the hashes stay the same as before the fields were reordered
+    return static_cast<uint64_t>(static_cast<uint16_t>(h.year)) |
+           static_cast<uint64_t>(h.month) << 16 |
+           static_cast<uint64_t>(h.day) << 20 |
+           static_cast<uint64_t>(h.hour) << 25 |
+           static_cast<uint64_t>(h.minute) << 30 |
+           static_cast<uint64_t>(h.sec) << 36 |
+           static_cast<uint64_t>(h.microsec) << 42;
 }
 
 }   // namespace std
@@ -17,6 +17,9 @@ namespace nebula {
 extern const int64_t kDaysSoFar[];
 extern const int64_t kLeapDaysSoFar[];
 
+// The size of the buffer enough for format() of Date, Time and DateTime
+constexpr size_t kTimeFormatBufferSize = 64;
+
 struct Date {
     int16_t year;   // Any integer
     int8_t month;   // 1 - 12
@@ -43,34 +46,61 @@ struct Date {
         day = d;
     }
 
+    // The fields packed in the order of significance, which orders as the dates do
+    uint32_t key() const {
+        return (static_cast<uint32_t>(static_cast<uint16_t>(year) ^ 0x8000) << 16) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(month)) << 8) |
+               static_cast<uint8_t>(day);
+    }
+
     bool operator==(const Date& rhs) const {
-        return year == rhs.year &&
-               month == rhs.month &&
-               day == rhs.day;
+        return key() == rhs.key();
     }
 
     bool operator<(const Date& rhs) const {
-        if (!(year == rhs.year)) {
-            return year < rhs.year;
-        }
-        if (!(month == rhs.month)) {
-            return month < rhs.month;
-        }
-        if (!(day == rhs.day)) {
-            return day < rhs.day;
-        }
-        return false;
+        return key() < rhs.key();
     }
 
     Date operator+(int64_t days) const;
     Date operator-(int64_t days) const;
 
     std::string toString() const;
+    // Writes toString() to `buf' of kTimeFormatBufferSize bytes, returning its size
+    size_t format(char *buf) const;
 
     // Return the number of days since -32768/1/1
     int64_t toInt() const;
     // Convert the number of days since -32768/1/1 to the real date
     void fromInt(int64_t days);
+
+    // The number of days since 1970/1/1 of the proleptic Gregorian calendar, in constant time
+    int64_t toEpochDays() const {
+        return epochDaysOf(year, month, day);
+    }
+
+    static int64_t epochDaysOf(int64_t y, int64_t m, int64_t d) {
+        // Of the years beginning on March 1st, so that the leap day is the last one
+        y -= m <= 2;
+        auto era = (y >= 0 ? y : y - 399) / 400;
+        auto yearOfEra = y - era * 400;
+        auto dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        // 719468 days from 0000/3/1 to 1970/1/1
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    static Date fromEpochDays(int64_t days) {
+        days += 719468;
+        auto era = (days >= 0 ? days : days - 146096) / 146097;
+        auto dayOfEra = days - era * 146097;
+        auto yearOfEra =
+            (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        auto m = (5 * dayOfYear + 2) / 153;
+        auto d = dayOfYear - (153 * m + 2) / 5 + 1;
+        m = m < 10 ? m + 3 : m - 9;
+        return Date(yearOfEra + era * 400 + (m <= 2), m, d);
+    }
 };
 
 inline std::ostream &operator<<(std::ostream& os, const Date& d) {
@@ -99,30 +129,25 @@ struct Time {
         clear();
     }
 
+    // The fields packed in the order of significance, which orders as the times do
+    uint64_t key() const {
+        return (static_cast<uint64_t>(static_cast<uint8_t>(hour)) << 48) |
+               (static_cast<uint64_t>(static_cast<uint8_t>(minute)) << 40) |
+               (static_cast<uint64_t>(static_cast<uint8_t>(sec)) << 32) |
+               static_cast<uint32_t>(microsec);
+    }
+
     bool operator==(const Time& rhs) const {
-        return hour == rhs.hour &&
-               minute == rhs.minute &&
-               sec == rhs.sec &&
-               microsec == rhs.microsec;
+        return key() == rhs.key();
     }
 
     bool operator<(const Time& rhs) const {
-        if (!(hour == rhs.hour)) {
-            return hour < rhs.hour;
-        }
-        if (!(minute == rhs.minute)) {
-            return minute < rhs.minute;
-        }
-        if (!(sec == rhs.sec)) {
-            return sec < rhs.sec;
-        }
-        if (!(microsec == rhs.microsec)) {
-            return microsec < rhs.microsec;
-        }
-        return false;
+        return key() < rhs.key();
     }
 
     std::string toString() const;
+    // Writes toString() to `buf' of kTimeFormatBufferSize bytes, returning its size
+    size_t format(char *buf) const;
 };
 
 inline std::ostream &operator<<(std::ostream& os, const Time& d) {
@@ -135,15 +160,17 @@ struct DateTime {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 #endif  // defined(__GNUC__)
+    // The fields are laid out from the least significant one, so that the qword of a little
+    // endian machine orders as the date times do once the sign of the year is flipped
     union {
         struct {
-            int64_t year:16;
-            uint64_t month:4;
-            uint64_t day:5;
-            uint64_t hour:5;
-            uint64_t minute:6;
-            uint64_t sec:6;
             uint64_t microsec:22;
+            uint64_t sec:6;
+            uint64_t minute:6;
+            uint64_t hour:5;
+            uint64_t day:5;
+            uint64_t month:4;
+            int64_t year:16;
         };
         uint64_t qword;
     };
@@ -151,7 +178,7 @@ struct DateTime {
 #pragma GCC diagnostic pop
 #endif  // defined(__GNUC__)
 
-    DateTime() : year{0}, month{1}, day{1}, hour{0}, minute{0}, sec{0}, microsec{0} {}
+    DateTime() : microsec{0}, sec{0}, minute{0}, hour{0}, day{1}, month{1}, year{0} {}
     DateTime(int16_t y, int8_t m, int8_t d, int8_t h, int8_t min, int8_t s, int32_t us) {
         year = y;
         month = m;
@@ -185,41 +212,51 @@ struct DateTime {
         clear();
     }
 
+    // The fields packed in the order of significance, which orders as the date times do
+    uint64_t key() const {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return qword ^ (static_cast<uint64_t>(1) << 63);
+#else
+        return (static_cast<uint64_t>(static_cast<uint16_t>(year) ^ 0x8000) << 48) |
+               (static_cast<uint64_t>(month) << 44) | (static_cast<uint64_t>(day) << 39) |
+               (static_cast<uint64_t>(hour) << 34) | (static_cast<uint64_t>(minute) << 28) |
+               (static_cast<uint64_t>(sec) << 22) | microsec;
+#endif
+    }
+
     bool operator==(const DateTime& rhs) const {
-        return year == rhs.year &&
-               month == rhs.month &&
-               day == rhs.day &&
-               hour == rhs.hour &&
-               minute == rhs.minute &&
-               sec == rhs.sec &&
-               microsec == rhs.microsec;
+        return qword == rhs.qword;
     }
+
     bool operator<(const DateTime& rhs) const {
-        if (!(year == rhs.year)) {
-            return year < rhs.year;
-        }
-        if (!(month == rhs.month)) {
-            return month < rhs.month;
-        }
-        if (!(day == rhs.day)) {
-            return day < rhs.day;
-        }
-        if (!(hour == rhs.hour)) {
-            return hour < rhs.hour;
-        }
-        if (!(minute == rhs.minute)) {
-            return minute < rhs.minute;
-        }
-        if (!(sec == rhs.sec)) {
-            return sec < rhs.sec;
-        }
-        if (!(microsec == rhs.microsec)) {
-            return microsec < rhs.microsec;
+        return key() < rhs.key();
+    }
+
+    // The number of microseconds since the epoch, in constant time
+    int64_t toEpochMicros() const {
+        int64_t hours = Date::epochDaysOf(year, month, day) * 24 + static_cast<int64_t>(hour);
+        int64_t seconds = (hours * 60 + static_cast<int64_t>(minute)) * 60 +
+                          static_cast<int64_t>(sec);
+        return seconds * 1000000 + static_cast<int64_t>(microsec);
+    }
+
+    static DateTime fromEpochMicros(int64_t micros) {
+        constexpr int64_t kMicrosOfDay = 24LL * 60 * 60 * 1000000;
+        auto days = micros / kMicrosOfDay;
+        auto rem = micros % kMicrosOfDay;
+        if (rem < 0) {
+            days--;
+            rem += kMicrosOfDay;
         }
-        return false;
+        auto date = Date::fromEpochDays(days);
+        auto seconds = rem / 1000000;
+        return DateTime(date.year, date.month, date.day,
+                        seconds / 3600, seconds / 60 % 60, seconds % 60, rem % 1000000);
     }
 
     std::string toString() const;
+    // Writes toString() to `buf' of kTimeFormatBufferSize bytes, returning its size
+    size_t format(char *buf) const;
 };
 
 
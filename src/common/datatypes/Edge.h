@@ -10,6 +10,7 @@
 #include <unordered_map>
 
 #include "common/thrift/ThriftTypes.h"
+#include "common/datatypes/Props.h"
 #include "common/datatypes/Value.h"
 
 namespace nebula {
@@ -20,7 +21,7 @@ struct Edge {
     EdgeType type;
     std::string name;
     EdgeRanking ranking;
-    std::unordered_map<std::string, Value> props;
+    Props props;
 
     Edge() {}
     Edge(Edge&& v) noexcept
@@ -42,7 +43,7 @@ struct Edge {
          EdgeType t,
          std::string n,
          EdgeRanking r,
-         std::unordered_map<std::string, Value>&& p)
+         Props p)
         : src(std::move(s))
         , dst(std::move(d))
         , type(std::move(t))
@@ -15,6 +15,7 @@
 
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropsOps.inl"
 
 namespace apache {
 namespace thrift {
@@ -90,10 +91,7 @@ uint32_t Cpp2Ops<nebula::Edge>::write(Protocol* proto, nebula::Edge const* obj)
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("props", apache::thrift::protocol::T_MAP, 6);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::write(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::write(proto, &obj->props);
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -162,11 +160,7 @@ _readField_ranking:
 
 _readField_props:
     {
-        obj->props = std::unordered_map<std::string, nebula::Value>();
-        detail::pm::protocol_methods<
-                type_class::map<type_class::binary, type_class::structure>,
-                std::unordered_map<std::string, nebula::Value>
-            >::read(*proto, obj->props);
+        Cpp2Ops<nebula::Props>::read(proto, &obj->props);
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 6, 0, protocol::T_STOP))) {
@@ -274,10 +268,7 @@ uint32_t Cpp2Ops<nebula::Edge>::serializedSize(Protocol const* proto,
         ::serializedSize<false>(*proto, obj->ranking);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 6);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -308,10 +299,7 @@ uint32_t Cpp2Ops<nebula::Edge>::serializedSizeZC(Protocol const* proto,
         ::serializedSize<false>(*proto, obj->ranking);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 6);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
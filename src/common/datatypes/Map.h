@@ -9,6 +9,7 @@
 
 #include <unordered_map>
 
+#include "common/base/WyHash.h"
 #include "common/datatypes/Value.h"
 
 namespace nebula {
@@ -74,4 +75,20 @@ inline std::ostream &operator<<(std::ostream& os, const Map& m) {
 }
 
 }  // namespace nebula
+
+namespace std {
+template<>
+struct hash<nebula::Map> {
+    // The entries are summed up, whichever order they are iterated in
+    std::size_t operator()(const nebula::Map& m) const noexcept {
+        using nebula::WyHash;
+        uint64_t seed = 0;
+        for (auto& kv : m.kvs) {
+            seed += WyHash::mix(WyHash()(kv.first) ^ WyHash::kSecret[0],
+                                hash<nebula::Value>()(kv.second) ^ WyHash::kSecret[1]);
+        }
+        return WyHash::mix(seed ^ WyHash::kSecret[2], m.kvs.size() ^ WyHash::kSecret[3]);
+    }
+};
+}  // namespace std
 #endif  // COMMON_DATATYPES_MAP_H_
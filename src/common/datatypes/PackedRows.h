@@ -0,0 +1,576 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_DATATYPES_PACKEDROWS_H_
+#define COMMON_DATATYPES_PACKEDROWS_H_
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/Bits.h>
+#include <folly/Range.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/base/Status.h"
+#include "common/base/WyHash.h"
+#include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+
+/**
+ * The rows of a DataSet packed column by column into the blocks of the values of the same
+ * type, so that a run of nulls, bools, ints, floats, strings or lists is written as bare
+ * varints and bytes, without the struct of thrift around each value. It is field 3 of the
+ * DataSet on the wire, which is only written when DataSet::packRows is set.
+ *
+ * The layout, in which the numbers are varints unless noted
+ *   version (a byte), the number of rows, the number of columns,
+ *   since version 2, the size of the dictionary, then the length and the bytes of each string,
+ *   then the values of each column as blocks of
+ *     type (a byte), the number of the values, then each value as
+ *       kNull:       the NullType
+ *       kBool:       a byte
+ *       kInt:        the zigzag of it
+ *       kFloat:      8 bytes of little endian
+ *       kString:     the length and the bytes
+ *       kList:       the size, then its values as blocks in turn
+ *       kValue:      the length and the compact thrift of the Value, for the other types
+ *       kDictString: the index of it in the dictionary
+ *
+ * The dictionary holds the strings found more than once, e.g. the vids of the neighbors shared
+ * by the rows, so that each of them is sent once, and the repeats are sent as small integers.
+ *
+ * Every value and every string of the dictionary takes a byte at least, which bounds the sizes
+ * trusted in decoding.
+ */
+class PackedRows final {
+public:
+    explicit PackedRows(...) = delete;
+
+    static constexpr uint8_t kVersion = 2;
+    // The lists nested deeper are written as kValue
+    static constexpr size_t kMaxDepth = 32;
+
+    enum Type : uint8_t {
+        kNull       = 1,
+        kBool       = 2,
+        kInt        = 3,
+        kFloat      = 4,
+        kString     = 5,
+        kList       = 6,
+        kValue      = 7,
+        kDictString = 8,
+    };
+
+    // Only the rows of the same and nonzero width are packed
+    static bool packable(const std::vector<Row> &rows) {
+        if (rows.empty()) {
+            return true;
+        }
+        auto width = rows.front().values.size();
+        if (width == 0) {
+            return false;
+        }
+        for (const auto &row : rows) {
+            if (row.values.size() != width) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // `rows' are to be packable
+    static void encode(const std::vector<Row> &rows, std::string &buf) {
+        StringSink sink(buf);
+        encodeTo(sink, rows);
+    }
+
+    /**
+     * An upper bound of the size encoded, as the serializedSize() of thrift is, which is
+     * summed value by value without building the dictionary. Each value is taken as a block
+     * of its own, and each string as both the index of it and the bytes of it, which covers
+     * its entry of the dictionary, if any, by one of its repeats.
+     */
+    template <class Protocol>
+    static uint32_t encodedSize(Protocol const* proto, const std::vector<Row> &rows) {
+        // The version, the numbers of rows and columns, and the size of the dictionary
+        size_t size = 1 + 3 * kMaxVarintSize;
+        for (const auto &row : rows) {
+            for (const auto &v : row.values) {
+                size += sizeBound(proto, v, 0);
+            }
+        }
+        return size;
+    }
+
+    static Status decode(folly::ByteRange data, std::vector<Row> &rows) {
+        Source source{data.begin(), data.end()};
+        uint8_t version;
+        uint64_t numRows, numCols;
+        if (!source.byte(version) || !source.varint(numRows) || !source.varint(numCols)) {
+            return Status::Error("Truncated packed rows");
+        }
+        if (version == 0 || version > kVersion) {
+            return Status::Error("Unknown version %u of packed rows", version);
+        }
+        // Version 1 has no dictionary
+        std::vector<folly::StringPiece> dict;
+        if (version >= 2) {
+            uint64_t dictSize;
+            if (!source.varint(dictSize) || dictSize > source.remaining()) {
+                return Status::Error("Bad dictionary of packed rows");
+            }
+            dict.reserve(dictSize);
+            for (size_t i = 0; i < dictSize; i++) {
+                uint64_t size;
+                const uint8_t *data;
+                if (!source.varint(size) || !source.bytes(size, data)) {
+                    return Status::Error("Bad dictionary of packed rows");
+                }
+                dict.emplace_back(reinterpret_cast<const char*>(data), size);
+            }
+        }
+        if (numCols == 0 ? numRows != 0 : numRows > source.remaining() / numCols) {
+            return Status::Error("Bad size of packed rows: %lu x %lu", numRows, numCols);
+        }
+        rows.clear();
+        rows.resize(numRows);
+        for (auto &row : rows) {
+            row.values.resize(numCols);
+        }
+        for (size_t c = 0; c < numCols; c++) {
+            auto cell = [&rows, c] (size_t i) -> Value& {
+                return rows[i].values[c];
+            };
+            if (!decodeRun(source, dict, numRows, cell, 0)) {
+                rows.clear();
+                return Status::Error("Bad packed rows at column %lu", c);
+            }
+        }
+        if (source.remaining() != 0) {
+            rows.clear();
+            return Status::Error("%lu bytes left after packed rows", source.remaining());
+        }
+        return Status::OK();
+    }
+
+private:
+    class StringSink {
+    public:
+        explicit StringSink(std::string &buf) : buf_(buf) {}
+
+        void byte(uint8_t b) {
+            buf_.push_back(static_cast<char>(b));
+        }
+
+        void varint(uint64_t v) {
+            char bytes[10];
+            size_t n = 0;
+            while (v >= 0x80) {
+                bytes[n++] = static_cast<char>(v | 0x80);
+                v >>= 7;
+            }
+            bytes[n++] = static_cast<char>(v);
+            buf_.append(bytes, n);
+        }
+
+        void bytes(const void *data, size_t size) {
+            buf_.append(static_cast<const char*>(data), size);
+        }
+
+        void value(const Value &v) {
+            scratch_.clear();
+            apache::thrift::CompactSerializer::serialize(v, &scratch_);
+            varint(scratch_.size());
+            buf_.append(scratch_);
+        }
+
+    private:
+        std::string        &buf_;
+        std::string         scratch_;
+    };
+
+    static constexpr size_t kMaxVarintSize = 10;
+    // Of the lengths and the indexes of the dictionary, which are within 32 bits
+    static constexpr size_t kMaxVarint32Size = 5;
+
+    static size_t varintSize(uint64_t v) {
+        return (folly::findLastSet(v | 1) + 6) / 7;
+    }
+
+    template <class Protocol>
+    static size_t sizeBound(Protocol const* proto, const Value &v, size_t depth) {
+        // The type and the count of the block of its own
+        size_t size = 2;
+        switch (v.type()) {
+            case Value::Type::NULLVALUE:
+                return size + kMaxVarint32Size;
+            case Value::Type::BOOL:
+                return size + 1;
+            case Value::Type::INT:
+                return size + kMaxVarintSize;
+            case Value::Type::FLOAT:
+                return size + sizeof(uint64_t);
+            case Value::Type::STRING: {
+                const auto &str = v.getStr();
+                return size + kMaxVarint32Size + varintSize(str.size()) + str.size();
+            }
+            case Value::Type::LIST:
+                if (depth + 1 < kMaxDepth) {
+                    size += kMaxVarintSize;
+                    for (const auto &item : v.getList().values) {
+                        size += sizeBound(proto, item, depth + 1);
+                    }
+                    return size;
+                }
+                break;
+            default:
+                break;
+        }
+        return size + kMaxVarint32Size + apache::thrift::Cpp2Ops<Value>::serializedSize(proto, &v);
+    }
+
+    struct Source {
+        const uint8_t      *pos;
+        const uint8_t      *end;
+
+        size_t remaining() const {
+            return end - pos;
+        }
+
+        bool byte(uint8_t &b) {
+            if (pos == end) {
+                return false;
+            }
+            b = *pos++;
+            return true;
+        }
+
+        bool varint(uint64_t &v) {
+            v = 0;
+            for (size_t shift = 0; shift < 64; shift += 7) {
+                if (pos == end) {
+                    return false;
+                }
+                uint8_t b = *pos++;
+                v |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if (b < 0x80) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool bytes(size_t n, const uint8_t *&data) {
+            if (n > remaining()) {
+                return false;
+            }
+            data = pos;
+            pos += n;
+            return true;
+        }
+    };
+
+    struct StringHash {
+        size_t operator()(folly::StringPiece str) const noexcept {
+            return WyHash()(str.data(), str.size());
+        }
+    };
+
+    using Counts = std::unordered_map<folly::StringPiece, uint32_t, StringHash>;
+
+    /**
+     * The dictionary of the strings repeated, coded by the order they are interned in.
+     * It refers to the strings of the rows encoded, which outlive it.
+     */
+    class Dict {
+    public:
+        static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+        void intern(folly::StringPiece str) {
+            if (codes_.emplace(str, strings_.size()).second) {
+                strings_.emplace_back(str);
+            }
+        }
+
+        // kNone if not interned
+        uint32_t find(folly::StringPiece str) const {
+            auto iter = codes_.find(str);
+            return iter == codes_.end() ? kNone : iter->second;
+        }
+
+        folly::StringPiece at(uint32_t code) const {
+            return strings_[code];
+        }
+
+        size_t size() const {
+            return strings_.size();
+        }
+
+    private:
+        std::vector<folly::StringPiece>                                 strings_;
+        std::unordered_map<folly::StringPiece, uint32_t, StringHash>    codes_;
+    };
+
+    template <class Sink>
+    static void encodeTo(Sink &sink, const std::vector<Row> &rows) {
+        auto numCols = rows.empty() ? 0 : rows.front().values.size();
+        Dict dict;
+        {
+            Counts counts;
+            for (const auto &row : rows) {
+                for (const auto &v : row.values) {
+                    collect(v, 0, counts, dict);
+                }
+            }
+        }
+        sink.byte(kVersion);
+        sink.varint(rows.size());
+        sink.varint(numCols);
+        sink.varint(dict.size());
+        for (size_t i = 0; i < dict.size(); i++) {
+            auto str = dict.at(i);
+            sink.varint(str.size());
+            sink.bytes(str.data(), str.size());
+        }
+        for (size_t c = 0; c < numCols; c++) {
+            auto cell = [&rows, c] (size_t i) -> const Value& {
+                return rows[i].values[c];
+            };
+            encodeRun(sink, dict, rows.size(), cell, 0);
+        }
+    }
+
+    // Interns the strings met the second time, where typeOf() would see them
+    static void collect(const Value &v, size_t depth, Counts &counts, Dict &dict) {
+        if (v.isStr()) {
+            const auto &str = v.getStr();
+            if (++counts[str] == 2) {
+                dict.intern(str);
+            }
+        } else if (v.isList() && depth + 1 < kMaxDepth) {
+            for (const auto &item : v.getList().values) {
+                collect(item, depth + 1, counts, dict);
+            }
+        }
+    }
+
+    static Type typeOf(const Value &v, const Dict &dict, size_t depth) {
+        switch (v.type()) {
+            case Value::Type::NULLVALUE:
+                return kNull;
+            case Value::Type::BOOL:
+                return kBool;
+            case Value::Type::INT:
+                return kInt;
+            case Value::Type::FLOAT:
+                return kFloat;
+            case Value::Type::STRING:
+                return dict.find(v.getStr()) == Dict::kNone ? kString : kDictString;
+            case Value::Type::LIST:
+                return depth + 1 < kMaxDepth ? kList : kValue;
+            default:
+                return kValue;
+        }
+    }
+
+    // The `n' values of `get(i)' as blocks
+    template <class Sink, class Get>
+    static void encodeRun(Sink &sink,
+                          const Dict &dict,
+                          size_t n,
+                          const Get &get,
+                          size_t depth) {
+        size_t i = 0;
+        while (i < n) {
+            auto type = typeOf(get(i), dict, depth);
+            auto end = i + 1;
+            while (end < n && typeOf(get(end), dict, depth) == type) {
+                end++;
+            }
+            sink.byte(type);
+            sink.varint(end - i);
+            for (; i < end; i++) {
+                encodeValue(sink, dict, type, get(i), depth);
+            }
+        }
+    }
+
+    template <class Sink>
+    static void encodeValue(Sink &sink,
+                            const Dict &dict,
+                            Type type,
+                            const Value &v,
+                            size_t depth) {
+        switch (type) {
+            case kNull:
+                sink.varint(static_cast<uint32_t>(v.getNull()));
+                break;
+            case kBool:
+                sink.byte(v.getBool());
+                break;
+            case kInt: {
+                auto i = v.getInt();
+                sink.varint((static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63));
+                break;
+            }
+            case kFloat: {
+                uint64_t bits;
+                auto f = v.getFloat();
+                std::memcpy(&bits, &f, sizeof(bits));
+                bits = folly::Endian::little(bits);
+                sink.bytes(&bits, sizeof(bits));
+                break;
+            }
+            case kString: {
+                const auto &str = v.getStr();
+                sink.varint(str.size());
+                sink.bytes(str.data(), str.size());
+                break;
+            }
+            case kList: {
+                const auto &values = v.getList().values;
+                sink.varint(values.size());
+                auto item = [&values] (size_t i) -> const Value& {
+                    return values[i];
+                };
+                encodeRun(sink, dict, values.size(), item, depth + 1);
+                break;
+            }
+            case kValue:
+                sink.value(v);
+                break;
+            case kDictString:
+                sink.varint(dict.find(v.getStr()));
+                break;
+        }
+    }
+
+    // Into the `n' values of `get(i)'
+    template <class Get>
+    static bool decodeRun(Source &source,
+                          const std::vector<folly::StringPiece> &dict,
+                          size_t n,
+                          const Get &get,
+                          size_t depth) {
+        size_t i = 0;
+        while (i < n) {
+            uint8_t type;
+            uint64_t count;
+            if (!source.byte(type) || !source.varint(count) || count == 0 || count > n - i) {
+                return false;
+            }
+            for (auto end = i + count; i < end; i++) {
+                if (!decodeValue(source, dict, type, get(i), depth)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool decodeValue(Source &source,
+                            const std::vector<folly::StringPiece> &dict,
+                            uint8_t type,
+                            Value &v,
+                            size_t depth) {
+        switch (type) {
+            case kNull: {
+                uint64_t null;
+                if (!source.varint(null) || null > std::numeric_limits<int32_t>::max()) {
+                    return false;
+                }
+                v = Value(static_cast<NullType>(null));
+                return true;
+            }
+            case kBool: {
+                uint8_t b;
+                if (!source.byte(b)) {
+                    return false;
+                }
+                v = Value(b != 0);
+                return true;
+            }
+            case kInt: {
+                uint64_t zigzag;
+                if (!source.varint(zigzag)) {
+                    return false;
+                }
+                v = Value(static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+                return true;
+            }
+            case kFloat: {
+                const uint8_t *data;
+                if (!source.bytes(sizeof(uint64_t), data)) {
+                    return false;
+                }
+                uint64_t bits;
+                std::memcpy(&bits, data, sizeof(bits));
+                bits = folly::Endian::little(bits);
+                double f;
+                std::memcpy(&f, &bits, sizeof(f));
+                v = Value(f);
+                return true;
+            }
+            case kString: {
+                uint64_t size;
+                const uint8_t *data;
+                if (!source.varint(size) || !source.bytes(size, data)) {
+                    return false;
+                }
+                v = Value(std::string(reinterpret_cast<const char*>(data), size));
+                return true;
+            }
+            case kList: {
+                uint64_t size;
+                if (depth + 1 >= kMaxDepth || !source.varint(size) || size > source.remaining()) {
+                    return false;
+                }
+                std::vector<Value> values(size);
+                auto item = [&values] (size_t i) -> Value& {
+                    return values[i];
+                };
+                if (!decodeRun(source, dict, size, item, depth + 1)) {
+                    return false;
+                }
+                v = Value(List(std::move(values)));
+                return true;
+            }
+            case kValue: {
+                uint64_t size;
+                const uint8_t *data;
+                if (!source.varint(size) || !source.bytes(size, data)) {
+                    return false;
+                }
+                try {
+                    auto read = apache::thrift::CompactSerializer::deserialize(
+                        folly::ByteRange(data, size), v);
+                    return read == size;
+                } catch (const std::exception&) {
+                    return false;
+                }
+            }
+            case kDictString: {
+                uint64_t code;
+                if (!source.varint(code) || code >= dict.size()) {
+                    return false;
+                }
+                v = Value(dict[code].str());
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_DATATYPES_PACKEDROWS_H_
@@ -5,36 +5,166 @@
  */
 
 #include "common/datatypes/Path.h"
+#include "common/datatypes/PathUniqueness.h"
 
 #include <algorithm>
-#include <tuple>
-#include <unordered_set>
+#include <utility>
 
 #include <folly/String.h>
 #include <folly/hash/Hash.h>
 
 namespace nebula {
+
+StepList::Segment::~Segment() {
+    // Released one by one instead of recursively, which may overflow the stack
+    // for a long chain
+    auto seg = std::move(prev);
+    while (seg != nullptr && seg.use_count() == 1) {
+        seg = std::move(std::const_pointer_cast<Segment>(seg)->prev);
+    }
+}
+
+StepList::StepList(std::vector<Step> steps) {
+    if (!steps.empty()) {
+        tail_ = std::make_shared<Segment>(nullptr, 0);
+        tail_->steps = std::move(steps);
+    }
+}
+
+StepList::const_iterator StepList::begin() const {
+    const_iterator it;
+    if (tail_ == nullptr) {
+        return it;
+    }
+    if (tail_->base == 0) {
+        it.cur_ = tail_->steps.data();
+        it.partEnd_ = it.cur_ + tail_->steps.size();
+        return it;
+    }
+    std::vector<const_iterator::Part> parts;
+    forEachPart([&parts] (const Step *first, size_t count) {
+        parts.emplace_back(first, first + count);
+    });
+    std::reverse(parts.begin(), parts.end());
+    it.cur_ = parts.front().first;
+    it.partEnd_ = parts.front().second;
+    it.parts_ = std::make_shared<const std::vector<const_iterator::Part>>(std::move(parts));
+    return it;
+}
+
+const Step& StepList::operator[](size_t i) const {
+    DCHECK_LT(i, size());
+    const Segment *seg = tail_.get();
+    while (i < seg->base) {
+        seg = seg->prev.get();
+    }
+    return seg->steps[i - seg->base];
+}
+
+StepList::Segment* StepList::mutableTail() {
+    if (tail_ == nullptr) {
+        tail_ = std::make_shared<Segment>(nullptr, 0);
+    } else if (tail_.use_count() != 1) {
+        if (tail_->steps.size() <= kMaxCopiedSteps) {
+            auto seg = std::make_shared<Segment>(tail_->prev, tail_->base);
+            seg->steps = tail_->steps;
+            tail_ = std::move(seg);
+        } else {
+            auto base = size();
+            tail_ = std::make_shared<Segment>(std::move(tail_), base);
+        }
+    }
+    return tail_.get();
+}
+
+Step& StepList::back() {
+    DCHECK(!empty());
+    if (tail_.use_count() != 1) {
+        if (tail_->steps.size() <= kMaxCopiedSteps) {
+            mutableTail();
+        } else {
+            auto last = tail_->steps.back();
+            auto base = size() - 1;
+            tail_ = std::make_shared<Segment>(std::move(tail_), base);
+            tail_->steps.emplace_back(std::move(last));
+        }
+    }
+    return tail_->steps.back();
+}
+
+void StepList::append(const StepList &steps) {
+    if (empty()) {
+        tail_ = steps.tail_;
+        return;
+    }
+    reserve(size() + steps.size());
+    for (const auto &step : steps) {
+        emplace_back(step);
+    }
+}
+
+void StepList::append(StepList &&steps) {
+    if (empty()) {
+        tail_ = std::move(steps.tail_);
+        return;
+    }
+    if (steps.tail_ != nullptr && steps.tail_.use_count() == 1 && steps.tail_->base == 0) {
+        // Owned in a single segment, so that the steps could be moved
+        reserve(size() + steps.size());
+        auto *seg = mutableTail();
+        seg->steps.insert(seg->steps.end(),
+                          std::make_move_iterator(steps.tail_->steps.begin()),
+                          std::make_move_iterator(steps.tail_->steps.end()));
+        steps.clear();
+        return;
+    }
+    append(static_cast<const StepList&>(steps));
+    steps.clear();
+}
+
+bool StepList::operator==(const StepList &rhs) const {
+    if (size() != rhs.size()) {
+        return false;
+    }
+    return tail_ == rhs.tail_ || std::equal(begin(), end(), rhs.begin());
+}
+
+
+Path Path::reversed() const {
+    Path path;
+    if (steps.empty()) {
+        path.src = src;
+        return path;
+    }
+    std::vector<Step> reversed;
+    reversed.reserve(steps.size());
+    // The destination of a reversed step is the one of the step before it,
+    // which is visited right after it
+    steps.forEachReversed([&] (const Step &step) {
+        if (reversed.empty()) {
+            path.src = step.dst;
+        } else {
+            reversed.back().dst = step.dst;
+        }
+        reversed.emplace_back(Vertex(), -step.type, step.name, step.ranking, step.props);
+    });
+    reversed.back().dst = src;
+    path.steps = StepList(std::move(reversed));
+    return path;
+}
+
 void Path::reverse() {
     if (steps.empty()) {
         return;
     }
-    std::reverse(steps.begin(), steps.end());
-    swap(src, steps.front().dst);
-    for (size_t i = 0; i < steps.size() - 1; ++i) {
-        swap(steps[i].dst, steps[i + 1].dst);
-        steps[i].type = -steps[i].type;
-    }
-    steps.back().type = -steps.back().type;
+    *this = reversed();
 }
 
 bool Path::append(Path path) {
-    if (src != path.src && steps.back().dst != path.src) {
+    if (src != path.src && std::as_const(steps).back().dst != path.src) {
         return false;
     }
-    steps.reserve(steps.size() + path.steps.size());
-    steps.insert(steps.end(),
-                 std::make_move_iterator(path.steps.begin()),
-                 std::make_move_iterator(path.steps.end()));
+    steps.append(std::move(path.steps));
     return true;
 }
 
@@ -42,12 +172,9 @@ bool Path::hasDuplicateVertices() const {
     if (steps.empty()) {
         return false;
     }
-    std::unordered_set<Value> uniqueVid;
-    uniqueVid.reserve(steps.size() + 1);
-    uniqueVid.emplace(src.vid);
+    UniqueVertices vertices(src.vid);
     for (const auto& step : steps) {
-        auto ret = uniqueVid.emplace(step.dst.vid);
-        if (!ret.second) {
+        if (!vertices.add(step.dst.vid)) {
             return true;
         }
     }
@@ -58,22 +185,13 @@ bool Path::hasDuplicateEdges() const {
     if (steps.size() < 2) {
         return false;
     }
-    using Key = std::tuple<Value, Value, EdgeType, EdgeRanking>;
-    std::unordered_set<Key> uniqueSet;
-    uniqueSet.reserve(steps.size());
-    auto srcVid = src.vid;
+    UniqueEdges edges;
+    const auto* srcVid = &src.vid;
     for (const auto& step : steps) {
-        const auto& dstVid = step.dst.vid;
-        bool ret = true;
-        if (step.type > 0) {
-            ret = uniqueSet.emplace(srcVid, dstVid, step.type, step.ranking).second;
-        } else {
-            ret = uniqueSet.emplace(dstVid, srcVid, -step.type, step.ranking).second;
-        }
-        if (!ret) {
+        if (!edges.add(*srcVid, step.dst.vid, step.type, step.ranking)) {
             return true;
         }
-        srcVid = dstVid;
+        srcVid = &step.dst.vid;
     }
     return false;
 }
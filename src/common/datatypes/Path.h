@@ -18,7 +18,7 @@ struct Step {
     EdgeType type;
     std::string name;
     EdgeRanking ranking;
-    std::unordered_map<std::string, Value> props;
+    Props props;
 
     Step() = default;
     Step(const Step& s) : dst(s.dst)
@@ -36,7 +36,7 @@ struct Step {
          EdgeType t,
          std::string n,
          EdgeRanking r,
-         std::unordered_map<std::string, Value> p) noexcept
+         Props p) noexcept
         : dst(std::move(d)), type(t), name(std::move(n)), ranking(r), props(std::move(p)) {}
 
     void clear() {
@@ -112,9 +112,206 @@ struct Step {
 };
 
 
+/**
+ * The steps of a path, which are segments of steps chained from the last one back
+ * to the first one. Copying it shares all the segments, and extending a copy adds a
+ * segment of its own on top of the shared ones, so that the paths growing from the
+ * same prefix, e.g. those of a traversal, share the steps and the vertices of the
+ * prefix instead of copying them once per hop.
+ *
+ * A segment is modified in place by its single owner only, and is immutable once
+ * shared. It keeps the interface of `std::vector<Step>', which it replaces, except
+ * that the steps are modified through back() and emplace_back() only, and that the
+ * random access walks the segments, so that iterating is preferred.
+ */
+class StepList final {
+public:
+    class const_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Step;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Step&;
+        using pointer = const Step*;
+
+        const Step& operator*() const {
+            return *cur_;
+        }
+
+        const Step* operator->() const {
+            return cur_;
+        }
+
+        const_iterator& operator++() {
+            i_++;
+            if (++cur_ == partEnd_ && parts_ != nullptr && ++part_ < parts_->size()) {
+                cur_ = (*parts_)[part_].first;
+                partEnd_ = (*parts_)[part_].second;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator &rhs) const {
+            return i_ == rhs.i_;
+        }
+
+        bool operator!=(const const_iterator &rhs) const {
+            return i_ != rhs.i_;
+        }
+
+    private:
+        friend class StepList;
+        // The visible steps of a segment, as [first, last)
+        using Part = std::pair<const Step*, const Step*>;
+
+        // Of the parts in order, when there are more than one
+        std::shared_ptr<const std::vector<Part>>    parts_;
+        size_t                                      part_{0};
+        size_t                                      i_{0};
+        const Step                                 *cur_{nullptr};
+        const Step                                 *partEnd_{nullptr};
+    };
+
+    using iterator = const_iterator;
+
+    StepList() = default;
+
+    // NOLINTNEXTLINE(runtime/explicit)
+    StepList(std::vector<Step> steps);
+
+    StepList(std::initializer_list<Step> steps)
+        : StepList(std::vector<Step>(steps)) {}
+
+    size_t size() const {
+        return tail_ == nullptr ? 0 : tail_->base + tail_->steps.size();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    void clear() {
+        tail_.reset();
+    }
+
+    void reserve(size_t size) {
+        if (tail_ != nullptr && tail_.use_count() == 1 && size > tail_->base) {
+            tail_->steps.reserve(size - tail_->base);
+        }
+    }
+
+    const_iterator begin() const;
+
+    const_iterator end() const {
+        const_iterator it;
+        it.i_ = size();
+        return it;
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    // Walks the segments backward, so that it takes their number of time
+    const Step& operator[](size_t i) const;
+
+    const Step& front() const {
+        return (*this)[0];
+    }
+
+    const Step& back() const {
+        DCHECK(!empty());
+        return tail_->steps.back();
+    }
+
+    // Copies the last step first if it is shared
+    Step& back();
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        mutableTail()->steps.emplace_back(std::forward<Args>(args)...);
+    }
+
+    void push_back(Step step) {
+        emplace_back(std::move(step));
+    }
+
+    // Shares the steps of `steps' if this is empty, otherwise copies them
+    void append(const StepList &steps);
+    void append(StepList &&steps);
+
+    // Calls `f' with each step from the last one to the first one
+    template <typename F>
+    void forEachReversed(F &&f) const {
+        forEachPart([&f] (const Step *first, size_t count) {
+            for (auto *step = first + count; step != first; ) {
+                f(*--step);
+            }
+        });
+    }
+
+    std::vector<Step> toVector() const {
+        return std::vector<Step>(begin(), end());
+    }
+
+    bool operator==(const StepList &rhs) const;
+
+    bool operator!=(const StepList &rhs) const {
+        return !(*this == rhs);
+    }
+
+    bool operator<(const StepList &rhs) const {
+        return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    // Below which a shared segment is copied instead of being chained to, so that
+    // the segments do not get too many as a path grows by one step at a time
+    static constexpr size_t kMaxCopiedSteps = 4;
+
+    struct Segment {
+        Segment(std::shared_ptr<const Segment> p, size_t b) : prev(std::move(p)), base(b) {}
+        ~Segment();
+
+        std::shared_ptr<const Segment>  prev;
+        // The number of the steps in front of this segment, which are the first ones
+        // of `prev' and the segments before it
+        size_t                          base;
+        std::vector<Step>               steps;
+    };
+
+    // Calls `f' with each visible part of the segments, from the last one to the first
+    template <typename F>
+    void forEachPart(F &&f) const {
+        auto n = size();
+        for (const Segment *seg = tail_.get(); seg != nullptr && n > 0; seg = seg->prev.get()) {
+            if (n > seg->base) {
+                f(seg->steps.data(), n - seg->base);
+                n = seg->base;
+            }
+        }
+    }
+
+    // The last segment, which is made owned by this only
+    Segment* mutableTail();
+
+    std::shared_ptr<Segment>                tail_;
+};
+
+
 struct Path {
     Vertex src;
-    std::vector<Step> steps;
+    StepList steps;
 
     Path() = default;
     Path(const Path& p) = default;
@@ -123,6 +320,9 @@ struct Path {
     Path(Vertex v, std::vector<Step> s)
         : src(std::move(v))
         , steps(std::move(s)) {}
+    Path(Vertex v, StepList s)
+        : src(std::move(v))
+        , steps(std::move(s)) {}
 
     void clear() {
         src.clear();
@@ -171,6 +371,9 @@ struct Path {
 
     void reverse();
 
+    // The reversed path, which is built from the steps without copying them first
+    Path reversed() const;
+
     // Append a path to another one.
     // 5->4>3 appended by 3->2->1 => 5->4->3->2->1
     bool append(Path path);
@@ -15,6 +15,7 @@
 
 #include "common/datatypes/Path.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropsOps.inl"
 
 namespace apache {
 namespace thrift {
@@ -88,10 +89,7 @@ uint32_t Cpp2Ops<nebula::Step>::write(Protocol* proto, nebula::Step const* obj)
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("props", apache::thrift::protocol::T_MAP, 5);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::write(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::write(proto, &obj->props);
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -152,11 +150,7 @@ _readField_ranking:
 
 _readField_props:
     {
-        obj->props = std::unordered_map<std::string, nebula::Value>();
-        detail::pm::protocol_methods<
-                type_class::map<type_class::binary, type_class::structure>,
-                std::unordered_map<std::string, nebula::Value>
-            >::read(*proto, obj->props);
+        Cpp2Ops<nebula::Props>::read(proto, &obj->props);
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 5, 0, protocol::T_STOP))) {
@@ -253,10 +247,7 @@ uint32_t Cpp2Ops<nebula::Step>::serializedSize(Protocol const* proto,
         ::serializedSize<false>(*proto, obj->ranking);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 5);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -284,10 +275,7 @@ uint32_t Cpp2Ops<nebula::Step>::serializedSizeZC(Protocol const* proto,
         ::serializedSize<false>(*proto, obj->ranking);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 5);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -335,10 +323,11 @@ uint32_t Cpp2Ops<nebula::Path>::write(Protocol* proto, nebula::Path const* obj)
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("steps", apache::thrift::protocol::T_LIST, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::list<type_class::structure>,
-            std::vector<nebula::Step>
-        >::write(*proto, obj->steps);
+    xfer += proto->writeListBegin(apache::thrift::protocol::T_STRUCT, obj->steps.size());
+    for (const auto& step : obj->steps) {
+        xfer += Cpp2Ops<nebula::Step>::write(proto, &step);
+    }
+    xfer += proto->writeListEnd();
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -370,11 +359,12 @@ _readField_src:
 
 _readField_steps:
     {
-        obj->steps = std::vector<nebula::Step>();
+        std::vector<nebula::Step> steps;
         detail::pm::protocol_methods<
                 type_class::list<type_class::structure>,
                 std::vector<nebula::Step>
-            >::read(*proto, obj->steps);
+            >::read(*proto, steps);
+        obj->steps = nebula::StepList(std::move(steps));
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 2, 0, protocol::T_STOP))) {
@@ -436,10 +426,12 @@ uint32_t Cpp2Ops<nebula::Path>::serializedSize(Protocol const* proto,
     xfer += Cpp2Ops<nebula::Vertex>::serializedSize(proto, &obj->src);
 
     xfer += proto->serializedFieldSize("steps", apache::thrift::protocol::T_LIST, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::list<type_class::structure>,
-            std::vector<nebula::Step>
-        >::serializedSize<false>(*proto, obj->steps);
+    xfer += proto->serializedSizeListBegin(apache::thrift::protocol::T_STRUCT,
+                                           obj->steps.size());
+    for (const auto& step : obj->steps) {
+        xfer += Cpp2Ops<nebula::Step>::serializedSize(proto, &step);
+    }
+    xfer += proto->serializedSizeListEnd();
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -456,10 +448,12 @@ uint32_t Cpp2Ops<nebula::Path>::serializedSizeZC(Protocol const* proto,
     xfer += Cpp2Ops<nebula::Vertex>::serializedSizeZC(proto, &obj->src);
 
     xfer += proto->serializedFieldSize("steps", apache::thrift::protocol::T_LIST, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::list<type_class::structure>,
-            std::vector<nebula::Step>
-        >::serializedSize<false>(*proto, obj->steps);
+    xfer += proto->serializedSizeListBegin(apache::thrift::protocol::T_STRUCT,
+                                           obj->steps.size());
+    for (const auto& step : obj->steps) {
+        xfer += Cpp2Ops<nebula::Step>::serializedSizeZC(proto, &step);
+    }
+    xfer += proto->serializedSizeListEnd();
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -0,0 +1,216 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_DATATYPES_PATHUNIQUENESS_H_
+#define COMMON_DATATYPES_PATHUNIQUENESS_H_
+
+#include <folly/hash/Hash.h>
+#include <folly/small_vector.h>
+
+#include "common/datatypes/Value.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+
+namespace detail {
+
+/**
+ * The set of the keys of a path, which is extended one step at a time.
+ *
+ * Up to kMaxScanned keys, which are kept inline, it is searched linearly, so that it
+ * allocates nothing for a short path. Beyond that, the keys are indexed by an open
+ * addressing table of their 32-bit fingerprints and their indexes, which are compared
+ * before the keys themselves.
+ */
+template <typename Key>
+class PathKeySet final {
+public:
+    static constexpr size_t kMaxScanned = 16;
+
+    // Adds `key' if absent, returning whether it is added
+    bool insert(const Key &key) {
+        if (slots_.empty()) {
+            for (const auto &k : keys_) {
+                if (k == key) {
+                    return false;
+                }
+            }
+            keys_.push_back(key);
+            if (keys_.size() > kMaxScanned) {
+                rehash(4 * kMaxScanned);
+            }
+            return true;
+        }
+
+        auto fingerprint = fingerprintOf(key);
+        auto mask = slots_.size() - 1;
+        auto i = fingerprint & mask;
+        for (; slots_[i] != 0; i = (i + 1) & mask) {
+            if ((slots_[i] >> 32) == fingerprint && keys_[(slots_[i] & kIndexMask) - 1] == key) {
+                return false;
+            }
+        }
+        keys_.push_back(key);
+        if (2 * keys_.size() > slots_.size()) {
+            rehash(2 * slots_.size());
+        } else {
+            slots_[i] = slotOf(fingerprint, keys_.size());
+        }
+        return true;
+    }
+
+    size_t size() const {
+        return keys_.size();
+    }
+
+    void clear() {
+        keys_.clear();
+        slots_.clear();
+    }
+
+private:
+    static constexpr uint64_t kIndexMask = 0xFFFFFFFF;
+
+    static uint32_t fingerprintOf(const Key &key) {
+        auto hash = key.hash();
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    // Of the fingerprint and the index plus one, so that an empty slot is 0
+    static uint64_t slotOf(uint32_t fingerprint, size_t index) {
+        return (static_cast<uint64_t>(fingerprint) << 32) | index;
+    }
+
+    void rehash(size_t size) {
+        // The fingerprints of the keys already indexed are kept in the slots
+        std::vector<uint64_t> slots(size, 0);
+        auto mask = size - 1;
+        auto place = [&slots, mask] (uint64_t slot) {
+            auto i = (slot >> 32) & mask;
+            while (slots[i] != 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = slot;
+        };
+        if (slots_.empty()) {
+            for (size_t i = 0; i < keys_.size(); i++) {
+                place(slotOf(fingerprintOf(keys_[i]), i + 1));
+            }
+        } else {
+            for (auto slot : slots_) {
+                if (slot != 0) {
+                    place(slot);
+                }
+            }
+            place(slotOf(fingerprintOf(keys_.back()), keys_.size()));
+        }
+        slots_ = std::move(slots);
+    }
+
+    folly::small_vector<Key, kMaxScanned>       keys_;
+    // Empty while the keys are searched linearly
+    std::vector<uint64_t>                       slots_;
+};
+
+
+struct PathVertexKey {
+    size_t hash() const {
+        return std::hash<Value>()(*vid);
+    }
+
+    bool operator==(const PathVertexKey &rhs) const {
+        return *vid == *rhs.vid;
+    }
+
+    const Value        *vid;
+};
+
+
+// Of the direction in which the edge is stored, i.e. with a positive type
+struct PathEdgeKey {
+    size_t hash() const {
+        auto hash = std::hash<Value>()(*src);
+        hash = folly::hash::hash_128_to_64(hash, std::hash<Value>()(*dst));
+        return folly::hash::hash_128_to_64(hash, folly::hash::twang_mix64(
+            (static_cast<uint64_t>(static_cast<uint32_t>(type)) << 32) ^
+            static_cast<uint64_t>(ranking)));
+    }
+
+    bool operator==(const PathEdgeKey &rhs) const {
+        return type == rhs.type && ranking == rhs.ranking && *src == *rhs.src && *dst == *rhs.dst;
+    }
+
+    const Value        *src;
+    const Value        *dst;
+    EdgeType            type;
+    EdgeRanking         ranking;
+};
+
+}  // namespace detail
+
+
+/**
+ * Tracks the vertices of a path as it is extended one step at a time, which is for
+ * the acyclic traversals, i.e. those which visit a vertex at most once.
+ *
+ * It refers to the vids instead of copying them, so that they have to outlive it.
+ */
+class UniqueVertices final {
+public:
+    UniqueVertices() = default;
+
+    explicit UniqueVertices(const Value &src) {
+        add(src);
+    }
+
+    // Returns false if `vid' is already in the path
+    bool add(const Value &vid) {
+        return vids_.insert(detail::PathVertexKey{&vid});
+    }
+
+    size_t size() const {
+        return vids_.size();
+    }
+
+    void clear() {
+        vids_.clear();
+    }
+
+private:
+    detail::PathKeySet<detail::PathVertexKey>       vids_;
+};
+
+
+/**
+ * Tracks the edges of a path as it is extended one step at a time, which is for the
+ * trails, i.e. the traversals which pass an edge at most once, in either direction.
+ *
+ * It refers to the vids instead of copying them, so that they have to outlive it.
+ */
+class UniqueEdges final {
+public:
+    // Returns false if the edge is already in the path
+    bool add(const Value &src, const Value &dst, EdgeType type, EdgeRanking ranking) {
+        if (type < 0) {
+            return edges_.insert(detail::PathEdgeKey{&dst, &src, -type, ranking});
+        }
+        return edges_.insert(detail::PathEdgeKey{&src, &dst, type, ranking});
+    }
+
+    size_t size() const {
+        return edges_.size();
+    }
+
+    void clear() {
+        edges_.clear();
+    }
+
+private:
+    detail::PathKeySet<detail::PathEdgeKey>         edges_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_PATHUNIQUENESS_H_
@@ -0,0 +1,210 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <array>
+#include <mutex>
+
+#include "common/datatypes/Props.h"
+
+namespace nebula {
+
+PropLayout::PropLayout(std::vector<std::string> names) : names_(std::move(names)) {
+    reindex();
+}
+
+void PropLayout::reindex() {
+    index_.clear();
+    unique_ = true;
+    if (names_.size() < kMinIndexed) {
+        for (size_t i = 1; i < names_.size() && unique_; i++) {
+            unique_ = std::find(names_.begin(), names_.begin() + i, names_[i])
+                   == names_.begin() + i;
+        }
+        return;
+    }
+    index_.reserve(names_.size());
+    for (size_t i = 0; i < names_.size(); i++) {
+        unique_ = index_.emplace(names_[i], i).second && unique_;
+    }
+}
+
+void PropLayout::append(const std::string &name) {
+    DCHECK(!interned_);
+    auto capacity = names_.capacity();
+    names_.emplace_back(name);
+    // The index refers to the names, which are moved if reallocated
+    if (names_.capacity() != capacity || names_.size() == kMinIndexed) {
+        reindex();
+    } else if (names_.size() > kMinIndexed) {
+        index_.emplace(names_.back(), names_.size() - 1);
+    }
+}
+
+void PropLayout::remove(size_t i) {
+    DCHECK(!interned_);
+    DCHECK_LT(i, names_.size());
+    names_.erase(names_.begin() + i);
+    reindex();
+}
+
+size_t PropLayout::indexOf(folly::StringPiece name) const {
+    if (names_.size() < kMinIndexed) {
+        for (size_t i = 0; i < names_.size(); i++) {
+            if (name == names_[i]) {
+                return i;
+            }
+        }
+        return kNotFound;
+    }
+    auto it = index_.find(name);
+    return it == index_.end() ? kNotFound : it->second;
+}
+
+// static
+std::shared_ptr<const PropLayout> PropLayout::intern(std::vector<std::string> names) {
+    // Keyed by the names joined by '\0', which never appears in a name
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::weak_ptr<const PropLayout>> layouts;
+    // Size of `layouts' over which the expired ones are swept
+    static size_t sweepSize = 64;
+    // The layouts interned lately by this thread, which are kept alive by it
+    static constexpr size_t kNumRecent = 4;
+    thread_local std::array<std::shared_ptr<const PropLayout>, kNumRecent> recent;
+    thread_local size_t nextRecent = 0;
+
+    for (const auto &layout : recent) {
+        if (layout != nullptr && layout->names() == names) {
+            return layout;
+        }
+    }
+
+    std::string key;
+    for (const auto &name : names) {
+        key.append(name);
+        key.push_back('\0');
+    }
+    std::shared_ptr<const PropLayout> layout;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto &entry = layouts[key];
+        layout = entry.lock();
+        if (layout == nullptr) {
+            auto created = std::make_shared<PropLayout>(std::move(names));
+            created->interned_ = true;
+            layout = std::move(created);
+            entry = layout;
+            if (layouts.size() >= sweepSize) {
+                for (auto it = layouts.begin(); it != layouts.end(); ) {
+                    it = it->second.expired() ? layouts.erase(it) : std::next(it);
+                }
+                sweepSize = std::max(sweepSize, 2 * layouts.size());
+            }
+        }
+    }
+    recent[nextRecent] = layout;
+    nextRecent = (nextRecent + 1) % kNumRecent;
+    return layout;
+}
+
+
+Props::Props(Map map) {
+    if (map.empty()) {
+        return;
+    }
+    std::vector<std::string> names;
+    names.reserve(map.size());
+    for (const auto &kv : map) {
+        names.emplace_back(kv.first);
+    }
+    std::sort(names.begin(), names.end());
+    values_.reserve(names.size());
+    for (const auto &name : names) {
+        values_.emplace_back(std::move(map[name]));
+    }
+    layout_ = PropLayout::intern(std::move(names));
+}
+
+const Value& Props::at(folly::StringPiece name) const {
+    auto i = indexOf(name);
+    if (i == values_.size()) {
+        throw std::out_of_range(folly::stringPrintf("No property `%s'", name.str().c_str()));
+    }
+    return values_[i];
+}
+
+Value& Props::at(folly::StringPiece name) {
+    return const_cast<Value&>(static_cast<const Props*>(this)->at(name));
+}
+
+Value& Props::operator[](const std::string &name) {
+    return emplace(name, Value()).first->second;
+}
+
+std::pair<Props::iterator, bool> Props::emplace(const std::string &name, Value value) {
+    auto i = indexOf(name);
+    if (i != values_.size()) {
+        return std::make_pair(iterator(this, i), false);
+    }
+    mutableLayout().append(name);
+    values_.emplace_back(std::move(value));
+    return std::make_pair(iterator(this, i), true);
+}
+
+size_t Props::erase(folly::StringPiece name) {
+    auto i = indexOf(name);
+    if (i == values_.size()) {
+        return 0;
+    }
+    if (values_.size() == 1) {
+        clear();
+        return 1;
+    }
+    mutableLayout().remove(i);
+    values_.erase(values_.begin() + i);
+    return 1;
+}
+
+void Props::internLayout() {
+    if (layout_ != nullptr && !layout_->interned_) {
+        layout_ = PropLayout::intern(layout_->names());
+    }
+}
+
+PropLayout& Props::mutableLayout() {
+    // Nobody else could copy it meanwhile, since this one is being modified
+    if (layout_ == nullptr || layout_->interned_ || layout_.use_count() > 1) {
+        layout_ = std::make_shared<PropLayout>(
+            layout_ == nullptr ? std::vector<std::string>() : layout_->names());
+    }
+    return const_cast<PropLayout&>(*layout_);
+}
+
+Props::Map Props::toMap() const {
+    Map map;
+    map.reserve(values_.size());
+    for (size_t i = 0; i < values_.size(); i++) {
+        map.emplace(layout_->name(i), values_[i]);
+    }
+    return map;
+}
+
+bool Props::operator==(const Props &rhs) const {
+    if (values_.size() != rhs.values_.size()) {
+        return false;
+    }
+    if (layout_ == rhs.layout_) {
+        return values_ == rhs.values_;
+    }
+    for (size_t i = 0; i < values_.size(); i++) {
+        auto j = rhs.layout_->indexOf(layout_->name(i));
+        if (j == PropLayout::kNotFound || values_[i] != rhs.values_[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace nebula
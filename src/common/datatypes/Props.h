@@ -0,0 +1,292 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_DATATYPES_PROPS_H_
+#define COMMON_DATATYPES_PROPS_H_
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/hash/Hash.h>
+
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+/**
+ * The names of the properties in order, which are interned, so that all the
+ * vertices and edges of the same schema share a single copy of them.
+ *
+ * A layout not interned is private to the Props building it, which appends
+ * the names to it in place.
+ */
+class PropLayout final {
+public:
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+    /**
+     * The layout of `names', which is the same object for the same names in
+     * the same order as long as any of them is alive.
+     * The layouts interned lately by the thread are looked up first, without locking.
+     */
+    static std::shared_ptr<const PropLayout> intern(std::vector<std::string> names);
+
+    size_t size() const {
+        return names_.size();
+    }
+
+    const std::string& name(size_t i) const {
+        DCHECK_LT(i, names_.size());
+        return names_[i];
+    }
+
+    const std::vector<std::string>& names() const {
+        return names_;
+    }
+
+    // The index of `name', or kNotFound
+    size_t indexOf(folly::StringPiece name) const;
+
+    // Whether no name appears twice
+    bool unique() const {
+        return unique_;
+    }
+
+    // Use intern() instead, unless the layout is not to be shared
+    explicit PropLayout(std::vector<std::string> names);
+
+private:
+    friend class Props;
+
+    // Below which the names are searched linearly, which beats hashing
+    static constexpr size_t kMinIndexed = 8;
+
+    // Only for the private ones
+    void append(const std::string &name);
+    void remove(size_t i);
+
+    void reindex();
+
+    std::vector<std::string>                        names_;
+    bool                                            interned_{false};
+    bool                                            unique_{true};
+    // Referring to `names_'
+    std::unordered_map<folly::StringPiece,
+                       size_t,
+                       folly::hasher<folly::StringPiece>>  index_;
+};
+
+
+/**
+ * Properties of a tag, an edge or a step, which are a shared PropLayout and
+ * a flat vector of values.
+ *
+ * It keeps the interface of `std::unordered_map<std::string, Value>', which it
+ * replaces, except that the entries are iterated in the order of the layout,
+ * and that they are proxies of a name and a value instead of pairs.
+ * Copying it copies the values only.
+ *
+ * Building it from a map takes the names sorted, so that the props of the same
+ * names share a layout no matter where they are from. Adding or erasing a name
+ * switches it to a private layout, copied on write, which is not shared with the
+ * other props until internLayout(). So it is still preferred to be built from
+ * a layout at once, e.g. the one of NebulaSchemaProvider.
+ */
+class Props final {
+public:
+    using Map = std::unordered_map<std::string, Value>;
+
+    template <bool kConst>
+    class Iterator final {
+    public:
+        using ValueRef = std::conditional_t<kConst, const Value&, Value&>;
+        using PropsPtr = std::conditional_t<kConst, const Props*, Props*>;
+
+        struct Entry {
+            Entry(const std::string &name, ValueRef value) : first(name), second(value) {}
+
+            const std::string  &first;
+            ValueRef            second;
+        };
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const std::string, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Entry&;
+        using pointer = const Entry*;
+
+        Iterator() = default;
+        Iterator(PropsPtr props, size_t i) : props_(props), i_(i) {}
+        Iterator(const Iterator &rhs) : props_(rhs.props_), i_(rhs.i_) {}
+        // The const one from the non-const one
+        template <bool kOther, typename = std::enable_if_t<kConst && !kOther>>
+        Iterator(const Iterator<kOther> &rhs) : props_(rhs.props_), i_(rhs.i_) {}
+
+        Iterator& operator=(const Iterator &rhs) {
+            props_ = rhs.props_;
+            i_ = rhs.i_;
+            entry_.reset();
+            return *this;
+        }
+
+        const Entry& operator*() const {
+            entry_.emplace(props_->layout_->name(i_), props_->values_[i_]);
+            return *entry_;
+        }
+
+        const Entry* operator->() const {
+            return &**this;
+        }
+
+        Iterator& operator++() {
+            i_++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto old = *this;
+            i_++;
+            return old;
+        }
+
+        bool operator==(const Iterator &rhs) const {
+            return i_ == rhs.i_;
+        }
+
+        bool operator!=(const Iterator &rhs) const {
+            return i_ != rhs.i_;
+        }
+
+    private:
+        friend class Iterator<true>;
+
+        PropsPtr                                    props_{nullptr};
+        size_t                                      i_{0};
+        mutable std::optional<Entry>                entry_;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    Props() = default;
+    Props(const Props&) = default;
+    Props(Props&&) noexcept = default;
+    Props& operator=(const Props&) = default;
+    Props& operator=(Props&&) noexcept = default;
+
+    // `values' in the order of `layout'
+    Props(std::shared_ptr<const PropLayout> layout, std::vector<Value> values)
+        : layout_(std::move(layout)), values_(std::move(values)) {
+        DCHECK_EQ(layout_ == nullptr ? 0 : layout_->size(), values_.size());
+    }
+
+    // NOLINTNEXTLINE(runtime/explicit)
+    Props(Map map);
+
+    // Of the first ones of the duplicate names, as a map does
+    Props(std::initializer_list<std::pair<const std::string, Value>> init)
+        : Props(Map(init)) {}
+
+    size_t size() const {
+        return values_.size();
+    }
+
+    bool empty() const {
+        return values_.empty();
+    }
+
+    void clear() {
+        layout_.reset();
+        values_.clear();
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, values_.size());
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, values_.size());
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    iterator find(folly::StringPiece name) {
+        return iterator(this, indexOf(name));
+    }
+
+    const_iterator find(folly::StringPiece name) const {
+        return const_iterator(this, indexOf(name));
+    }
+
+    size_t count(folly::StringPiece name) const {
+        return indexOf(name) == values_.size() ? 0 : 1;
+    }
+
+    // Throws std::out_of_range if absent, as a map does
+    const Value& at(folly::StringPiece name) const;
+    Value& at(folly::StringPiece name);
+
+    // The value of `name', which is added as empty if absent
+    Value& operator[](const std::string &name);
+
+    // To add `name' if absent
+    std::pair<iterator, bool> emplace(const std::string &name, Value value);
+
+    size_t erase(folly::StringPiece name);
+
+    // To switch to the interned layout of the names, e.g. once built by emplace()
+    void internLayout();
+
+    const std::shared_ptr<const PropLayout>& layout() const {
+        return layout_;
+    }
+
+    const std::vector<Value>& values() const {
+        return values_;
+    }
+
+    Map toMap() const;
+
+    bool operator==(const Props &rhs) const;
+
+    bool operator!=(const Props &rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    // The index of `name', or size() if absent
+    size_t indexOf(folly::StringPiece name) const {
+        if (layout_ == nullptr) {
+            return 0;
+        }
+        auto i = layout_->indexOf(name);
+        return i == PropLayout::kNotFound ? values_.size() : i;
+    }
+
+    // The layout to add or erase names, which is private to this one
+    PropLayout& mutableLayout();
+
+    std::shared_ptr<const PropLayout>       layout_;
+    std::vector<Value>                      values_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_PROPS_H_
@@ -0,0 +1,112 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_DATATYPES_PROPSOPS_H_
+#define COMMON_DATATYPES_PROPSOPS_H_
+
+#include "common/base/Base.h"
+
+#include <thrift/lib/cpp2/GeneratedCodeHelper.h>
+#include <thrift/lib/cpp2/gen/module_types_tcc.h>
+
+#include "common/datatypes/Props.h"
+#include "common/datatypes/CommonCpp2Ops.h"
+
+namespace apache {
+namespace thrift {
+
+/**************************************
+ *
+ * Ops for class Props, which is on the wire
+ * as map<binary, Value>
+ *
+ *************************************/
+inline constexpr protocol::TType Cpp2Ops<nebula::Props>::thriftType() {
+    return apache::thrift::protocol::T_MAP;
+}
+
+
+template <class Protocol>
+uint32_t Cpp2Ops<nebula::Props>::write(Protocol* proto, nebula::Props const* obj) {
+    uint32_t xfer = 0;
+    xfer += proto->writeMapBegin(apache::thrift::protocol::T_STRING,
+                                 apache::thrift::protocol::T_STRUCT,
+                                 obj->size());
+    for (const auto& prop : *obj) {
+        xfer += proto->writeBinary(prop.first);
+        xfer += Cpp2Ops<nebula::Value>::write(proto, &prop.second);
+    }
+    xfer += proto->writeMapEnd();
+    return xfer;
+}
+
+
+template <class Protocol>
+void Cpp2Ops<nebula::Props>::read(Protocol* proto, nebula::Props* obj) {
+    // Straight into the flat values, in the order on the wire, which is the layout
+    // of the writer, so that the layout is mostly the one interned lately
+    protocol::TType keyType;
+    protocol::TType valueType;
+    uint32_t size = 0;
+    proto->readMapBegin(keyType, valueType, size);
+    std::vector<std::string> names;
+    std::vector<nebula::Value> values;
+    names.reserve(size);
+    values.reserve(size);
+    auto more = [&] (uint32_t i) {
+        return Protocol::kOmitsContainerSizeHeader() ? proto->peekMap() : i < size;
+    };
+    for (uint32_t i = 0; more(i); i++) {
+        names.emplace_back();
+        proto->readBinary(names.back());
+        values.emplace_back();
+        Cpp2Ops<nebula::Value>::read(proto, &values.back());
+    }
+    proto->readMapEnd();
+
+    if (names.empty()) {
+        *obj = nebula::Props();
+        return;
+    }
+    auto layout = nebula::PropLayout::intern(std::move(names));
+    if (UNLIKELY(!layout->unique())) {
+        // Of the first ones of the duplicate names, as a map does
+        nebula::Props::Map map;
+        for (size_t i = 0; i < values.size(); i++) {
+            map.emplace(layout->name(i), std::move(values[i]));
+        }
+        *obj = nebula::Props(std::move(map));
+        return;
+    }
+    *obj = nebula::Props(std::move(layout), std::move(values));
+}
+
+
+template <class Protocol>
+uint32_t Cpp2Ops<nebula::Props>::serializedSize(Protocol const* proto,
+                                                nebula::Props const* obj) {
+    uint32_t xfer = 0;
+    xfer += proto->serializedSizeMapBegin(apache::thrift::protocol::T_STRING,
+                                          apache::thrift::protocol::T_STRUCT,
+                                          obj->size());
+    for (const auto& prop : *obj) {
+        xfer += proto->serializedSizeBinary(prop.first);
+        xfer += Cpp2Ops<nebula::Value>::serializedSize(proto, &prop.second);
+    }
+    xfer += proto->serializedSizeMapEnd();
+    return xfer;
+}
+
+
+template <class Protocol>
+uint32_t Cpp2Ops<nebula::Props>::serializedSizeZC(Protocol const* proto,
+                                                  nebula::Props const* obj) {
+    return serializedSize(proto, obj);
+}
+
+}  // namespace thrift
+}  // namespace apache
+#endif  // COMMON_DATATYPES_PROPSOPS_H_
@@ -9,6 +9,7 @@
 
 #include <unordered_set>
 
+#include "common/base/WyHash.h"
 #include "common/datatypes/Value.h"
 
 namespace nebula {
@@ -63,4 +64,20 @@ inline std::ostream &operator<<(std::ostream& os, const Set& s) {
 }
 
 }  // namespace nebula
+
+namespace std {
+template<>
+struct hash<nebula::Set> {
+    // The values are summed up, whichever order they are iterated in
+    std::size_t operator()(const nebula::Set& s) const noexcept {
+        using nebula::WyHash;
+        uint64_t seed = 0;
+        for (auto& v : s.values) {
+            seed += WyHash::mix(hash<nebula::Value>()(v) ^ WyHash::kSecret[0],
+                                WyHash::kSecret[1]);
+        }
+        return WyHash::mix(seed ^ WyHash::kSecret[2], s.values.size() ^ WyHash::kSecret[3]);
+    }
+};
+}  // namespace std
 #endif  // COMMON_DATATYPES_SET_H_
@@ -11,6 +11,7 @@
 #include <folly/String.h>
 #include <glog/logging.h>
 
+#include "common/base/WyHash.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/Map.h"
@@ -40,7 +41,7 @@ std::size_t hash<nebula::Value>::operator()(const nebula::Value& v) const noexce
             return hash<double>()(v.getFloat());
         }
         case nebula::Value::Type::STRING: {
-            return hash<string>()(v.getStr());
+            return nebula::WyHash()(v.getStr());
         }
         case nebula::Value::Type::DATE: {
             return hash<nebula::Date>()(v.getDate());
@@ -64,13 +65,13 @@ std::size_t hash<nebula::Value>::operator()(const nebula::Value& v) const noexce
             return hash<nebula::List>()(v.getList());
         }
         case nebula::Value::Type::MAP: {
-            LOG(FATAL) << "Hash for MAP has not been implemented";
+            return hash<nebula::Map>()(v.getMap());
         }
         case nebula::Value::Type::SET: {
-            LOG(FATAL) << "Hash for SET has not been implemented";
+            return hash<nebula::Set>()(v.getSet());
         }
         case nebula::Value::Type::DATASET: {
-            LOG(FATAL) << "Hash for DATASET has not been implemented";
+            return hash<nebula::DataSet>()(v.getDataSet());
         }
         default: {
             LOG(FATAL) << "Unknown type";
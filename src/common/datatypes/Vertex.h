@@ -12,13 +12,14 @@
 #include <sstream>
 
 #include "common/thrift/ThriftTypes.h"
+#include "common/datatypes/Props.h"
 #include "common/datatypes/Value.h"
 
 namespace nebula {
 
 struct Tag {
     std::string name;
-    std::unordered_map<std::string, Value> props;
+    Props props;
 
     Tag() = default;
     Tag(Tag&& tag) noexcept
@@ -27,7 +28,7 @@ struct Tag {
     Tag(const Tag& tag)
         : name(tag.name)
         , props(tag.props) {}
-    Tag(std::string tagName, std::unordered_map<std::string, Value> tagProps)
+    Tag(std::string tagName, Props tagProps)
         : name(std::move(tagName))
         , props(std::move(tagProps)) {}
 
@@ -15,6 +15,7 @@
 
 #include "common/datatypes/Vertex.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropsOps.inl"
 
 namespace apache {
 namespace thrift {
@@ -60,10 +61,7 @@ uint32_t Cpp2Ops<nebula::Tag>::write(Protocol* proto, nebula::Tag const* obj) {
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("props", apache::thrift::protocol::T_MAP, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::write(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::write(proto, &obj->props);
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -95,11 +93,7 @@ _readField_name:
 
 _readField_props:
     {
-        obj->props = std::unordered_map<std::string, nebula::Value>();
-        detail::pm::protocol_methods<
-                type_class::map<type_class::binary, type_class::structure>,
-                std::unordered_map<std::string, nebula::Value>
-            >::read(*proto, obj->props);
+        Cpp2Ops<nebula::Props>::read(proto, &obj->props);
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 2, 0, protocol::T_STOP))) {
@@ -161,10 +155,7 @@ uint32_t Cpp2Ops<nebula::Tag>::serializedSize(Protocol const* proto,
     xfer += proto->serializedSizeBinary(obj->name);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -181,10 +172,7 @@ uint32_t Cpp2Ops<nebula::Tag>::serializedSizeZC(Protocol const* proto,
     xfer += proto->serializedSizeZCBinary(obj->name);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::Props>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
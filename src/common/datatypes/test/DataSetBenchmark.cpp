@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <string>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/ValueOps.inl"
+
+using nebula::DataSet;
+using nebula::List;
+using nebula::Row;
+using nebula::Value;
+using serializer = apache::thrift::CompactSerializer;
+
+// In the layout of a GetNeighborsResponse, of `n' vertices with 10 edges each
+static DataSet makeNeighbors(size_t n) {
+    DataSet ds({"_vid", "_stats", "_tag:player:name:age", "_edge:+like:_dst:likeness"});
+    for (size_t i = 0; i < n; i++) {
+        List edges;
+        for (int64_t j = 0; j < 10; j++) {
+            edges.values.emplace_back(List({Value(folly::to<std::string>(i * 10 + j)),
+                                            Value(j * 10 + 5)}));
+        }
+        ds.emplace_back(Row({Value(folly::to<std::string>(i)),
+                             Value(),
+                             Value(List({Value("name"), Value(static_cast<int64_t>(i % 100))})),
+                             Value(std::move(edges))}));
+    }
+    return ds;
+}
+
+// Of the rows of ints, floats and strings only
+static DataSet makeScalars(size_t n) {
+    DataSet ds({"id", "score", "name"});
+    for (size_t i = 0; i < n; i++) {
+        ds.emplace_back(Row({Value(static_cast<int64_t>(i)),
+                             Value(i * 0.25),
+                             Value(folly::to<std::string>("name_", i))}));
+    }
+    return ds;
+}
+
+// As makeNeighbors(), but the edges of all go to the same 100 vertices
+static DataSet makeSharedNeighbors(size_t n) {
+    DataSet ds({"_vid", "_stats", "_tag:player:name:age", "_edge:+like:_dst:likeness"});
+    for (size_t i = 0; i < n; i++) {
+        List edges;
+        for (int64_t j = 0; j < 10; j++) {
+            edges.values.emplace_back(List({Value(folly::to<std::string>("team", (i + j) % 100)),
+                                            Value(j * 10 + 5)}));
+        }
+        ds.emplace_back(Row({Value(folly::to<std::string>(i)),
+                             Value(),
+                             Value(List({Value("name"), Value(static_cast<int64_t>(i % 100))})),
+                             Value(std::move(edges))}));
+    }
+    return ds;
+}
+
+size_t roundTrip(size_t iters, DataSet (*make)(size_t), bool packRows) {
+    DataSet ds;
+    BENCHMARK_SUSPEND {
+        ds = make(1000);
+        ds.packRows = packRows;
+    }
+    for (size_t i = 0; i < iters; i++) {
+        std::string buf;
+        serializer::serialize(ds, &buf);
+        DataSet copy;
+        serializer::deserialize(buf, copy);
+        folly::doNotOptimizeAway(copy);
+    }
+    return iters;
+}
+
+size_t serialize(size_t iters, DataSet (*make)(size_t), bool packRows) {
+    DataSet ds;
+    BENCHMARK_SUSPEND {
+        ds = make(1000);
+        ds.packRows = packRows;
+    }
+    for (size_t i = 0; i < iters; i++) {
+        std::string buf;
+        serializer::serialize(ds, &buf);
+        folly::doNotOptimizeAway(buf);
+    }
+    return iters;
+}
+
+size_t deserialize(size_t iters, DataSet (*make)(size_t), bool packRows) {
+    std::string buf;
+    BENCHMARK_SUSPEND {
+        auto ds = make(1000);
+        ds.packRows = packRows;
+        serializer::serialize(ds, &buf);
+    }
+    for (size_t i = 0; i < iters; i++) {
+        DataSet copy;
+        serializer::deserialize(buf, copy);
+        folly::doNotOptimizeAway(copy);
+    }
+    return iters;
+}
+
+BENCHMARK_NAMED_PARAM(roundTrip, neighbors_rows, makeNeighbors, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(roundTrip, neighbors_packed, makeNeighbors, true)
+BENCHMARK_NAMED_PARAM(roundTrip, shared_rows, makeSharedNeighbors, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(roundTrip, shared_packed, makeSharedNeighbors, true)
+BENCHMARK_NAMED_PARAM(roundTrip, scalars_rows, makeScalars, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(roundTrip, scalars_packed, makeScalars, true)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(serialize, neighbors_rows, makeNeighbors, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(serialize, neighbors_packed, makeNeighbors, true)
+BENCHMARK_NAMED_PARAM(deserialize, neighbors_rows, makeNeighbors, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(deserialize, neighbors_packed, makeNeighbors, true)
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
@@ -28,6 +28,25 @@ TEST(DataSetTest, Basic) {
     EXPECT_EQ(data, data2);
 }
 
+TEST(DataSetTest, Hash) {
+    std::hash<nebula::DataSet> hash;
+    // Of no rows, told apart by the names of the columns
+    nebula::DataSet empty1({"col1"});
+    nebula::DataSet empty2({"col2"});
+    EXPECT_NE(0U, hash(empty1));
+    EXPECT_NE(hash(empty1), hash(empty2));
+    EXPECT_NE(hash(nebula::DataSet()), hash(empty1));
+    EXPECT_EQ(hash(empty1), hash(nebula::DataSet({"col1"})));
+
+    nebula::DataSet data1({"col1"});
+    data1.emplace_back(nebula::Row({1}));
+    nebula::DataSet data2({"col1"});
+    data2.emplace_back(nebula::Row({1}));
+    EXPECT_EQ(hash(data1), hash(data2));
+    data2.emplace_back(nebula::Row({1}));
+    EXPECT_NE(hash(data1), hash(data2));
+}
+
 
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
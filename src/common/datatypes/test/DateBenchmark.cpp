@@ -0,0 +1,182 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <folly/Benchmark.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Date.h"
+#include "common/time/TimeConversion.h"
+
+using nebula::DateTime;
+using nebula::time::TimeConversion;
+
+// As DateTime::operator<() used to be, field by field
+static bool fieldLess(const DateTime &lhs, const DateTime &rhs) {
+    if (lhs.year != rhs.year) {
+        return lhs.year < rhs.year;
+    }
+    if (lhs.month != rhs.month) {
+        return lhs.month < rhs.month;
+    }
+    if (lhs.day != rhs.day) {
+        return lhs.day < rhs.day;
+    }
+    if (lhs.hour != rhs.hour) {
+        return lhs.hour < rhs.hour;
+    }
+    if (lhs.minute != rhs.minute) {
+        return lhs.minute < rhs.minute;
+    }
+    if (lhs.sec != rhs.sec) {
+        return lhs.sec < rhs.sec;
+    }
+    return lhs.microsec < rhs.microsec;
+}
+
+// Within a few days, so that the lower fields are compared as well
+static std::vector<DateTime> makeDateTimes(size_t n) {
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<int64_t> micros(1609459200000000, 1609804800000000);
+    std::vector<DateTime> dateTimes;
+    dateTimes.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        dateTimes.emplace_back(DateTime::fromEpochMicros(micros(rng)));
+    }
+    return dateTimes;
+}
+
+size_t fieldSort(size_t iters, size_t n) {
+    for (size_t i = 0; i < iters; i++) {
+        std::vector<DateTime> dateTimes;
+        BENCHMARK_SUSPEND {
+            dateTimes = makeDateTimes(n);
+        }
+        std::sort(dateTimes.begin(), dateTimes.end(), fieldLess);
+        folly::doNotOptimizeAway(dateTimes);
+    }
+    return iters;
+}
+
+size_t packedSort(size_t iters, size_t n) {
+    for (size_t i = 0; i < iters; i++) {
+        std::vector<DateTime> dateTimes;
+        BENCHMARK_SUSPEND {
+            dateTimes = makeDateTimes(n);
+        }
+        std::sort(dateTimes.begin(), dateTimes.end());
+        folly::doNotOptimizeAway(dateTimes);
+    }
+    return iters;
+}
+
+// A range filter of a column
+size_t fieldFilter(size_t iters, size_t n) {
+    std::vector<DateTime> dateTimes;
+    BENCHMARK_SUSPEND {
+        dateTimes = makeDateTimes(n);
+    }
+    DateTime lower(2021, 1, 2, 0, 0, 0, 0);
+    DateTime upper(2021, 1, 3, 12, 0, 0, 0);
+    for (size_t i = 0; i < iters; i++) {
+        size_t count = 0;
+        for (const auto &dt : dateTimes) {
+            count += !fieldLess(dt, lower) && fieldLess(dt, upper);
+        }
+        folly::doNotOptimizeAway(count);
+    }
+    return iters;
+}
+
+size_t packedFilter(size_t iters, size_t n) {
+    std::vector<DateTime> dateTimes;
+    BENCHMARK_SUSPEND {
+        dateTimes = makeDateTimes(n);
+    }
+    auto lower = DateTime(2021, 1, 2, 0, 0, 0, 0).key();
+    auto upper = DateTime(2021, 1, 3, 12, 0, 0, 0).key();
+    for (size_t i = 0; i < iters; i++) {
+        size_t count = 0;
+        for (const auto &dt : dateTimes) {
+            auto key = dt.key();
+            count += key >= lower && key < upper;
+        }
+        folly::doNotOptimizeAway(count);
+    }
+    return iters;
+}
+
+size_t fieldDiff(size_t iters, size_t n) {
+    std::vector<DateTime> dateTimes;
+    BENCHMARK_SUSPEND {
+        dateTimes = makeDateTimes(n);
+    }
+    for (size_t i = 0; i < iters; i++) {
+        int64_t sum = 0;
+        for (size_t j = 1; j < dateTimes.size(); j++) {
+            sum += TimeConversion::dateTimeDiffSeconds(dateTimes[j], dateTimes[j - 1]);
+        }
+        folly::doNotOptimizeAway(sum);
+    }
+    return iters;
+}
+
+size_t epochMicrosDiff(size_t iters, size_t n) {
+    std::vector<int64_t> micros;
+    BENCHMARK_SUSPEND {
+        for (const auto &dt : makeDateTimes(n)) {
+            micros.emplace_back(dt.toEpochMicros());
+        }
+    }
+    for (size_t i = 0; i < iters; i++) {
+        int64_t sum = 0;
+        for (size_t j = 1; j < micros.size(); j++) {
+            sum += (micros[j] - micros[j - 1]) / 1000000;
+        }
+        folly::doNotOptimizeAway(sum);
+    }
+    return iters;
+}
+
+size_t toFields(size_t iters, size_t n) {
+    std::vector<int64_t> micros;
+    BENCHMARK_SUSPEND {
+        for (const auto &dt : makeDateTimes(n)) {
+            micros.emplace_back(dt.toEpochMicros());
+        }
+    }
+    for (size_t i = 0; i < iters; i++) {
+        for (auto us : micros) {
+            folly::doNotOptimizeAway(DateTime::fromEpochMicros(us));
+        }
+    }
+    return iters;
+}
+
+BENCHMARK_NAMED_PARAM(fieldSort, 1K, 1000)
+BENCHMARK_RELATIVE_NAMED_PARAM(packedSort, 1K, 1000)
+BENCHMARK_NAMED_PARAM(fieldSort, 100K, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM(packedSort, 100K, 100000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(fieldFilter, 100K, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM(packedFilter, 100K, 100000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(fieldDiff, 100K, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM(epochMicrosDiff, 100K, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM(toFields, 100K, 100000)
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
@@ -136,6 +136,70 @@ TEST(Date, Arithmetics) {
     EXPECT_EQ(Date(-1020, 12, 31), b);
 }
 
+
+TEST(Date, EpochConversion) {
+    EXPECT_EQ(0, Date(1970, 1, 1).toEpochDays());
+    EXPECT_EQ(-1, Date(1969, 12, 31).toEpochDays());
+    EXPECT_EQ(11016, Date(2000, 2, 29).toEpochDays());
+    EXPECT_EQ(-719528, Date(0, 1, 1).toEpochDays());
+    for (auto days : {-12000000L, -719529L, -1L, 0L, 59L, 11016L, 18628L, 11000000L}) {
+        EXPECT_EQ(days, Date::fromEpochDays(days).toEpochDays());
+    }
+    EXPECT_EQ(Date(2020, 2, 29), Date::fromEpochDays(Date(2020, 2, 28).toEpochDays() + 1));
+    EXPECT_EQ(Date(-1, 12, 31), Date::fromEpochDays(Date(0, 1, 1).toEpochDays() - 1));
+
+    DateTime dt(2021, 3, 4, 12, 30, 15, 123456);
+    EXPECT_EQ(1614861015123456, dt.toEpochMicros());
+    EXPECT_EQ(dt, DateTime::fromEpochMicros(dt.toEpochMicros()));
+    dt = DateTime(1969, 12, 31, 23, 59, 59, 999999);
+    EXPECT_EQ(-1, dt.toEpochMicros());
+    EXPECT_EQ(dt, DateTime::fromEpochMicros(-1));
+    dt = DateTime(-32768, 1, 1, 0, 0, 0, 0);
+    EXPECT_EQ(dt, DateTime::fromEpochMicros(dt.toEpochMicros()));
+    dt = DateTime(32767, 12, 31, 23, 59, 59, 999999);
+    EXPECT_EQ(dt, DateTime::fromEpochMicros(dt.toEpochMicros()));
+}
+
+
+TEST(Date, Ordering) {
+    std::vector<DateTime> dateTimes = {
+        DateTime(-32768, 1, 1, 0, 0, 0, 0),
+        DateTime(-1, 12, 31, 23, 59, 59, 999999),
+        DateTime(0, 1, 1, 0, 0, 0, 0),
+        DateTime(2020, 12, 31, 0, 0, 0, 0),
+        DateTime(2021, 1, 1, 0, 0, 0, 0),
+        DateTime(2021, 1, 1, 0, 0, 0, 1),
+        DateTime(2021, 1, 1, 0, 0, 1, 0),
+        DateTime(2021, 1, 1, 0, 1, 0, 0),
+        DateTime(2021, 1, 1, 1, 0, 0, 0),
+        DateTime(2021, 1, 2, 0, 0, 0, 0),
+        DateTime(2021, 2, 1, 0, 0, 0, 0),
+        DateTime(32767, 12, 31, 23, 59, 59, 999999),
+    };
+    for (size_t i = 0; i < dateTimes.size(); i++) {
+        for (size_t j = 0; j < dateTimes.size(); j++) {
+            EXPECT_EQ(i < j, dateTimes[i] < dateTimes[j]) << dateTimes[i] << " " << dateTimes[j];
+            EXPECT_EQ(i == j, dateTimes[i] == dateTimes[j]);
+            EXPECT_EQ(i < j, dateTimes[i].toEpochMicros() < dateTimes[j].toEpochMicros());
+            Date lhs(dateTimes[i].year, dateTimes[i].month, dateTimes[i].day);
+            Date rhs(dateTimes[j].year, dateTimes[j].month, dateTimes[j].day);
+            EXPECT_EQ(lhs.toEpochDays() < rhs.toEpochDays(), lhs < rhs);
+        }
+    }
+    EXPECT_LT(Time(1, 59, 59, 999999), Time(2, 0, 0, 0));
+    EXPECT_LT(Time(2, 0, 0, 0), Time(2, 0, 0, 1));
+    EXPECT_EQ(Time(2, 0, 0, 1), Time(2, 0, 0, 1));
+}
+
+
+TEST(Date, DateTimeHash) {
+    // The same as by the qword of the layout before the fields were reordered
+    std::hash<DateTime> hash;
+    EXPECT_EQ(1116133UL, hash(DateTime(2021, 1, 1, 0, 0, 0, 0)));
+    EXPECT_EQ(4398046231662493695UL, hash(DateTime(-1, 12, 31, 23, 59, 59, 999999)));
+    EXPECT_NE(hash(DateTime(2021, 1, 1, 0, 0, 0, 0)), hash(DateTime(2021, 1, 1, 0, 0, 0, 1)));
+}
+
 }  // namespace nebula
 
 
@@ -9,10 +9,13 @@
 #include <vector>
 
 #include <folly/Benchmark.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "common/base/Base.h"
 #include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
 #include "common/datatypes/Value.h"
+#include "common/datatypes/ValueOps.inl"
 
 using nebula::Edge;
 using nebula::Value;
@@ -171,6 +174,101 @@ BENCHMARK_RELATIVE(HashTupleEdge, n) {
     }
 }
 
+// Edges of 8 properties copied between operators, with the props in a map of their own,
+// as they used to be, and with the props sharing the layout of the schema
+static const std::vector<std::string> kPropNames = {
+    "likeness", "start_year", "end_year", "weight", "comment", "created", "updated", "source",
+};
+
+static Value randomProp(size_t i) {
+    return i % 2 == 0 ? Value(random(0, 100000)) : Value(randomString(16));
+}
+
+struct MapPropsEdge {
+    Value src;
+    Value dst;
+    EdgeType type;
+    std::string name;
+    EdgeRanking ranking;
+    std::unordered_map<std::string, Value> props;
+};
+
+BENCHMARK(CopyEdgeMapProps, n) {
+    std::vector<MapPropsEdge> edges;
+    BENCHMARK_SUSPEND {
+        edges.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            MapPropsEdge edge{randomString(10), randomString(10), 1, "like", 0, {}};
+            for (size_t j = 0; j < kPropNames.size(); j++) {
+                edge.props.emplace(kPropNames[j], randomProp(j));
+            }
+            edges.emplace_back(std::move(edge));
+        }
+    }
+    auto copied = edges;
+    folly::doNotOptimizeAway(copied);
+}
+
+BENCHMARK_RELATIVE(CopyEdgeProps, n) {
+    std::vector<Edge> edges;
+    BENCHMARK_SUSPEND {
+        auto layout = nebula::PropLayout::intern(kPropNames);
+        edges.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            std::vector<Value> values;
+            for (size_t j = 0; j < kPropNames.size(); j++) {
+                values.emplace_back(randomProp(j));
+            }
+            edges.emplace_back(Edge(randomString(10), randomString(10), 1, "like", 0,
+                                    nebula::Props(layout, std::move(values))));
+        }
+    }
+    auto copied = edges;
+    folly::doNotOptimizeAway(copied);
+}
+
+// The same edges deserialized, e.g. from a storage response, with the props into a map,
+// as they used to be, and into a layout interned once and looked up per edge
+BENCHMARK(DeserializeEdgeMapProps, n) {
+    std::string buf;
+    BENCHMARK_SUSPEND {
+        nebula::List edges;
+        for (size_t i = 0; i < n; ++i) {
+            std::unordered_map<std::string, Value> props;
+            for (size_t j = 0; j < kPropNames.size(); j++) {
+                props.emplace(kPropNames[j], randomProp(j));
+            }
+            props.emplace("_src", randomString(10));
+            props.emplace("_dst", randomString(10));
+            edges.values.emplace_back(nebula::Map(std::move(props)));
+        }
+        apache::thrift::CompactSerializer::serialize(Value(std::move(edges)), &buf);
+    }
+    Value edges;
+    apache::thrift::CompactSerializer::deserialize(buf, edges);
+    folly::doNotOptimizeAway(edges);
+}
+
+BENCHMARK_RELATIVE(DeserializeEdgeProps, n) {
+    std::string buf;
+    BENCHMARK_SUSPEND {
+        auto layout = nebula::PropLayout::intern(kPropNames);
+        nebula::List edges;
+        for (size_t i = 0; i < n; ++i) {
+            std::vector<Value> values;
+            for (size_t j = 0; j < kPropNames.size(); j++) {
+                values.emplace_back(randomProp(j));
+            }
+            edges.values.emplace_back(Edge(randomString(10), randomString(10), 1, "like", 0,
+                                           nebula::Props(layout, std::move(values))));
+        }
+        apache::thrift::CompactSerializer::serialize(Value(std::move(edges)), &buf);
+    }
+    Value edges;
+    apache::thrift::CompactSerializer::deserialize(buf, edges);
+    folly::doNotOptimizeAway(edges);
+}
+
 int main() {
     folly::runBenchmarks();
     return 0;
@@ -0,0 +1,187 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <tuple>
+#include <unordered_set>
+
+#include <folly/Benchmark.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/PathUniqueness.h"
+
+namespace nebula {
+
+// A path without duplicates, so that all of it is checked
+static Path makePath(size_t length) {
+    Path path;
+    path.src = Vertex("vertex_0", {});
+    for (size_t i = 1; i <= length; i++) {
+        path.addStep(Step(Vertex(folly::stringPrintf("vertex_%zu", i), {}), 1, "like", 0, {}));
+    }
+    return path;
+}
+
+// As Path::hasDuplicateVertices() used to be, copying the vids into a set
+static bool copiedVertices(const Path& path) {
+    std::unordered_set<Value> uniqueVid;
+    uniqueVid.reserve(path.steps.size() + 1);
+    uniqueVid.emplace(path.src.vid);
+    for (const auto& step : path.steps) {
+        if (!uniqueVid.emplace(step.dst.vid).second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// As Path::hasDuplicateEdges() used to be
+static bool copiedEdges(const Path& path) {
+    using Key = std::tuple<Value, Value, EdgeType, EdgeRanking>;
+    std::unordered_set<Key> uniqueSet;
+    uniqueSet.reserve(path.steps.size());
+    auto srcVid = path.src.vid;
+    for (const auto& step : path.steps) {
+        const auto& dstVid = step.dst.vid;
+        bool ret = true;
+        if (step.type > 0) {
+            ret = uniqueSet.emplace(srcVid, dstVid, step.type, step.ranking).second;
+        } else {
+            ret = uniqueSet.emplace(dstVid, srcVid, -step.type, step.ranking).second;
+        }
+        if (!ret) {
+            return true;
+        }
+        srcVid = dstVid;
+    }
+    return false;
+}
+
+size_t copiedVerticesCheck(size_t iters, size_t length) {
+    Path path;
+    BENCHMARK_SUSPEND {
+        path = makePath(length);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        folly::doNotOptimizeAway(copiedVertices(path));
+    }
+    return iters;
+}
+
+size_t trackedVerticesCheck(size_t iters, size_t length) {
+    Path path;
+    BENCHMARK_SUSPEND {
+        path = makePath(length);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        folly::doNotOptimizeAway(path.hasDuplicateVertices());
+    }
+    return iters;
+}
+
+size_t copiedEdgesCheck(size_t iters, size_t length) {
+    Path path;
+    BENCHMARK_SUSPEND {
+        path = makePath(length);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        folly::doNotOptimizeAway(copiedEdges(path));
+    }
+    return iters;
+}
+
+size_t trackedEdgesCheck(size_t iters, size_t length) {
+    Path path;
+    BENCHMARK_SUSPEND {
+        path = makePath(length);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        folly::doNotOptimizeAway(path.hasDuplicateEdges());
+    }
+    return iters;
+}
+
+// A trail expanded one hop at a time, checked on each hop by the whole path
+size_t copiedTrailExpand(size_t iters, size_t length) {
+    Path path;
+    BENCHMARK_SUSPEND {
+        path = makePath(length);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        Path prefix;
+        prefix.src = path.src;
+        for (const auto& step : path.steps) {
+            prefix.addStep(step);
+            folly::doNotOptimizeAway(copiedEdges(prefix));
+        }
+    }
+    return iters;
+}
+
+// The same, checked on each hop by the edge of it only
+size_t trackedTrailExpand(size_t iters, size_t length) {
+    Path path;
+    BENCHMARK_SUSPEND {
+        path = makePath(length);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        Path prefix;
+        prefix.src = path.src;
+        UniqueEdges edges;
+        const auto* srcVid = &path.src.vid;
+        for (const auto& step : path.steps) {
+            prefix.addStep(step);
+            folly::doNotOptimizeAway(edges.add(*srcVid, step.dst.vid, step.type, step.ranking));
+            srcVid = &step.dst.vid;
+        }
+    }
+    return iters;
+}
+
+BENCHMARK_NAMED_PARAM(copiedVerticesCheck, 2, 2)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedVerticesCheck, 2, 2)
+BENCHMARK_NAMED_PARAM(copiedVerticesCheck, 8, 8)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedVerticesCheck, 8, 8)
+BENCHMARK_NAMED_PARAM(copiedVerticesCheck, 16, 16)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedVerticesCheck, 16, 16)
+BENCHMARK_NAMED_PARAM(copiedVerticesCheck, 32, 32)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedVerticesCheck, 32, 32)
+BENCHMARK_NAMED_PARAM(copiedVerticesCheck, 64, 64)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedVerticesCheck, 64, 64)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(copiedEdgesCheck, 2, 2)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedEdgesCheck, 2, 2)
+BENCHMARK_NAMED_PARAM(copiedEdgesCheck, 8, 8)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedEdgesCheck, 8, 8)
+BENCHMARK_NAMED_PARAM(copiedEdgesCheck, 16, 16)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedEdgesCheck, 16, 16)
+BENCHMARK_NAMED_PARAM(copiedEdgesCheck, 32, 32)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedEdgesCheck, 32, 32)
+BENCHMARK_NAMED_PARAM(copiedEdgesCheck, 64, 64)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedEdgesCheck, 64, 64)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(copiedTrailExpand, 2, 2)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedTrailExpand, 2, 2)
+BENCHMARK_NAMED_PARAM(copiedTrailExpand, 8, 8)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedTrailExpand, 8, 8)
+BENCHMARK_NAMED_PARAM(copiedTrailExpand, 16, 16)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedTrailExpand, 16, 16)
+BENCHMARK_NAMED_PARAM(copiedTrailExpand, 32, 32)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedTrailExpand, 32, 32)
+BENCHMARK_NAMED_PARAM(copiedTrailExpand, 64, 64)
+BENCHMARK_RELATIVE_NAMED_PARAM(trackedTrailExpand, 64, 64)
+
+}   // namespace nebula
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
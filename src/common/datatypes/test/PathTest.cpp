@@ -7,6 +7,7 @@
 #include "common/base/Base.h"
 #include <gtest/gtest.h>
 #include "common/datatypes/Path.h"
+#include "common/datatypes/PathUniqueness.h"
 
 namespace nebula {
 TEST(Path, Reverse) {
@@ -247,6 +248,99 @@ TEST(Path, HasSameEdgeInPath) {
     ASSERT(path.hasDuplicateEdges());
 }
 
+TEST(Path, SharedSteps) {
+    Path prefix;
+    prefix.src = Vertex("0", {});
+    for (auto i = 1; i <= 10; i++) {
+        prefix.addStep(Step(Vertex(std::to_string(i), {}), 1, "like", 0, {}));
+    }
+    // Grown one step at a time from the same prefix, as a traversal does
+    std::vector<Path> paths;
+    for (auto i = 0; i < 3; i++) {
+        auto path = prefix;
+        for (auto j = 0; j < 20; j++) {
+            auto copied = path;
+            copied.addStep(Step(Vertex(folly::stringPrintf("%d-%d", i, j), {}), 1, "like", 0, {}));
+            path = std::move(copied);
+        }
+        paths.emplace_back(std::move(path));
+    }
+    EXPECT_EQ(10, prefix.steps.size());
+    EXPECT_EQ("10", prefix.steps.back().dst.vid);
+    for (auto i = 0; i < 3; i++) {
+        const auto &steps = paths[i].steps;
+        ASSERT_EQ(30, steps.size());
+        auto vec = steps.toVector();
+        ASSERT_EQ(30, vec.size());
+        for (auto j = 0; j < 30; j++) {
+            auto vid = j < 10 ? std::to_string(j + 1) : folly::stringPrintf("%d-%d", i, j - 10);
+            EXPECT_EQ(vid, vec[j].dst.vid);
+            EXPECT_EQ(vid, steps[j].dst.vid);
+        }
+        EXPECT_EQ(Path(paths[i].src, vec), paths[i]);
+        EXPECT_EQ(std::hash<Path>()(Path(paths[i].src, vec)), std::hash<Path>()(paths[i]));
+    }
+    EXPECT_LT(paths[0], paths[1]);
+
+    // Modifying a copy leaves the others alone
+    auto copied = paths[0];
+    copied.steps.back().dst = Vertex("last", {});
+    EXPECT_EQ("last", copied.steps.back().dst.vid);
+    EXPECT_EQ("0-19", paths[0].steps.back().dst.vid);
+    EXPECT_EQ(paths[0].steps[28], copied.steps[28]);
+    copied.steps.clear();
+    EXPECT_TRUE(copied.steps.empty());
+    EXPECT_EQ(30, paths[0].steps.size());
+
+    auto reversed = paths[1].reversed();
+    EXPECT_EQ("1-19", reversed.src.vid);
+    EXPECT_EQ("0", reversed.steps.back().dst.vid);
+    EXPECT_EQ(-1, reversed.steps.front().type);
+    reversed.reverse();
+    EXPECT_EQ(paths[1], reversed);
+}
+
+TEST(Path, Uniqueness) {
+    // Across the linear search and the indexed one
+    for (auto length : {2, 16, 17, 64, 200}) {
+        Path path;
+        path.src = Vertex(0, {});
+        for (auto i = 1; i <= length; i++) {
+            path.addStep(Step(Vertex(i, {}), i % 2 == 0 ? 1 : -1, "like", i % 3, {}));
+        }
+        EXPECT_FALSE(path.hasDuplicateVertices());
+        EXPECT_FALSE(path.hasDuplicateEdges());
+
+        // Back to a vertex through another edge
+        auto cyclic = path;
+        cyclic.addStep(Step(Vertex(length / 2, {}), 1, "like", 5, {}));
+        EXPECT_TRUE(cyclic.hasDuplicateVertices());
+        EXPECT_FALSE(cyclic.hasDuplicateEdges());
+
+        // Back through the last edge, in the other direction
+        const auto &last = std::as_const(path.steps).back();
+        auto back = path;
+        back.addStep(Step(Vertex(length - 1, {}), -last.type, "like", last.ranking, {}));
+        EXPECT_TRUE(back.hasDuplicateVertices());
+        EXPECT_TRUE(back.hasDuplicateEdges());
+    }
+
+    // Referred to, rather than copied
+    Value src("a");
+    UniqueVertices vertices(src);
+    std::vector<Value> vids;
+    for (auto i = 0; i < 100; i++) {
+        vids.emplace_back(folly::stringPrintf("v%d", i));
+    }
+    for (const auto &vid : vids) {
+        EXPECT_TRUE(vertices.add(vid));
+    }
+    for (const auto &vid : vids) {
+        EXPECT_FALSE(vertices.add(vid));
+    }
+    EXPECT_EQ(101, vertices.size());
+}
+
 }   // namespace nebula
 
 int main(int argc, char** argv) {
@@ -0,0 +1,136 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Props.h"
+#include "common/datatypes/ValueOps.inl"
+#include "common/datatypes/Vertex.h"
+
+namespace nebula {
+
+TEST(Props, Layout) {
+    auto layout = PropLayout::intern({"name", "age"});
+    EXPECT_EQ(layout, PropLayout::intern({"name", "age"}));
+    EXPECT_NE(layout, PropLayout::intern({"age", "name"}));
+    EXPECT_EQ(1, layout->indexOf("age"));
+    EXPECT_EQ(PropLayout::kNotFound, layout->indexOf("Age"));
+
+    // Searched by the index
+    std::vector<std::string> names;
+    for (auto i = 0; i < 20; i++) {
+        names.emplace_back(folly::stringPrintf("prop%d", i));
+    }
+    auto wide = PropLayout::intern(names);
+    for (auto i = 0UL; i < names.size(); i++) {
+        EXPECT_EQ(i, wide->indexOf(names[i]));
+    }
+    EXPECT_EQ(PropLayout::kNotFound, wide->indexOf("prop20"));
+    EXPECT_TRUE(wide->unique());
+    EXPECT_FALSE(PropLayout::intern({"name", "age", "name"})->unique());
+}
+
+TEST(Props, MapLike) {
+    Props props = {{"name", "Tim"}, {"age", 30}};
+    EXPECT_EQ(2, props.size());
+    // Of the same names, no matter the order
+    Props other(std::unordered_map<std::string, Value>{{"age", 30}, {"name", "Tim"}});
+    EXPECT_EQ(props.layout(), other.layout());
+    EXPECT_EQ(props, other);
+
+    EXPECT_EQ(Value("Tim"), props.find("name")->second);
+    EXPECT_EQ(props.end(), props.find("likeness"));
+    EXPECT_EQ(1, props.count("age"));
+    EXPECT_EQ(Value(30), props.at("age"));
+    EXPECT_THROW(props.at("likeness"), std::out_of_range);
+
+    props["likeness"] = 90.0;
+    EXPECT_EQ(3, props.size());
+    EXPECT_NE(props, other);
+    EXPECT_FALSE(props.emplace("likeness", 80.0).second);
+    EXPECT_EQ(Value(90.0), props.at("likeness"));
+    EXPECT_EQ(1, props.erase("likeness"));
+    EXPECT_EQ(0, props.erase("likeness"));
+    EXPECT_EQ(props, other);
+
+    for (auto &prop : props) {
+        if (prop.first == "age") {
+            prop.second = 31;
+        }
+    }
+    std::unordered_map<std::string, Value> expected = {{"name", "Tim"}, {"age", 31}};
+    EXPECT_EQ(expected, props.toMap());
+
+    // Of another layout
+    Props reordered(PropLayout::intern({"name", "age"}), {"Tim", 31});
+    EXPECT_NE(props.layout(), reordered.layout());
+    EXPECT_EQ(props, reordered);
+
+    props.clear();
+    EXPECT_TRUE(props.empty());
+    EXPECT_EQ(props.begin(), props.end());
+    EXPECT_EQ(Props(), props);
+}
+
+TEST(Props, BuiltByEmplace) {
+    Props props;
+    for (auto i = 0; i < 20; i++) {
+        EXPECT_TRUE(props.emplace(folly::stringPrintf("prop%d", i), i).second);
+    }
+    EXPECT_EQ(20, props.size());
+    for (auto i = 0; i < 20; i++) {
+        EXPECT_EQ(Value(i), props.at(folly::stringPrintf("prop%d", i)));
+    }
+
+    // Copied on write
+    auto copied = props;
+    EXPECT_EQ(props.layout(), copied.layout());
+    copied["extra"] = 1;
+    EXPECT_NE(props.layout(), copied.layout());
+    EXPECT_EQ(0, props.count("extra"));
+    EXPECT_EQ(Value(1), copied.at("extra"));
+
+    EXPECT_EQ(1, props.erase("prop3"));
+    EXPECT_EQ(19, props.size());
+    EXPECT_EQ(Value(4), props.at("prop4"));
+    EXPECT_EQ(Value(3), copied.at("prop3"));
+
+    props.internLayout();
+    EXPECT_EQ(PropLayout::intern(props.layout()->names()), props.layout());
+    EXPECT_EQ(Value(19), props.at("prop19"));
+}
+
+TEST(Props, Serialize) {
+    Edge edge("100", "200", 1, "like", 0, {{"likeness", 90.0}, {"start_year", 2010}});
+    std::string buf;
+    apache::thrift::CompactSerializer::serialize(Value(edge), &buf);
+    Value copied;
+    apache::thrift::CompactSerializer::deserialize(buf, copied);
+    EXPECT_EQ(Value(edge), copied);
+    // In the layout of the writer, which is interned
+    EXPECT_EQ(edge.props.layout(), copied.getEdge().props.layout());
+
+    Props empty;
+    buf.clear();
+    apache::thrift::CompactSerializer::serialize(Value(Edge("100", "200", 1, "like", 0, empty)),
+                                                 &buf);
+    apache::thrift::CompactSerializer::deserialize(buf, copied);
+    EXPECT_TRUE(copied.getEdge().props.empty());
+}
+
+TEST(Props, SharedByCopies) {
+    Tag tag("player", Props(PropLayout::intern({"name", "age"}), {"Tim", 30}));
+    Vertex vertex("100", {tag});
+    auto copied = vertex;
+    EXPECT_EQ(vertex, copied);
+    EXPECT_EQ(vertex.tags[0].props.layout(), copied.tags[0].props.layout());
+    EXPECT_EQ(Value("Tim"), copied.value("name"));
+    EXPECT_TRUE(copied.contains(Value("age")));
+}
+
+}   // namespace nebula
@@ -12,10 +12,14 @@
 
 #include "common/base/Base.h"
 #include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Set.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/Vertex.h"
 
 using nebula::Edge;
+using nebula::Map;
+using nebula::Set;
 using nebula::Value;
 using nebula::Vertex;
 
@@ -112,6 +116,81 @@ BENCHMARK(HashIntValue, n) {
     }
 }
 
+BENCHMARK_DRAW_LINE();
+
+static Value randomMap() {
+    Map map;
+    for (size_t i = 0; i < 8; i++) {
+        map.kvs.emplace(randomString(8), random(0, 1000));
+    }
+    return Value(std::move(map));
+}
+
+static Value randomSet() {
+    Set set;
+    for (size_t i = 0; i < 8; i++) {
+        set.values.emplace(randomString(8));
+    }
+    return Value(std::move(set));
+}
+
+// As the maps used to be deduplicated, by their strings
+BENCHMARK(HashMapString, n) {
+    std::vector<Value> values;
+    BENCHMARK_SUSPEND {
+        values.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            values.emplace_back(randomMap());
+        }
+    }
+    std::unordered_set<std::string> set;
+    for (const auto &value : values) {
+        set.emplace(value.toString());
+    }
+}
+
+BENCHMARK_RELATIVE(HashMapValue, n) {
+    std::vector<Value> values;
+    BENCHMARK_SUSPEND {
+        values.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            values.emplace_back(randomMap());
+        }
+    }
+    std::unordered_set<Value> set;
+    for (const auto &value : values) {
+        set.emplace(value);
+    }
+}
+
+BENCHMARK(HashSetString, n) {
+    std::vector<Value> values;
+    BENCHMARK_SUSPEND {
+        values.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            values.emplace_back(randomSet());
+        }
+    }
+    std::unordered_set<std::string> set;
+    for (const auto &value : values) {
+        set.emplace(value.toString());
+    }
+}
+
+BENCHMARK_RELATIVE(HashSetValue, n) {
+    std::vector<Value> values;
+    BENCHMARK_SUSPEND {
+        values.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            values.emplace_back(randomSet());
+        }
+    }
+    std::unordered_set<Value> set;
+    for (const auto &value : values) {
+        set.emplace(value);
+    }
+}
+
 int main() {
     folly::runBenchmarks();
     return 0;
@@ -16,6 +16,7 @@
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Path.h"
 #include "common/datatypes/DataSet.h"
+#include "common/datatypes/PackedRows.h"
 #include "common/datatypes/CommonCpp2Ops.h"
 
 namespace nebula {
@@ -1015,6 +1016,141 @@ TEST(Value, DecodeEncode) {
     }
 }
 
+TEST(Value, DecodeEncodePackedRows) {
+    DataSet ds({"_vid", "int", "float", "mixed", "edges"});
+    for (int64_t i = 0; i < 100; i++) {
+        List edges;
+        for (int64_t j = 0; j < i % 4; j++) {
+            edges.values.emplace_back(List({Value(j), Value("dst"), Value(j * 0.5)}));
+        }
+        Value mixed;
+        switch (i % 8) {
+            case 0: mixed = Value(NullType::DIV_BY_ZERO); break;
+            case 1: mixed = Value(i % 3 == 0); break;
+            case 2: mixed = Value(Date(2021, 1, i % 28 + 1)); break;
+            case 3: mixed = Value(Vertex({"Vid", {Tag("tag", {{"prop", Value(i)}})}})); break;
+            case 4: mixed = Value(DataSet({"col"})); break;
+            case 5: mixed = Value(List({Value(), Value(NullType::__NULL__)})); break;
+            case 6: mixed = Value(); break;
+            default: mixed = Value("str"); break;
+        }
+        ds.emplace_back(Row({Value(folly::to<std::string>(i)),
+                             Value(i % 2 == 0 ? std::numeric_limits<int64_t>::min() + i
+                                              : std::numeric_limits<int64_t>::max() - i),
+                             Value(i / 3.0),
+                             std::move(mixed),
+                             Value(std::move(edges))}));
+    }
+
+    std::string plain;
+    serializer::serialize(ds, &plain);
+    ds.packRows = true;
+    std::string packed;
+    serializer::serialize(ds, &packed);
+    EXPECT_LT(packed.size(), plain.size());
+
+    for (const auto &buf : {plain, packed}) {
+        DataSet copy;
+        copy.packRows = true;
+        ASSERT_EQ(buf.size(), serializer::deserialize(buf, copy));
+        // Passed on as the plain rows
+        EXPECT_FALSE(copy.packRows);
+        EXPECT_EQ(ds.colNames, copy.colNames);
+        ASSERT_EQ(ds.rowSize(), copy.rowSize());
+        for (size_t i = 0; i < ds.rowSize(); i++) {
+            ASSERT_EQ(ds.rows[i].size(), copy.rows[i].size());
+            for (size_t j = 0; j < ds.rows[i].size(); j++) {
+                const auto &expected = ds.rows[i].values[j];
+                const auto &actual = copy.rows[i].values[j];
+                EXPECT_EQ(expected.type(), actual.type());
+                EXPECT_EQ(expected, actual);
+                EXPECT_EQ(expected.toString(), actual.toString());
+            }
+        }
+    }
+
+    // Rows of different widths are written as they are
+    DataSet ragged;
+    ragged.rows = {Row({Value(1)}), Row({Value(1), Value(2)})};
+    ragged.packRows = true;
+    std::string buf;
+    serializer::serialize(ragged, &buf);
+    DataSet copy;
+    ASSERT_EQ(buf.size(), serializer::deserialize(buf, copy));
+    EXPECT_EQ(ragged.rows, copy.rows);
+
+    // Corrupted
+    std::string rows;
+    PackedRows::encode(ds.rows, rows);
+    std::vector<Row> decoded;
+    EXPECT_TRUE(PackedRows::decode(folly::StringPiece(rows), decoded).ok());
+    EXPECT_EQ(ds.rows, decoded);
+    for (auto size : {0UL, 1UL, 3UL, rows.size() / 2, rows.size() - 1}) {
+        EXPECT_FALSE(PackedRows::decode(folly::StringPiece(rows.data(), size), decoded).ok());
+    }
+    rows[0] = PackedRows::kVersion + 1;
+    EXPECT_FALSE(PackedRows::decode(folly::StringPiece(rows), decoded).ok());
+}
+
+TEST(Value, DecodeEncodePackedRowsDict) {
+    // The neighbors shared by the rows
+    DataSet ds({"_vid", "_dst"});
+    for (int64_t i = 0; i < 1000; i++) {
+        ds.emplace_back(Row({Value(folly::to<std::string>("player", i)),
+                             Value(List({Value(folly::to<std::string>("team", i % 10)),
+                                         Value(folly::to<std::string>("team", i % 7))}))}));
+    }
+    std::string packed;
+    PackedRows::encode(ds.rows, packed);
+    std::vector<Row> decoded;
+    ASSERT_TRUE(PackedRows::decode(folly::StringPiece(packed), decoded).ok());
+    EXPECT_EQ(ds.rows, decoded);
+
+    // Unique strings only
+    std::vector<Row> unique;
+    for (const auto &row : ds.rows) {
+        unique.emplace_back(Row({row.values[0]}));
+    }
+    std::string uniquePacked;
+    PackedRows::encode(unique, uniquePacked);
+    // The teams of a row are sent in fewer bytes than its own vid
+    EXPECT_LT(packed.size(), uniquePacked.size() * 2);
+
+    // The packed rows of version 1, without a dictionary
+    std::string v1("\x01\x01\x02\x05\x01\x03vid\x08\x01\x00", 12);
+    ASSERT_FALSE(PackedRows::decode(folly::StringPiece(v1), decoded).ok());
+    v1 = std::string("\x01\x01\x01\x05\x01\x03vid", 9);
+    ASSERT_TRUE(PackedRows::decode(folly::StringPiece(v1), decoded).ok());
+    EXPECT_EQ(std::vector<Row>({Row({Value("vid")})}), decoded);
+
+    // The code out of the dictionary
+    std::string bad("\x02\x01\x01\x01\x01" "a\x08\x01\x01", 9);
+    EXPECT_FALSE(PackedRows::decode(folly::StringPiece(bad), decoded).ok());
+    bad[8] = 0;
+    ASSERT_TRUE(PackedRows::decode(folly::StringPiece(bad), decoded).ok());
+    EXPECT_EQ(std::vector<Row>({Row({Value("a")})}), decoded);
+}
+
+TEST(Value, PackedRowsSizeBound) {
+    apache::thrift::CompactProtocolWriter proto;
+    std::vector<Row> rows;
+    std::string packed;
+    PackedRows::encode(rows, packed);
+    EXPECT_LE(packed.size(), PackedRows::encodedSize(&proto, rows));
+
+    // Of the repeated short strings among the other types, which split the blocks
+    for (int64_t i = 0; i < 1000; i++) {
+        rows.emplace_back(Row({i % 2 == 0 ? Value("") : Value(i),
+                               Value(folly::to<std::string>(i % 300)),
+                               Value(List({i % 3 == 0 ? Value::kNullValue : Value("x"),
+                                           Value(1.5)})),
+                               Value(Date(2021, 1, 1))}));
+    }
+    packed.clear();
+    PackedRows::encode(rows, packed);
+    EXPECT_LE(packed.size(), PackedRows::encodedSize(&proto, rows));
+}
+
 TEST(Value, Ctor) {
     Value vZero(0);
     EXPECT_TRUE(vZero.isInt());
@@ -1040,6 +1176,67 @@ TEST(Value, Ctor) {
     // Value v2(&tmp);
 }
 
+TEST(Value, Hash) {
+    std::hash<Value> hash;
+    // Of the same entries in another order
+    {
+        Map lhs, rhs;
+        for (int64_t i = 0; i < 100; i++) {
+            lhs.kvs.emplace(folly::to<std::string>("key", i), Value(i));
+            rhs.kvs.emplace(folly::to<std::string>("key", 99 - i), Value(99 - i));
+        }
+        rhs.kvs.reserve(1000);
+        ASSERT_EQ(Value(lhs), Value(rhs));
+        EXPECT_EQ(hash(Value(lhs)), hash(Value(rhs)));
+        rhs.kvs["key0"] = Value(1);
+        EXPECT_NE(hash(Value(lhs)), hash(Value(rhs)));
+        // The keys and the values are not interchangeable
+        EXPECT_NE(hash(Value(Map({{"a", "b"}, {"b", "a"}}))),
+                  hash(Value(Map({{"a", "a"}, {"b", "b"}}))));
+    }
+    {
+        Set lhs, rhs;
+        for (int64_t i = 0; i < 100; i++) {
+            lhs.values.emplace(i);
+            rhs.values.emplace(99 - i);
+        }
+        rhs.values.reserve(1000);
+        ASSERT_EQ(Value(lhs), Value(rhs));
+        EXPECT_EQ(hash(Value(lhs)), hash(Value(rhs)));
+        EXPECT_NE(hash(Value(Set({1, 2}))), hash(Value(Set({3, 4}))));
+        EXPECT_NE(hash(Value(Set({1, 2}))), hash(Value(Set({1, 2, 3}))));
+    }
+    {
+        DataSet lhs({"a", "b"});
+        lhs.emplace_back(Row({1, "x"}));
+        lhs.emplace_back(Row({2, "y"}));
+        DataSet rhs = lhs;
+        EXPECT_EQ(hash(Value(lhs)), hash(Value(rhs)));
+        std::swap(rhs.rows[0], rhs.rows[1]);
+        EXPECT_NE(hash(Value(lhs)), hash(Value(rhs)));
+        EXPECT_NE(hash(Value(lhs)), hash(Value(DataSet({"a", "b"}))));
+    }
+    // Deduplicated by the sets of values
+    {
+        std::unordered_set<Value> values;
+        for (int64_t i = 0; i < 100; i++) {
+            values.emplace(Map({{"k", Value(i % 10)}}));
+            values.emplace(Set({Value(i % 10)}));
+            values.emplace(List({Value(Map({{"k", Value(i % 10)}}))}));
+        }
+        EXPECT_EQ(30, values.size());
+    }
+    // Strings
+    {
+        std::unordered_set<size_t> hashes;
+        for (int64_t i = 0; i < 10000; i++) {
+            hashes.emplace(hash(Value(folly::to<std::string>(i))));
+        }
+        EXPECT_EQ(10000, hashes.size());
+        EXPECT_EQ(hash(Value("Hello")), hash(Value(std::string("Hello"))));
+    }
+}
+
 }  // namespace nebula
 
 
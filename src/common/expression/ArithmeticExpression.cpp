@@ -14,6 +14,17 @@ const Value& ArithmeticExpression::eval(ExpressionContext& ctx) {
     auto& lhs = lhs_->eval(ctx);
     auto& rhs = rhs_->eval(ctx);
 
+    if (specialized_ != Value::Type::__EMPTY__ &&
+        lhs.type() == specialized_ &&
+        rhs.type() == specialized_) {
+        if (specialized_ == Value::Type::INT) {
+            evalInt(lhs.getInt(), rhs.getInt());
+        } else {
+            evalFloat(lhs.getFloat(), rhs.getFloat());
+        }
+        return result_;
+    }
+
     switch (kind_) {
         case Kind::kAdd:
             result_ = lhs + rhs;
@@ -36,6 +47,57 @@ const Value& ArithmeticExpression::eval(ExpressionContext& ctx) {
     return result_;
 }
 
+void ArithmeticExpression::specialize(Value::Type type) {
+    specialized_ = Value::Type::__EMPTY__;
+    if (kind_ != Kind::kAdd && kind_ != Kind::kMinus && kind_ != Kind::kMultiply) {
+        return;
+    }
+    if (type == Value::Type::INT || type == Value::Type::FLOAT) {
+        specialized_ = type;
+    }
+}
+
+// The same as the generic operators of Value for two INTs
+void ArithmeticExpression::evalInt(int64_t lhs, int64_t rhs) {
+    int64_t res;
+    bool overflow = false;
+    switch (kind_) {
+        case Kind::kAdd:
+            overflow = __builtin_add_overflow(lhs, rhs, &res);
+            break;
+        case Kind::kMinus:
+            overflow = __builtin_sub_overflow(lhs, rhs, &res);
+            break;
+        case Kind::kMultiply:
+            overflow = __builtin_mul_overflow(lhs, rhs, &res);
+            break;
+        default:
+            LOG(FATAL) << "Unspecialized type: " << kind_;
+    }
+    if (overflow) {
+        result_ = Value::kNullOverflow;
+    } else {
+        result_.setInt(res);
+    }
+}
+
+// The same as the generic operators of Value for two FLOATs
+void ArithmeticExpression::evalFloat(double lhs, double rhs) {
+    switch (kind_) {
+        case Kind::kAdd:
+            result_.setFloat(lhs + rhs);
+            break;
+        case Kind::kMinus:
+            result_.setFloat(lhs - rhs);
+            break;
+        case Kind::kMultiply:
+            result_.setFloat(lhs * rhs);
+            break;
+        default:
+            LOG(FATAL) << "Unspecialized type: " << kind_;
+    }
+}
+
 std::string ArithmeticExpression::toString() const {
     std::string op;
     switch (kind_) {
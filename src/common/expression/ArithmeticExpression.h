@@ -62,20 +62,39 @@ public:
     std::string toString() const override;
 
     Expression* clone() const override {
-        return pool_->add(
+        auto* expr = pool_->add(
             new ArithmeticExpression(pool_, kind(), left()->clone(), right()->clone()));
+        expr->specialized_ = specialized_;
+        return expr;
     }
 
     bool isArithmeticExpr() const override {
         return true;
     }
 
+    /**
+     * To take a fast path when both operands are of `type', which is inferred statically,
+     * e.g. by InferTypeVisitor. The generic operators are still used whenever the actual
+     * types differ, e.g. for null. Only INT and FLOAT of +, - and * are specialized,
+     * otherwise it is a no-op.
+     */
+    void specialize(Value::Type type);
+
+    // The type specialized for, __EMPTY__ if none
+    Value::Type specializedType() const {
+        return specialized_;
+    }
+
 private:
     explicit ArithmeticExpression(ObjectPool* pool, Kind kind, Expression* lhs, Expression* rhs)
         : BinaryExpression(pool, kind, lhs, rhs) {}
 
+    void evalInt(int64_t lhs, int64_t rhs);
+    void evalFloat(double lhs, double rhs);
+
 private:
     Value result_;
+    Value::Type specialized_{Value::Type::__EMPTY__};
 };
 
 }   // namespace nebula
@@ -40,7 +40,7 @@ public:
         return rhs_;
     }
 
-    void setRight(Expression* expr) {
+    virtual void setRight(Expression* expr) {
         rhs_ = expr;
     }
 
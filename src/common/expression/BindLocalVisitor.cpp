@@ -0,0 +1,50 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/BindLocalVisitor.h"
+#include "common/expression/ListComprehensionExpression.h"
+#include "common/expression/PredicateExpression.h"
+#include "common/expression/ReduceExpression.h"
+#include "common/expression/VariableExpression.h"
+
+namespace nebula {
+
+void BindLocalVisitor::visit(VariableExpression *expr) {
+    if (expr->var() == var_) {
+        expr->bindLocal(slot_, owner_);
+        numBound_++;
+    }
+}
+
+void BindLocalVisitor::visit(PredicateExpression *expr) {
+    expr->collection()->accept(this);
+    if (expr->filter() != nullptr && expr->innerVar() != var_) {
+        expr->filter()->accept(this);
+    }
+}
+
+void BindLocalVisitor::visit(ListComprehensionExpression *expr) {
+    expr->collection()->accept(this);
+    if (expr->innerVar() == var_) {
+        return;
+    }
+    if (expr->filter() != nullptr) {
+        expr->filter()->accept(this);
+    }
+    if (expr->mapping() != nullptr) {
+        expr->mapping()->accept(this);
+    }
+}
+
+void BindLocalVisitor::visit(ReduceExpression *expr) {
+    expr->initial()->accept(this);
+    expr->collection()->accept(this);
+    if (expr->accumulator() != var_ && expr->innerVar() != var_) {
+        expr->mapping()->accept(this);
+    }
+}
+
+}   // namespace nebula
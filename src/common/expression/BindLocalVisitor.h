@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_BINDLOCALVISITOR_H_
+#define EXPRESSION_BINDLOCALVISITOR_H_
+
+#include "common/expression/ExprVisitorImpl.h"
+
+namespace nebula {
+
+/**
+ * To resolve the references to the local variable `var' in a tree to the local slot `slot'
+ * of ExpressionContext. The scopes of the nested iterations declaring the same name
+ * are skipped, since the variable is shadowed there.
+ */
+class BindLocalVisitor final : public ExprVisitorImpl {
+public:
+    BindLocalVisitor(const std::string& var, size_t slot, const void* owner)
+        : var_(var), slot_(slot), owner_(owner) {}
+
+    // Number of references resolved
+    size_t numBound() const {
+        return numBound_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(VariableExpression *expr) override;
+    void visit(PredicateExpression *expr) override;
+    void visit(ListComprehensionExpression *expr) override;
+    void visit(ReduceExpression *expr) override;
+
+private:
+    const std::string&                      var_;
+    size_t                                  slot_;
+    const void*                             owner_;
+    size_t                                  numBound_{0};
+};
+
+}   // namespace nebula
+
+#endif  // EXPRESSION_BINDLOCALVISITOR_H_
@@ -0,0 +1,55 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/BindSlotVisitor.h"
+#include "common/expression/PropertyExpression.h"
+
+namespace nebula {
+
+void BindSlotVisitor::bind(PropertyExpression *expr) {
+    expr->bindSlot(ctx_);
+    if (expr->slot() != ExpressionContext::kNoSlot) {
+        numBound_++;
+    }
+}
+
+void BindSlotVisitor::visit(TagPropertyExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(EdgePropertyExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(InputPropertyExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(DestPropertyExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(SourcePropertyExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(EdgeSrcIdExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(EdgeTypeExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(EdgeRankExpression *expr) {
+    bind(expr);
+}
+
+void BindSlotVisitor::visit(EdgeDstIdExpression *expr) {
+    bind(expr);
+}
+
+}   // namespace nebula
@@ -0,0 +1,50 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_BINDSLOTVISITOR_H_
+#define EXPRESSION_BINDSLOTVISITOR_H_
+
+#include "common/expression/ExprVisitorImpl.h"
+#include "common/context/ExpressionContext.h"
+
+namespace nebula {
+
+class PropertyExpression;
+
+/**
+ * To resolve all the property expressions of a tree to the slots of `ctx',
+ * before evaluating it against a lot of rows of the same context.
+ */
+class BindSlotVisitor final : public ExprVisitorImpl {
+public:
+    explicit BindSlotVisitor(const ExpressionContext& ctx) : ctx_(ctx) {}
+
+    // Number of properties resolved to a slot
+    size_t numBound() const {
+        return numBound_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(TagPropertyExpression *expr) override;
+    void visit(EdgePropertyExpression *expr) override;
+    void visit(InputPropertyExpression *expr) override;
+    void visit(DestPropertyExpression *expr) override;
+    void visit(SourcePropertyExpression *expr) override;
+    void visit(EdgeSrcIdExpression *expr) override;
+    void visit(EdgeTypeExpression *expr) override;
+    void visit(EdgeRankExpression *expr) override;
+    void visit(EdgeDstIdExpression *expr) override;
+
+private:
+    void bind(PropertyExpression *expr);
+
+    const ExpressionContext&                ctx_;
+    size_t                                  numBound_{0};
+};
+
+}   // namespace nebula
+
+#endif  // EXPRESSION_BINDSLOTVISITOR_H_
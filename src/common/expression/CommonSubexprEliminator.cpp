@@ -0,0 +1,406 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/CommonSubexprEliminator.h"
+#include "common/expression/AggregateExpression.h"
+#include "common/expression/BinaryExpression.h"
+#include "common/expression/CaseExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/ContainerExpression.h"
+#include "common/expression/ExprVisitorImpl.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/TypeCastingExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "common/expression/VariableExpression.h"
+
+namespace nebula {
+
+namespace {
+
+// To tell whether a tree contains anything giving different results for the same row
+class ImpureVisitor final : public ExprVisitorImpl {
+public:
+    bool found() const {
+        return found_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(UUIDExpression*) override {
+        found_ = true;
+    }
+
+    void visit(AggregateExpression*) override {
+        found_ = true;
+    }
+
+    void visit(FunctionCallExpression *expr) override {
+        if (!expr->isPure()) {
+            found_ = true;
+            return;
+        }
+        ExprVisitorImpl::visit(expr);
+    }
+
+private:
+    bool                                    found_{false};
+};
+
+// To collect the hoisted subtrees which a tree refers to
+class RefVisitor final : public ExprVisitorImpl {
+public:
+    explicit RefVisitor(const std::unordered_map<const Expression*, size_t> &refs)
+        : refs_(refs) {}
+
+    const std::vector<size_t>& found() const {
+        return found_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(VariableExpression *expr) override {
+        auto it = refs_.find(expr);
+        if (it != refs_.end()) {
+            found_.emplace_back(it->second);
+        }
+    }
+
+private:
+    const std::unordered_map<const Expression*, size_t>    &refs_;
+    std::vector<size_t>                                     found_;
+};
+
+// To collect the constants of a tree in the order visited
+class ConstantVisitor final : public ExprVisitorImpl {
+public:
+    const std::vector<const Value*>& found() const {
+        return found_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(ConstantExpression *expr) override {
+        found_.emplace_back(&expr->value());
+    }
+
+private:
+    std::vector<const Value*>               found_;
+};
+
+// Unlike operator==, neither 2 and 2.0 nor floats within epsilon are the same
+bool isSameConstant(const Value &lhs, const Value &rhs) {
+    if (lhs.type() != rhs.type()) {
+        return false;
+    }
+    switch (lhs.type()) {
+        case Value::Type::FLOAT: {
+            return std::memcmp(&lhs.getFloat(), &rhs.getFloat(), sizeof(double)) == 0;
+        }
+        case Value::Type::NULLVALUE: {
+            return lhs.getNull() == rhs.getNull();
+        }
+        default: {
+            return lhs == rhs;
+        }
+    }
+}
+
+// Whether the trees are equal by operator==, and their constants strictly the same
+bool isSameTree(Expression *lhs, Expression *rhs) {
+    if (*lhs != *rhs) {
+        return false;
+    }
+    ConstantVisitor lhsVisitor, rhsVisitor;
+    lhs->accept(&lhsVisitor);
+    rhs->accept(&rhsVisitor);
+    const auto &lhsConstants = lhsVisitor.found();
+    const auto &rhsConstants = rhsVisitor.found();
+    return lhsConstants.size() == rhsConstants.size() &&
+           std::equal(lhsConstants.begin(), lhsConstants.end(), rhsConstants.begin(),
+                      [] (const auto *l, const auto *r) { return isSameConstant(*l, *r); });
+}
+
+bool isCandidate(Expression *expr) {
+    switch (expr->kind()) {
+        case Expression::Kind::kConstant:
+        case Expression::Kind::kVar:
+        case Expression::Kind::kVersionedVar:
+        case Expression::Kind::kLabel:
+        case Expression::Kind::kAggregate:
+        case Expression::Kind::kUUID:
+            return false;
+        default:
+            break;
+    }
+    ImpureVisitor visitor;
+    expr->accept(&visitor);
+    return !visitor.found();
+}
+
+}   // namespace
+
+/**
+ * Each round counts the occurrences of the candidates in the expressions and
+ * the hoisted subtrees, and then replaces, outermost first, those occurring more
+ * than once. A hoisted subtree is kept where it is first met, while its children
+ * are left to the next round.
+ */
+class EliminateVisitor final : public ExprVisitorImpl {
+public:
+    explicit EliminateVisitor(CommonSubexprEliminator *cse) : cse_(cse) {}
+
+    // @return  whether anything is replaced
+    bool round(std::vector<Expression*> &exprs) {
+        classes_.clear();
+        keys_.clear();
+        classOf_.clear();
+        numReplaced_ = 0;
+        auto &hoisted = cse_->hoisted_;
+        auto numHoisted = hoisted.size();
+
+        counting_ = true;
+        for (auto *expr : exprs) {
+            visitChild(expr);
+        }
+        for (auto i = 0UL; i < numHoisted; i++) {
+            visitChild(hoisted[i].expr);
+            classes_[classOf_.at(hoisted[i].expr)].hoisted = i;
+        }
+
+        counting_ = false;
+        for (auto &expr : exprs) {
+            expr = visitChild(expr);
+        }
+        // Not the subtrees hoisted by this round, whose children have not been counted
+        for (auto i = 0UL; i < numHoisted; i++) {
+            hoisted[i].expr->accept(this);
+        }
+        return numReplaced_ > 0;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(UnaryExpression *expr) override;
+    void visit(TypeCastingExpression *expr) override;
+    void visit(LogicalExpression *expr) override;
+    void visit(FunctionCallExpression *expr) override;
+    void visit(AggregateExpression *expr) override;
+    void visit(ListExpression *expr) override;
+    void visit(SetExpression *expr) override;
+    void visit(MapExpression *expr) override;
+    void visit(CaseExpression *expr) override;
+    // Variables declared within them might be referred to
+    void visit(PredicateExpression*) override {}
+    void visit(ListComprehensionExpression*) override {}
+    void visit(ReduceExpression*) override {}
+
+private:
+    // Subtrees equal to each other
+    struct Class {
+        Expression                         *expr{nullptr};
+        size_t                              count{0};
+        // Index of the hoisted one, or -1
+        int64_t                             hoisted{-1};
+    };
+
+    void visitBinaryExpr(BinaryExpression *expr) override;
+
+    // To visit `expr' and return its replacement, or itself
+    Expression* visitChild(Expression *expr);
+
+    size_t classOf(Expression *expr);
+
+    Expression* makeRef(size_t hoisted);
+
+    CommonSubexprEliminator                                *cse_{nullptr};
+    bool                                                    counting_{true};
+    std::vector<Class>                                      classes_;
+    // From the text of each class to its index, to be confirmed by isSameTree
+    std::unordered_map<std::string, std::vector<size_t>>    keys_;
+    std::unordered_map<const Expression*, size_t>           classOf_;
+    size_t                                                  numReplaced_{0};
+};
+
+size_t EliminateVisitor::classOf(Expression *expr) {
+    auto &candidates = keys_[expr->toString()];
+    for (auto i : candidates) {
+        if (isSameTree(classes_[i].expr, expr)) {
+            return i;
+        }
+    }
+    candidates.emplace_back(classes_.size());
+    classes_.emplace_back();
+    classes_.back().expr = expr;
+    return classes_.size() - 1;
+}
+
+Expression* EliminateVisitor::makeRef(size_t hoisted) {
+    auto *ref = VariableExpression::make(
+        cse_->pool_, folly::stringPrintf("__cse_%lu", hoisted), true);
+    ref->bindLocal(cse_->boundBase_ + hoisted, cse_);
+    cse_->hoisted_[hoisted].refs.emplace_back(ref);
+    numReplaced_++;
+    return ref;
+}
+
+Expression* EliminateVisitor::visitChild(Expression *expr) {
+    if (counting_) {
+        expr->accept(this);
+        if (isCandidate(expr)) {
+            auto i = classOf(expr);
+            classes_[i].count++;
+            classOf_.emplace(expr, i);
+        }
+        return expr;
+    }
+
+    auto found = classOf_.find(expr);
+    if (found != classOf_.end() && classes_[found->second].count > 1) {
+        auto &cls = classes_[found->second];
+        if (cls.hoisted < 0) {
+            cls.hoisted = cse_->hoisted_.size();
+            cse_->hoisted_.emplace_back();
+            cse_->hoisted_.back().expr = expr;
+        }
+        return makeRef(cls.hoisted);
+    }
+    expr->accept(this);
+    return expr;
+}
+
+void EliminateVisitor::visit(UnaryExpression *expr) {
+    expr->setOperand(visitChild(expr->operand()));
+}
+
+void EliminateVisitor::visit(TypeCastingExpression *expr) {
+    expr->setOperand(visitChild(expr->operand()));
+}
+
+void EliminateVisitor::visit(LogicalExpression *expr) {
+    auto &operands = expr->operands();
+    for (auto i = 0UL; i < operands.size(); i++) {
+        expr->setOperand(i, visitChild(operands[i]));
+    }
+}
+
+void EliminateVisitor::visit(FunctionCallExpression *expr) {
+    auto *args = expr->args();
+    for (auto i = 0UL; i < args->numArgs(); i++) {
+        args->setArg(i, visitChild(args->args()[i]));
+    }
+}
+
+void EliminateVisitor::visit(AggregateExpression *expr) {
+    if (expr->arg() != nullptr) {
+        expr->setArg(visitChild(expr->arg()));
+    }
+}
+
+void EliminateVisitor::visit(ListExpression *expr) {
+    auto &items = expr->items();
+    for (auto i = 0UL; i < items.size(); i++) {
+        expr->setItem(i, visitChild(items[i]));
+    }
+}
+
+void EliminateVisitor::visit(SetExpression *expr) {
+    auto &items = expr->items();
+    for (auto i = 0UL; i < items.size(); i++) {
+        expr->setItem(i, visitChild(items[i]));
+    }
+}
+
+void EliminateVisitor::visit(MapExpression *expr) {
+    auto &items = expr->items();
+    for (auto i = 0UL; i < items.size(); i++) {
+        expr->setItem(i, std::make_pair(items[i].first, visitChild(items[i].second)));
+    }
+}
+
+void EliminateVisitor::visit(CaseExpression *expr) {
+    if (expr->hasCondition()) {
+        expr->setCondition(visitChild(expr->condition()));
+    }
+    auto &cases = expr->cases();
+    for (auto i = 0UL; i < cases.size(); i++) {
+        expr->setWhen(i, visitChild(cases[i].when));
+        expr->setThen(i, visitChild(cases[i].then));
+    }
+    if (expr->hasDefault()) {
+        expr->setDefault(visitChild(expr->defaultResult()));
+    }
+}
+
+void EliminateVisitor::visitBinaryExpr(BinaryExpression *expr) {
+    expr->setLeft(visitChild(expr->left()));
+    expr->setRight(visitChild(expr->right()));
+}
+
+size_t CommonSubexprEliminator::eliminate(std::vector<Expression*> &exprs) {
+    DCHECK(hoisted_.empty());
+    EliminateVisitor visitor(this);
+    while (visitor.round(exprs)) {
+    }
+    sortHoisted();
+    return hoisted_.size();
+}
+
+std::vector<const Expression*> CommonSubexprEliminator::hoisted() const {
+    std::vector<const Expression*> result;
+    result.reserve(order_.size());
+    for (auto i : order_) {
+        result.emplace_back(hoisted_[i].expr);
+    }
+    return result;
+}
+
+void CommonSubexprEliminator::sortHoisted() {
+    std::unordered_map<const Expression*, size_t> refs;
+    for (auto i = 0UL; i < hoisted_.size(); i++) {
+        for (auto *ref : hoisted_[i].refs) {
+            refs.emplace(ref, i);
+        }
+    }
+    std::vector<std::vector<size_t>> deps;
+    deps.reserve(hoisted_.size());
+    for (auto &hoisted : hoisted_) {
+        RefVisitor visitor(refs);
+        hoisted.expr->accept(&visitor);
+        deps.emplace_back(visitor.found());
+    }
+
+    // Depth first, the references form no cycle
+    order_.clear();
+    order_.reserve(hoisted_.size());
+    std::vector<bool> visited(hoisted_.size(), false);
+    std::function<void(size_t)> visit = [&] (size_t i) {
+        if (visited[i]) {
+            return;
+        }
+        visited[i] = true;
+        for (auto dep : deps[i]) {
+            visit(dep);
+        }
+        order_.emplace_back(i);
+    };
+    for (auto i = 0UL; i < hoisted_.size(); i++) {
+        visit(i);
+    }
+}
+
+void CommonSubexprEliminator::bindRow(ExpressionContext &ctx, size_t base) {
+    if (base != boundBase_) {
+        for (auto i = 0UL; i < hoisted_.size(); i++) {
+            for (auto *ref : hoisted_[i].refs) {
+                ref->bindLocal(base + i, this);
+            }
+        }
+        boundBase_ = base;
+    }
+    // Each one is evaluated at most once per row, so its result stays until the next row
+    for (auto i = 0UL; i < hoisted_.size(); i++) {
+        ctx.bindLocalLazily(base + i, hoisted_[i].expr);
+    }
+}
+
+}   // namespace nebula
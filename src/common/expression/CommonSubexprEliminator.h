@@ -0,0 +1,105 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_COMMONSUBEXPRELIMINATOR_H_
+#define EXPRESSION_COMMONSUBEXPRELIMINATOR_H_
+
+#include "common/base/Base.h"
+#include "common/context/ExpressionContext.h"
+
+namespace nebula {
+
+class Expression;
+class ObjectPool;
+class VariableExpression;
+
+/**
+ * To evaluate the subtrees shared by the expressions over the same rows,
+ * e.g. a filter and the columns of a projection, once per row.
+ *
+ * The subtrees equal by Expression::operator== are hoisted out, and each of
+ * their occurrences is replaced in place with a variable bound to a local slot
+ * of ExpressionContext, which refers to the result of the hoisted one.
+ * Since the replacement is outermost first and repeated until nothing is shared,
+ * a hoisted subtree could refer to the other ones as well.
+ *
+ * A hoisted subtree is evaluated when it is first read in a row, so that those only
+ * in the branches not taken, e.g. guarded by CASE or AND, are never evaluated.
+ *
+ * The subtrees are looked for where FoldConstantCallVisitor folds calls.
+ * Those containing impure calls, aggregations or uuid() are never hoisted,
+ * neither are those within list comprehension, predicate and reduce
+ * expressions, which might refer to the variables declared there.
+ *
+ *  CommonSubexprEliminator cse(pool);
+ *  cse.eliminate(exprs);
+ *  for each row {
+ *      CommonSubexprEliminator::Row row(cse, ctx);
+ *      // evaluate `exprs'
+ *  }
+ *
+ * The rewritten expressions evaluated without a Row read the variables by name,
+ * which are null.
+ */
+class CommonSubexprEliminator final {
+public:
+    /**
+     * The frame of the local slots for the hoisted subtrees, which are evaluated
+     * against the current row of `ctx' on the first read. It should be destructed
+     * after the evaluation of the rewritten expressions.
+     */
+    class Row final {
+    public:
+        Row(CommonSubexprEliminator& cse, ExpressionContext& ctx)
+            : frame_(ctx, cse.numHoisted(), &cse) {
+            cse.bindRow(ctx, frame_.base());
+        }
+
+    private:
+        ExpressionContext::LocalFrame   frame_;
+    };
+
+    explicit CommonSubexprEliminator(ObjectPool *pool) : pool_(pool) {}
+
+    /**
+     * To hoist the subtrees shared by `exprs', which are rewritten in place.
+     * It could be called only once.
+     * @return  the number of subtrees hoisted
+     */
+    size_t eliminate(std::vector<Expression*> &exprs);
+
+    size_t numHoisted() const {
+        return hoisted_.size();
+    }
+
+    // The hoisted subtrees, each of which follows those it refers to
+    std::vector<const Expression*> hoisted() const;
+
+private:
+    friend class EliminateVisitor;
+
+    struct Hoisted {
+        Expression                         *expr{nullptr};
+        // The variables replacing the occurrences
+        std::vector<VariableExpression*>    refs;
+    };
+
+    void bindRow(ExpressionContext &ctx, size_t base);
+
+    // To sort the hoisted subtrees, so that each one follows those it refers to
+    void sortHoisted();
+
+    ObjectPool                             *pool_{nullptr};
+    std::vector<Hoisted>                    hoisted_;
+    // Indexes of `hoisted_', each of which follows those it refers to
+    std::vector<size_t>                     order_;
+    // Base of the slots which the variables are bound to
+    size_t                                  boundBase_{0};
+};
+
+}   // namespace nebula
+
+#endif  // EXPRESSION_COMMONSUBEXPRELIMINATOR_H_
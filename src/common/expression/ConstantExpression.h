@@ -37,6 +37,12 @@ public:
 
     void setValue(Value val) {
         val_ = std::move(val);
+        version_++;
+    }
+
+    // Bumped by setValue(), for those prepared by the value to tell whether it is changed
+    uint32_t version() const {
+        return version_;
     }
 
     void accept(ExprVisitor* visitor) override;
@@ -56,6 +62,7 @@ private:
 
 private:
     Value val_;
+    uint32_t version_{0};
 };
 
 }   // namespace nebula
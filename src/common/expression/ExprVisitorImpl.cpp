@@ -0,0 +1,128 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/ExprVisitorImpl.h"
+
+namespace nebula {
+
+void ExprVisitorImpl::visit(UnaryExpression *expr) {
+    expr->operand()->accept(this);
+}
+
+void ExprVisitorImpl::visit(TypeCastingExpression *expr) {
+    expr->operand()->accept(this);
+}
+
+void ExprVisitorImpl::visit(ArithmeticExpression *expr) {
+    visitBinaryExpr(expr);
+}
+
+void ExprVisitorImpl::visit(RelationalExpression *expr) {
+    visitBinaryExpr(expr);
+}
+
+void ExprVisitorImpl::visit(SubscriptExpression *expr) {
+    visitBinaryExpr(expr);
+}
+
+void ExprVisitorImpl::visit(AttributeExpression *expr) {
+    visitBinaryExpr(expr);
+}
+
+void ExprVisitorImpl::visit(LogicalExpression *expr) {
+    for (auto *operand : expr->operands()) {
+        operand->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(FunctionCallExpression *expr) {
+    for (auto *arg : expr->args()->args()) {
+        arg->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(AggregateExpression *expr) {
+    if (expr->arg() != nullptr) {
+        expr->arg()->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(ListExpression *expr) {
+    for (auto *item : expr->items()) {
+        item->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(SetExpression *expr) {
+    for (auto *item : expr->items()) {
+        item->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(MapExpression *expr) {
+    for (auto &item : expr->items()) {
+        item.second->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(CaseExpression *expr) {
+    if (expr->condition() != nullptr) {
+        expr->condition()->accept(this);
+    }
+    for (auto &whenThen : expr->cases()) {
+        whenThen.when->accept(this);
+        whenThen.then->accept(this);
+    }
+    if (expr->defaultResult() != nullptr) {
+        expr->defaultResult()->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(PathBuildExpression *expr) {
+    for (auto *item : expr->items()) {
+        item->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(PredicateExpression *expr) {
+    expr->collection()->accept(this);
+    if (expr->filter() != nullptr) {
+        expr->filter()->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(ListComprehensionExpression *expr) {
+    expr->collection()->accept(this);
+    if (expr->filter() != nullptr) {
+        expr->filter()->accept(this);
+    }
+    if (expr->mapping() != nullptr) {
+        expr->mapping()->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visit(ReduceExpression *expr) {
+    expr->initial()->accept(this);
+    expr->collection()->accept(this);
+    expr->mapping()->accept(this);
+}
+
+void ExprVisitorImpl::visit(SubscriptRangeExpression *expr) {
+    expr->list()->accept(this);
+    if (expr->lo() != nullptr) {
+        expr->lo()->accept(this);
+    }
+    if (expr->hi() != nullptr) {
+        expr->hi()->accept(this);
+    }
+}
+
+void ExprVisitorImpl::visitBinaryExpr(BinaryExpression *expr) {
+    expr->left()->accept(this);
+    expr->right()->accept(this);
+}
+
+}   // namespace nebula
@@ -0,0 +1,74 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_EXPRVISITORIMPL_H_
+#define EXPRESSION_EXPRVISITORIMPL_H_
+
+#include "common/expression/ExprVisitor.h"
+
+namespace nebula {
+
+/**
+ * A visitor which walks through the whole expression tree and does nothing on the leaves.
+ * Passes over expressions derive from it and override only the kinds they care about.
+ */
+class ExprVisitorImpl : public ExprVisitor {
+public:
+    // leaf expression nodes
+    void visit(ConstantExpression *) override {}
+    void visit(LabelExpression *) override {}
+    void visit(UUIDExpression *) override {}
+    void visit(VariableExpression *) override {}
+    void visit(VersionedVariableExpression *) override {}
+    void visit(TagPropertyExpression *) override {}
+    void visit(EdgePropertyExpression *) override {}
+    void visit(InputPropertyExpression *) override {}
+    void visit(VariablePropertyExpression *) override {}
+    void visit(DestPropertyExpression *) override {}
+    void visit(SourcePropertyExpression *) override {}
+    void visit(EdgeSrcIdExpression *) override {}
+    void visit(EdgeTypeExpression *) override {}
+    void visit(EdgeRankExpression *) override {}
+    void visit(EdgeDstIdExpression *) override {}
+    void visit(VertexExpression *) override {}
+    void visit(EdgeExpression *) override {}
+    void visit(ColumnExpression *) override {}
+    void visit(LabelAttributeExpression *) override {}
+
+    // unary expression
+    void visit(UnaryExpression *expr) override;
+    void visit(TypeCastingExpression *expr) override;
+
+    // binary expression
+    void visit(ArithmeticExpression *expr) override;
+    void visit(RelationalExpression *expr) override;
+    void visit(SubscriptExpression *expr) override;
+    void visit(AttributeExpression *expr) override;
+    void visit(LogicalExpression *expr) override;
+
+    // function call
+    void visit(FunctionCallExpression *expr) override;
+    void visit(AggregateExpression *expr) override;
+
+    // container expression
+    void visit(ListExpression *expr) override;
+    void visit(SetExpression *expr) override;
+    void visit(MapExpression *expr) override;
+
+    void visit(CaseExpression *expr) override;
+    void visit(PathBuildExpression *expr) override;
+    void visit(PredicateExpression *expr) override;
+    void visit(ListComprehensionExpression *expr) override;
+    void visit(ReduceExpression *expr) override;
+    void visit(SubscriptRangeExpression *expr) override;
+
+protected:
+    virtual void visitBinaryExpr(BinaryExpression *expr);
+};
+
+}   // namespace nebula
+
+#endif   // EXPRESSION_EXPRVISITORIMPL_H_
@@ -34,17 +34,41 @@
 #include "common/expression/PredicateExpression.h"
 #include "common/expression/ReduceExpression.h"
 
+DEFINE_bool(expression_encode_v2, false,
+            "Whether to send the expressions in the compact format V2, "
+            "set only if all the services in the cluster decode it");
+
 namespace nebula {
 
 using serializer = apache::thrift::CompactSerializer;
 
+namespace {
+
+// Tags of the values in V2, the scalar ones are written inline
+enum class ValueTag : uint8_t {
+    kEmpty      = 0,
+    kNull       = 1,
+    kFalse      = 2,
+    kTrue       = 3,
+    kInt        = 4,
+    kFloat      = 5,
+    kString     = 6,
+    kSerialized = 7,
+};
+
+}   // namespace
+
 /****************************************
  *
  *  class Expression::Encoder
  *
  ***************************************/
-Expression::Encoder::Encoder(size_t bufSizeHint) {
+Expression::Encoder::Encoder(size_t bufSizeHint, Format format) : format_(format) {
     buf_.reserve(bufSizeHint);
+    if (format_ != Format::kV1) {
+        buf_.append(1, static_cast<char>(kFormatMarker));
+        buf_.append(1, static_cast<char>(format_));
+    }
 }
 
 
@@ -53,6 +77,13 @@ std::string Expression::Encoder::moveStr() {
 }
 
 
+void Expression::Encoder::writeVarint(uint64_t val) {
+    uint8_t buf[folly::kMaxVarintLength64];
+    auto len = folly::encodeVarint(val, buf);
+    buf_.append(reinterpret_cast<const char*>(buf), len);
+}
+
+
 Expression::Encoder& Expression::Encoder::operator<<(Kind kind) noexcept {
     buf_.append(reinterpret_cast<const char*>(&kind), sizeof(uint8_t));
     return *this;
@@ -60,29 +91,89 @@ Expression::Encoder& Expression::Encoder::operator<<(Kind kind) noexcept {
 
 
 Expression::Encoder& Expression::Encoder::operator<<(const std::string& str) noexcept {
-    size_t sz = str.size();
-    buf_.append(reinterpret_cast<char*>(&sz), sizeof(size_t));
-    if (sz > 0) {
-        buf_.append(str.data(), sz);
+    if (format_ == Format::kV1) {
+        size_t sz = str.size();
+        buf_.append(reinterpret_cast<char*>(&sz), sizeof(size_t));
+        if (sz > 0) {
+            buf_.append(str.data(), sz);
+        }
+        return *this;
     }
+    // 0 followed by the string for the first occurrence, otherwise its index plus 1
+    auto iter = strings_.find(str);
+    if (iter != strings_.end()) {
+        writeVarint(iter->second + 1);
+        return *this;
+    }
+    strings_.emplace(str, strings_.size());
+    writeVarint(0);
+    writeVarint(str.size());
+    buf_.append(str.data(), str.size());
     return *this;
 }
 
 
 Expression::Encoder& Expression::Encoder::operator<<(const Value& val) noexcept {
-    serializer::serialize(val, &buf_);
+    if (format_ == Format::kV1) {
+        serializer::serialize(val, &buf_);
+        return *this;
+    }
+    switch (val.type()) {
+        case Value::Type::__EMPTY__: {
+            buf_.append(1, static_cast<char>(ValueTag::kEmpty));
+            break;
+        }
+        case Value::Type::NULLVALUE: {
+            buf_.append(1, static_cast<char>(ValueTag::kNull));
+            writeVarint(static_cast<uint64_t>(val.getNull()));
+            break;
+        }
+        case Value::Type::BOOL: {
+            buf_.append(1, static_cast<char>(val.getBool() ? ValueTag::kTrue : ValueTag::kFalse));
+            break;
+        }
+        case Value::Type::INT: {
+            buf_.append(1, static_cast<char>(ValueTag::kInt));
+            writeVarint(folly::encodeZigZag(val.getInt()));
+            break;
+        }
+        case Value::Type::FLOAT: {
+            buf_.append(1, static_cast<char>(ValueTag::kFloat));
+            auto fVal = val.getFloat();
+            buf_.append(reinterpret_cast<const char*>(&fVal), sizeof(double));
+            break;
+        }
+        case Value::Type::STRING: {
+            buf_.append(1, static_cast<char>(ValueTag::kString));
+            *this << val.getStr();
+            break;
+        }
+        default: {
+            buf_.append(1, static_cast<char>(ValueTag::kSerialized));
+            serializer::serialize(val, &buf_);
+            break;
+        }
+    }
     return *this;
 }
 
 
 Expression::Encoder& Expression::Encoder::operator<<(size_t size) noexcept {
-    buf_.append(reinterpret_cast<char*>(&size), sizeof(size_t));
+    if (format_ == Format::kV1) {
+        buf_.append(reinterpret_cast<char*>(&size), sizeof(size_t));
+    } else {
+        writeVarint(size);
+    }
     return *this;
 }
 
 
 Expression::Encoder& Expression::Encoder::operator<<(Value::Type vType) noexcept {
-    buf_.append(reinterpret_cast<char*>(&vType), sizeof(Value::Type));
+    if (format_ == Format::kV1) {
+        buf_.append(reinterpret_cast<char*>(&vType), sizeof(Value::Type));
+    } else {
+        writeVarint(static_cast<uint64_t>(vType));
+    }
     return *this;
 }
 
@@ -100,7 +191,22 @@ Expression::Encoder& Expression::Encoder::operator<<(const Expression& exp) noex
  ***************************************/
 Expression::Decoder::Decoder(folly::StringPiece encoded)
     : encoded_(encoded)
-    , ptr_(encoded_.begin()) {}
+    , ptr_(encoded_.begin()) {
+    if (!encoded_.empty() && static_cast<uint8_t>(encoded_.front()) == kFormatMarker) {
+        if (encoded_.size() < 2 ||
+            static_cast<uint8_t>(encoded_[1]) != static_cast<uint8_t>(Format::kV2)) {
+            ok_ = false;
+            return;
+        }
+        format_ = Format::kV2;
+        ptr_ += 2;
+    }
+}
+
+
+bool Expression::Decoder::ok() const {
+    return ok_;
+}
 
 
 bool Expression::Decoder::finished() const {
@@ -113,6 +219,16 @@ std::string Expression::Decoder::getHexStr() const {
 }
 
 
+uint64_t Expression::Decoder::readVarint() noexcept {
+    folly::ByteRange range(reinterpret_cast<const uint8_t*>(ptr_),
+                           reinterpret_cast<const uint8_t*>(encoded_.end()));
+    auto result = folly::tryDecodeVarint(range);
+    CHECK(result.hasValue()) << "Malformed varint: " << getHexStr();
+    ptr_ = reinterpret_cast<const char*>(range.begin());
+    return result.value();
+}
+
+
 Expression::Kind Expression::Decoder::readKind() noexcept {
     CHECK_LE(ptr_ + sizeof(uint8_t), encoded_.end());
 
@@ -125,6 +241,19 @@ Expression::Kind Expression::Decoder::readKind() noexcept {
 
 
 std::string Expression::Decoder::readStr() noexcept {
+    if (format_ == Format::kV2) {
+        auto index = readVarint();
+        if (index > 0) {
+            CHECK_LE(index, strings_.size());
+            return strings_[index - 1].str();
+        }
+        auto sz = readVarint();
+        CHECK_LE(sz, static_cast<size_t>(encoded_.end() - ptr_));
+        strings_.emplace_back(ptr_, sz);
+        ptr_ += sz;
+        return strings_.back().str();
+    }
+
     CHECK_LE(ptr_ + sizeof(size_t), encoded_.end());
 
     size_t sz = 0;
@@ -143,6 +272,45 @@ std::string Expression::Decoder::readStr() noexcept {
 
 
 Value Expression::Decoder::readValue() noexcept {
+    if (format_ == Format::kV2) {
+        CHECK_LT(ptr_, encoded_.end());
+        auto tag = static_cast<ValueTag>(static_cast<uint8_t>(*ptr_++));
+        switch (tag) {
+            case ValueTag::kEmpty: {
+                return Value();
+            }
+            case ValueTag::kNull: {
+                return Value(static_cast<NullType>(readVarint()));
+            }
+            case ValueTag::kFalse: {
+                return Value(false);
+            }
+            case ValueTag::kTrue: {
+                return Value(true);
+            }
+            case ValueTag::kInt: {
+                return Value(folly::decodeZigZag(readVarint()));
+            }
+            case ValueTag::kFloat: {
+                CHECK_LE(ptr_ + sizeof(double), encoded_.end());
+                double fVal;
+                memcpy(reinterpret_cast<void*>(&fVal), ptr_, sizeof(double));
+                ptr_ += sizeof(double);
+                return Value(fVal);
+            }
+            case ValueTag::kString: {
+                return Value(readStr());
+            }
+            case ValueTag::kSerialized: {
+                break;
+            }
+            default: {
+                LOG(FATAL) << "Unknown value tag " << static_cast<int>(tag)
+                           << ": " << getHexStr();
+            }
+        }
+    }
+
     Value val;
     size_t len = serializer::deserialize(folly::StringPiece(ptr_, encoded_.end()), val);
     ptr_ += len;
@@ -151,6 +319,9 @@ Value Expression::Decoder::readValue() noexcept {
 
 
 size_t Expression::Decoder::readSize() noexcept {
+    if (format_ == Format::kV2) {
+        return readVarint();
+    }
     size_t sz = 0;
     memcpy(reinterpret_cast<void*>(&sz), ptr_, sizeof(size_t));
     ptr_ += sizeof(size_t);
@@ -159,6 +330,9 @@ size_t Expression::Decoder::readSize() noexcept {
 
 
 Value::Type Expression::Decoder::readValueType() noexcept {
+    if (format_ == Format::kV2) {
+        return static_cast<Value::Type>(readVarint());
+    }
     Value::Type type;
     memcpy(reinterpret_cast<void*>(&type), ptr_, sizeof(Value::Type));
     ptr_ += sizeof(Value::Type);
@@ -181,8 +355,13 @@ std::string Expression::encode(const Expression& exp) {
     return exp.encode();
 }
 
-std::string Expression::encode() const {
-    Encoder encoder;
+// static
+std::string Expression::encodeForRpc(const Expression& exp) {
+    return exp.encode(FLAGS_expression_encode_v2 ? Format::kV2 : Format::kV1);
+}
+
+std::string Expression::encode(Format format) const {
+    Encoder encoder(2048, format);
     writeTo(encoder);
     return encoder.moveStr();
 }
@@ -190,6 +369,10 @@ std::string Expression::encode() const {
 // static
 Expression* Expression::decode(ObjectPool* pool, folly::StringPiece encoded) {
     Decoder decoder(encoded);
+    if (!decoder.ok()) {
+        LOG(ERROR) << "Unsupported format of the encoded expression: " << decoder.getHexStr();
+        return nullptr;
+    }
     if (decoder.finished()) {
         return nullptr;
     }
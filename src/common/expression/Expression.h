@@ -12,6 +12,8 @@
 #include "common/datatypes/Value.h"
 #include "common/context/ExpressionContext.h"
 
+DECLARE_bool(expression_encode_v2);
+
 namespace nebula {
 
 class ExprVisitor;
@@ -146,10 +148,37 @@ public:
     // Deep copy
     virtual Expression* clone() const = 0;
 
-    std::string encode() const;
+    /**
+     * Binary formats of the encoding.
+     *
+     * V1 writes sizes and string lengths as raw host-endian size_t, and values by
+     * the thrift serializer. It is still decoded, since it is persisted in meta,
+     * e.g. for the default values of schemas.
+     *
+     * V2 starts with kFormatMarker, which is never a valid Kind, followed by the version.
+     * Sizes are varints. Each distinct string is written once and then referred to by
+     * its index. Scalar values are written inline.
+     *
+     * V2 is only decoded since this version, the binaries before fail on it. So V1 stays
+     * the default, and V2 is only sent by encodeForRpc() once all the services are upgraded.
+     */
+    enum class Format : uint8_t {
+        kV1 = 1,
+        kV2 = 2,
+    };
+
+    static constexpr uint8_t kFormatMarker = 0xFF;
+
+    std::string encode(Format format = Format::kV1) const;
 
     static std::string encode(const Expression& exp);
 
+    /**
+     * To encode the expression sent to the other services, e.g. the filters to storage,
+     * which is in V2 if FLAGS_expression_encode_v2 is set. Never for those persisted.
+     */
+    static std::string encodeForRpc(const Expression& exp);
+
     static Expression* decode(ObjectPool* pool, folly::StringPiece encoded);
 
     ObjectPool* getObjPool() const {
@@ -171,7 +200,7 @@ public:
 protected:
     class Encoder final {
     public:
-        explicit Encoder(size_t bufSizeHint = 2048);
+        explicit Encoder(size_t bufSizeHint = 2048, Format format = Format::kV1);
         std::string moveStr();
 
         Encoder& operator<<(Kind kind) noexcept;
@@ -182,13 +211,21 @@ protected:
         Encoder& operator<<(const Expression& exp) noexcept;
 
     private:
+        void writeVarint(uint64_t val);
+
         std::string buf_;
+        Format format_;
+        // Index of the strings written, for V2
+        std::unordered_map<std::string, uint64_t> strings_;
     };
 
     class Decoder final {
     public:
         explicit Decoder(folly::StringPiece encoded);
 
+        // Whether the format is known, checked before reading anything
+        bool ok() const;
+
         bool finished() const;
 
         Kind readKind() noexcept;
@@ -202,8 +239,14 @@ protected:
         std::string getHexStr() const;
 
     private:
+        uint64_t readVarint() noexcept;
+
         folly::StringPiece encoded_;
         const char* ptr_;
+        Format format_{Format::kV1};
+        bool ok_{true};
+        // The strings read so far, for V2
+        std::vector<folly::StringPiece> strings_;
     };
 
 protected:
@@ -0,0 +1,64 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/ExpressionCache.h"
+
+#include <folly/hash/SpookyHashV2.h>
+
+namespace nebula {
+
+std::shared_ptr<Expression> ExpressionCache::decode(folly::StringPiece encoded) {
+    if (encoded.empty()) {
+        return nullptr;
+    }
+
+    auto hash = folly::hash::SpookyHashV2::Hash64(encoded.data(), encoded.size(), 0);
+    std::shared_ptr<Entry> entry;
+    auto found = entries_.get(hash);
+    if (found.ok()) {
+        entry = std::move(found).value();
+    } else {
+        entry = std::make_shared<Entry>(encoded);
+        auto existed = entries_.putIfAbsent(hash, entry);
+        if (existed.ok()) {
+            entry = std::move(existed).value();
+        }
+    }
+    if (entry->encoded != encoded) {
+        // Collision of the hash, decode without caching
+        entry.reset();
+    }
+
+    std::unique_ptr<Instance> instance;
+    if (entry != nullptr) {
+        std::lock_guard<std::mutex> guard(entry->lock);
+        if (!entry->idle.empty()) {
+            instance = std::move(entry->idle.back());
+            entry->idle.pop_back();
+        }
+    }
+    if (instance == nullptr) {
+        instance = std::make_unique<Instance>();
+        instance->expr = Expression::decode(&instance->pool, encoded);
+        numDecoded_.fetch_add(1, std::memory_order_relaxed);
+        if (instance->expr == nullptr) {
+            return nullptr;
+        }
+    }
+
+    auto *expr = instance->expr;
+    return std::shared_ptr<Expression>(expr, [entry, inst = instance.release()] (Expression*) {
+        std::unique_ptr<Instance> holder(inst);
+        if (entry != nullptr) {
+            std::lock_guard<std::mutex> guard(entry->lock);
+            if (entry->idle.size() < kMaxIdle) {
+                entry->idle.emplace_back(std::move(holder));
+            }
+        }
+    });
+}
+
+}   // namespace nebula
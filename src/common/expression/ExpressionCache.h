@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_EXPRESSIONCACHE_H_
+#define EXPRESSION_EXPRESSIONCACHE_H_
+
+#include "common/base/Base.h"
+#include "common/base/ConcurrentLRUCache.h"
+#include "common/base/ObjectPool.h"
+#include "common/expression/Expression.h"
+
+namespace nebula {
+
+/**
+ * Cache of the decoded expressions by their encoded content, e.g. the filters pushed down
+ * to storage, which are the same for lots of requests.
+ *
+ * A decoded tree is exclusive to its holder, since the evaluation writes to it.
+ * It is put back for reuse once released, and the concurrent holders of the same content
+ * get distinct trees. So a content is decoded at most as many times as the number of
+ * its concurrent holders.
+ */
+class ExpressionCache final {
+public:
+    explicit ExpressionCache(size_t capacity, uint32_t bucketsExp = 4)
+        : entries_(capacity, bucketsExp) {}
+
+    // The expression decoded from `encoded', or nullptr if it could not be decoded
+    std::shared_ptr<Expression> decode(folly::StringPiece encoded);
+
+    // Number of the actual decodings
+    uint64_t numDecoded() const {
+        return numDecoded_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Instance {
+        ObjectPool      pool;
+        Expression     *expr{nullptr};
+    };
+
+    struct Entry {
+        explicit Entry(folly::StringPiece content) : encoded(content.str()) {}
+
+        const std::string                       encoded;
+        std::mutex                              lock;
+        std::vector<std::unique_ptr<Instance>>  idle;
+    };
+
+    // The idle trees kept per content
+    static constexpr size_t kMaxIdle = 16;
+
+    ConcurrentLRUCache<uint64_t, std::shared_ptr<Entry>>    entries_;
+    std::atomic<uint64_t>                                   numDecoded_{0};
+};
+
+}   // namespace nebula
+
+#endif  // EXPRESSION_EXPRESSIONCACHE_H_
@@ -0,0 +1,110 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/FoldConstantCallVisitor.h"
+#include "common/expression/AggregateExpression.h"
+#include "common/expression/BinaryExpression.h"
+#include "common/expression/CaseExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/ContainerExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/TypeCastingExpression.h"
+#include "common/expression/UnaryExpression.h"
+
+namespace nebula {
+
+Expression* FoldConstantCallVisitor::foldChild(Expression *expr) {
+    expr->accept(this);
+    if (expr->kind() != Expression::Kind::kFunctionCall) {
+        return expr;
+    }
+    auto *call = static_cast<FunctionCallExpression*>(expr);
+    if (!call->isConstant()) {
+        return expr;
+    }
+    std::vector<FunctionManager::ArgType> args;
+    args.reserve(call->args()->numArgs());
+    for (auto *arg : call->args()->args()) {
+        args.emplace_back(static_cast<ConstantExpression*>(arg)->value());
+    }
+    auto func = FunctionManager::get(call->name(), args.size());
+    if (!func.ok()) {
+        return expr;
+    }
+    numFolded_++;
+    return ConstantExpression::make(call->getObjPool(), func.value()(args));
+}
+
+void FoldConstantCallVisitor::visit(UnaryExpression *expr) {
+    expr->setOperand(foldChild(expr->operand()));
+}
+
+void FoldConstantCallVisitor::visit(TypeCastingExpression *expr) {
+    expr->setOperand(foldChild(expr->operand()));
+}
+
+void FoldConstantCallVisitor::visit(LogicalExpression *expr) {
+    auto &operands = expr->operands();
+    for (auto i = 0UL; i < operands.size(); i++) {
+        expr->setOperand(i, foldChild(operands[i]));
+    }
+}
+
+void FoldConstantCallVisitor::visit(FunctionCallExpression *expr) {
+    auto *args = expr->args();
+    for (auto i = 0UL; i < args->numArgs(); i++) {
+        args->setArg(i, foldChild(args->args()[i]));
+    }
+}
+
+void FoldConstantCallVisitor::visit(AggregateExpression *expr) {
+    if (expr->arg() != nullptr) {
+        expr->setArg(foldChild(expr->arg()));
+    }
+}
+
+void FoldConstantCallVisitor::visit(ListExpression *expr) {
+    auto &items = expr->items();
+    for (auto i = 0UL; i < items.size(); i++) {
+        expr->setItem(i, foldChild(items[i]));
+    }
+}
+
+void FoldConstantCallVisitor::visit(SetExpression *expr) {
+    auto &items = expr->items();
+    for (auto i = 0UL; i < items.size(); i++) {
+        expr->setItem(i, foldChild(items[i]));
+    }
+}
+
+void FoldConstantCallVisitor::visit(MapExpression *expr) {
+    auto &items = expr->items();
+    for (auto i = 0UL; i < items.size(); i++) {
+        expr->setItem(i, std::make_pair(items[i].first, foldChild(items[i].second)));
+    }
+}
+
+void FoldConstantCallVisitor::visit(CaseExpression *expr) {
+    if (expr->hasCondition()) {
+        expr->setCondition(foldChild(expr->condition()));
+    }
+    auto &cases = expr->cases();
+    for (auto i = 0UL; i < cases.size(); i++) {
+        expr->setWhen(i, foldChild(cases[i].when));
+        expr->setThen(i, foldChild(cases[i].then));
+    }
+    if (expr->hasDefault()) {
+        expr->setDefault(foldChild(expr->defaultResult()));
+    }
+}
+
+void FoldConstantCallVisitor::visitBinaryExpr(BinaryExpression *expr) {
+    expr->setLeft(foldChild(expr->left()));
+    expr->setRight(foldChild(expr->right()));
+}
+
+}   // namespace nebula
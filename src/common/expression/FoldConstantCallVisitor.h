@@ -0,0 +1,61 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_FOLDCONSTANTCALLVISITOR_H_
+#define EXPRESSION_FOLDCONSTANTCALLVISITOR_H_
+
+#include "common/expression/ExprVisitorImpl.h"
+
+namespace nebula {
+
+/**
+ * To replace the calls of pure functions over constant arguments with
+ * their results, e.g. `lower("ABC")' with "abc", bottom up, so that
+ * `upper(lower("ABC"))' is folded as a whole.
+ *
+ * The calls are replaced in place of the operands of unary, binary and logical
+ * expressions, the arguments of function calls and aggregations, the items of
+ * containers and the branches of case expressions.
+ * Those elsewhere are left as they are.
+ */
+class FoldConstantCallVisitor final : public ExprVisitorImpl {
+public:
+    /**
+     * To fold the calls in `expr'.
+     * @return  the folded expression, which is a new one if `expr' itself is folded
+     */
+    Expression* fold(Expression *expr) {
+        return foldChild(expr);
+    }
+
+    // Number of calls folded
+    size_t numFolded() const {
+        return numFolded_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(UnaryExpression *expr) override;
+    void visit(TypeCastingExpression *expr) override;
+    void visit(LogicalExpression *expr) override;
+    void visit(FunctionCallExpression *expr) override;
+    void visit(AggregateExpression *expr) override;
+    void visit(ListExpression *expr) override;
+    void visit(SetExpression *expr) override;
+    void visit(MapExpression *expr) override;
+    void visit(CaseExpression *expr) override;
+
+private:
+    void visitBinaryExpr(BinaryExpression *expr) override;
+
+    // To visit `expr' and return its replacement, or itself
+    Expression* foldChild(Expression *expr);
+
+    size_t                                  numFolded_{0};
+};
+
+}   // namespace nebula
+
+#endif  // EXPRESSION_FOLDCONSTANTCALLVISITOR_H_
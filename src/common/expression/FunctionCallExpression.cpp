@@ -7,6 +7,11 @@
 #include "common/expression/FunctionCallExpression.h"
 #include "common/expression/ExprVisitor.h"
 
+#include <folly/hash/Hash.h>
+
+DEFINE_int32(function_call_memo_capacity, 0,
+             "Number of results memoized by each call of a pure function, 0 to disable");
+
 namespace nebula {
 
 bool ArgumentList::operator==(const ArgumentList& rhs) const {
@@ -67,21 +72,133 @@ void FunctionCallExpression::resetFrom(Decoder& decoder) {
         args_->addArgument(decoder.readExpression(pool_));
     }
 
+    resolveFunction();
+}
+
+void FunctionCallExpression::resolveFunction() {
+    // Resolved again once the arity changes, keeping the memo capacity set before
+    size_t capacity = memo_.empty() ? FLAGS_function_call_memo_capacity : memo_.size();
+    arity_ = args_->numArgs();
+    func_ = nullptr;
+    isPure_ = false;
+    hasId_ = false;
+    argsType_.clear();
+    overload_ = nullptr;
+    memo_.clear();
     auto funcResult = FunctionManager::get(name_, args_->numArgs());
-    if (funcResult.ok()) {
-        func_ = std::move(funcResult).value();
+    if (!funcResult.ok()) {
+        return;
+    }
+    func_ = std::move(funcResult).value();
+    auto pureResult = FunctionManager::getIsPure(name_, args_->numArgs());
+    isPure_ = pureResult.ok() && pureResult.value();
+    argsBuf_.reserve(args_->numArgs());
+    auto idResult = FunctionManager::getId(name_, args_->numArgs());
+    hasId_ = idResult.ok();
+    if (hasId_) {
+        id_ = idResult.value();
+        argsType_.assign(args_->numArgs(), Value::Type::__EMPTY__);
+        overload_ = FunctionManager::getOverload(id_, argsType_);
+    }
+    if (capacity > 0) {
+        setMemoCapacity(capacity);
+    }
+}
+
+bool FunctionCallExpression::isConstant() const {
+    if (!isPure_ || func_ == nullptr) {
+        return false;
+    }
+    return std::all_of(args_->args().begin(), args_->args().end(), [](const auto* arg) {
+        return arg->kind() == Kind::kConstant;
+    });
+}
+
+void FunctionCallExpression::setMemoCapacity(size_t capacity) {
+    memo_.clear();
+    if (isPure_) {
+        memo_.resize(capacity);
     }
 }
 
 const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
-    std::vector<std::reference_wrapper<const Value>> parameter;
+    if (UNLIKELY(DCHECK_NOTNULL(args_)->numArgs() != arity_)) {
+        // Arguments added after the construction, resolve again for the arity
+        resolveFunction();
+    }
+    argsBuf_.clear();
     for (const auto& arg : DCHECK_NOTNULL(args_)->args()) {
-        parameter.emplace_back(arg->eval(ctx));
+        argsBuf_.emplace_back(arg->eval(ctx));
+    }
+    if (!memo_.empty()) {
+        return evalMemo();
     }
-    result_ = DCHECK_NOTNULL(func_)(parameter);
+    result_ = call();
     return result_;
 }
 
+Value FunctionCallExpression::call() {
+    if (hasId_) {
+        // Select the overload again only if the argument types change
+        auto changed = false;
+        for (auto i = 0UL; i < argsBuf_.size(); i++) {
+            auto type = argsBuf_[i].get().type();
+            if (type != argsType_[i]) {
+                argsType_[i] = type;
+                changed = true;
+            }
+        }
+        if (changed) {
+            overload_ = FunctionManager::getOverload(id_, argsType_);
+        }
+        if (overload_ != nullptr) {
+            return overload_(argsBuf_);
+        }
+    }
+    return DCHECK_NOTNULL(func_)(argsBuf_);
+}
+
+// Stricter than operator==, which takes 1 == 1.0, close floats and different kinds of null
+// as equal, while functions might tell them apart
+static bool isSameArg(const Value& lhs, const Value& rhs) {
+    if (lhs.type() != rhs.type()) {
+        return false;
+    }
+    switch (lhs.type()) {
+        case Value::Type::FLOAT: {
+            return std::memcmp(&lhs.getFloat(), &rhs.getFloat(), sizeof(double)) == 0;
+        }
+        case Value::Type::NULLVALUE: {
+            return lhs.getNull() == rhs.getNull();
+        }
+        default: {
+            return lhs == rhs;
+        }
+    }
+}
+
+const Value& FunctionCallExpression::evalMemo() {
+    size_t hash = argsBuf_.size();
+    for (const auto& arg : argsBuf_) {
+        hash = folly::hash::hash_128_to_64(hash, std::hash<Value>()(arg.get()));
+    }
+    auto& entry = memo_[hash % memo_.size()];
+    auto hit = entry.valid &&
+               entry.hash == hash &&
+               entry.args.size() == argsBuf_.size() &&
+               std::equal(argsBuf_.begin(), argsBuf_.end(), entry.args.begin(),
+                          [](const auto& lhs, const auto& rhs) {
+                              return isSameArg(lhs.get(), rhs);
+                          });
+    if (!hit) {
+        entry.result = call();
+        entry.valid = true;
+        entry.hash = hash;
+        entry.args.assign(argsBuf_.begin(), argsBuf_.end());
+    }
+    return entry.result;
+}
+
 std::string FunctionCallExpression::toString() const {
     std::vector<std::string> args(args_->numArgs());
     std::transform(args_->args().begin(),
@@ -12,6 +12,8 @@
 #include "common/function/FunctionManager.h"
 #include "common/expression/Expression.h"
 
+DECLARE_int32(function_call_memo_capacity);
+
 namespace nebula {
 
 class ArgumentList final {
@@ -107,20 +109,46 @@ public:
         return args_;
     }
 
+    // Whether the function gives the same result for the same arguments
+    bool isPure() const {
+        return isPure_;
+    }
+
+    // Whether it is a pure call over constant arguments, which could be folded
+    bool isConstant() const;
+
+    /**
+     * To memoize the results of the latest distinct arguments, up to `capacity',
+     * 0 to disable. It takes effect for pure functions only, and pays off
+     * when the arguments vary slowly over the rows.
+     */
+    void setMemoCapacity(size_t capacity);
+
 private:
     explicit FunctionCallExpression(ObjectPool* pool, const std::string& name, ArgumentList* args)
         : Expression(pool, Kind::kFunctionCall), name_(name), args_(args) {
         if (!name_.empty()) {
-            auto funcResult = FunctionManager::get(name_, DCHECK_NOTNULL(args_)->numArgs());
-            if (funcResult.ok()) {
-                func_ = funcResult.value();
-            }
+            resolveFunction();
         }
     }
 
     void writeTo(Encoder& encoder) const override;
     void resetFrom(Decoder& decoder) override;
 
+    void resolveFunction();
+
+    // To call the overload for the current argument types if any, otherwise the generic body
+    Value call();
+
+    const Value& evalMemo();
+
+    struct MemoEntry {
+        bool                valid{false};
+        size_t              hash{0};
+        std::vector<Value>  args;
+        Value               result;
+    };
+
 private:
     std::string name_;
     ArgumentList* args_;
@@ -128,6 +156,19 @@ private:
     // runtime cache
     Value result_;
     FunctionManager::Function func_;
+    // The number of arguments which the function is resolved for
+    size_t arity_{0};
+    bool isPure_{false};
+    // Reused across evaluations, so that no allocation happens after the first one
+    std::vector<FunctionManager::ArgType> argsBuf_;
+    // Only for builtin functions
+    bool hasId_{false};
+    FunctionManager::FunctionId id_{0};
+    // The argument types of the last call, and the overload selected for them
+    std::vector<Value::Type> argsType_;
+    FunctionManager::TypedFunction overload_{nullptr};
+    // Direct mapped by the hash of arguments
+    std::vector<MemoEntry> memo_;
 };
 
 }  // namespace nebula
@@ -0,0 +1,159 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/InferTypeVisitor.h"
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/TypeCastingExpression.h"
+#include "common/expression/UnaryExpression.h"
+
+namespace nebula {
+
+static bool isNumeric(Value::Type type) {
+    return type == Value::Type::INT || type == Value::Type::FLOAT;
+}
+
+Value::Type InferTypeVisitor::typeOf(const Expression *expr) const {
+    auto iter = types_.find(expr);
+    return iter == types_.end() ? Value::Type::__EMPTY__ : iter->second;
+}
+
+void InferTypeVisitor::resolve(const PropertyExpression *expr) {
+    if (resolver_ != nullptr) {
+        setType(expr, resolver_(expr));
+    }
+}
+
+void InferTypeVisitor::visit(ConstantExpression *expr) {
+    // A null constant tells nothing about the type
+    auto type = expr->value().type();
+    if (type != Value::Type::NULLVALUE) {
+        setType(expr, type);
+    }
+}
+
+void InferTypeVisitor::visit(TagPropertyExpression *expr) {
+    resolve(expr);
+}
+
+void InferTypeVisitor::visit(EdgePropertyExpression *expr) {
+    resolve(expr);
+}
+
+void InferTypeVisitor::visit(InputPropertyExpression *expr) {
+    resolve(expr);
+}
+
+void InferTypeVisitor::visit(VariablePropertyExpression *expr) {
+    resolve(expr);
+}
+
+void InferTypeVisitor::visit(DestPropertyExpression *expr) {
+    resolve(expr);
+}
+
+void InferTypeVisitor::visit(SourcePropertyExpression *expr) {
+    resolve(expr);
+}
+
+void InferTypeVisitor::visit(EdgeTypeExpression *expr) {
+    setType(expr, Value::Type::INT);
+}
+
+void InferTypeVisitor::visit(EdgeRankExpression *expr) {
+    setType(expr, Value::Type::INT);
+}
+
+void InferTypeVisitor::visit(UnaryExpression *expr) {
+    expr->operand()->accept(this);
+    auto type = typeOf(expr->operand());
+    switch (expr->kind()) {
+        case Expression::Kind::kUnaryPlus:
+        case Expression::Kind::kUnaryNegate:
+        case Expression::Kind::kUnaryIncr:
+        case Expression::Kind::kUnaryDecr: {
+            if (isNumeric(type)) {
+                setType(expr, type);
+            }
+            break;
+        }
+        default: {
+            // not, is (not) null and is (not) empty
+            setType(expr, Value::Type::BOOL);
+            break;
+        }
+    }
+}
+
+void InferTypeVisitor::visit(TypeCastingExpression *expr) {
+    expr->operand()->accept(this);
+    setType(expr, expr->type());
+}
+
+void InferTypeVisitor::visit(ArithmeticExpression *expr) {
+    expr->left()->accept(this);
+    expr->right()->accept(this);
+    auto lType = typeOf(expr->left());
+    auto rType = typeOf(expr->right());
+    if (lType == rType && isNumeric(lType)) {
+        setType(expr, lType);
+        expr->specialize(lType);
+        if (expr->specializedType() != Value::Type::__EMPTY__) {
+            numSpecialized_++;
+        }
+    } else if (isNumeric(lType) && isNumeric(rType)) {
+        setType(expr, Value::Type::FLOAT);
+    } else if (expr->kind() == Expression::Kind::kAdd &&
+               lType == Value::Type::STRING &&
+               rType == Value::Type::STRING) {
+        setType(expr, Value::Type::STRING);
+    }
+}
+
+void InferTypeVisitor::visit(RelationalExpression *expr) {
+    expr->left()->accept(this);
+    expr->right()->accept(this);
+    setType(expr, Value::Type::BOOL);
+    auto lType = typeOf(expr->left());
+    if (lType != Value::Type::__EMPTY__ && lType == typeOf(expr->right())) {
+        expr->specialize(lType);
+        if (expr->specializedType() != Value::Type::__EMPTY__) {
+            numSpecialized_++;
+        }
+    }
+}
+
+void InferTypeVisitor::visit(LogicalExpression *expr) {
+    for (auto *operand : expr->operands()) {
+        operand->accept(this);
+    }
+    setType(expr, Value::Type::BOOL);
+}
+
+void InferTypeVisitor::visit(FunctionCallExpression *expr) {
+    std::vector<Value::Type> argsType;
+    argsType.reserve(expr->args()->numArgs());
+    auto known = true;
+    for (auto *arg : expr->args()->args()) {
+        arg->accept(this);
+        auto type = typeOf(arg);
+        known = known && type != Value::Type::__EMPTY__;
+        argsType.emplace_back(type);
+    }
+    if (!known) {
+        return;
+    }
+    auto result = FunctionManager::getReturnType(expr->name(), argsType);
+    if (result.ok()) {
+        setType(expr, result.value());
+    }
+}
+
+}   // namespace nebula
@@ -0,0 +1,75 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXPRESSION_INFERTYPEVISITOR_H_
+#define EXPRESSION_INFERTYPEVISITOR_H_
+
+#include "common/expression/ExprVisitorImpl.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+class PropertyExpression;
+
+/**
+ * To infer the result type of each node of a tree bottom up, from the constants,
+ * the properties whose types are known, e.g. by the schema, and the return types of
+ * the functions. The arithmetic and relational nodes whose operands are inferred
+ * as the same type are specialized for it along the way.
+ *
+ * An inferred type is the type of a non-null result, a node could still give null
+ * at runtime, e.g. for a nullable property.
+ */
+class InferTypeVisitor final : public ExprVisitorImpl {
+public:
+    // The type of the property, __EMPTY__ if unknown
+    using PropTypeResolver = std::function<Value::Type(const PropertyExpression*)>;
+
+    explicit InferTypeVisitor(PropTypeResolver resolver = nullptr)
+        : resolver_(std::move(resolver)) {}
+
+    // The type inferred for the visited `expr', __EMPTY__ if unknown
+    Value::Type typeOf(const Expression *expr) const;
+
+    // Number of the nodes specialized
+    size_t numSpecialized() const {
+        return numSpecialized_;
+    }
+
+    using ExprVisitorImpl::visit;
+    void visit(ConstantExpression *expr) override;
+    void visit(TagPropertyExpression *expr) override;
+    void visit(EdgePropertyExpression *expr) override;
+    void visit(InputPropertyExpression *expr) override;
+    void visit(VariablePropertyExpression *expr) override;
+    void visit(DestPropertyExpression *expr) override;
+    void visit(SourcePropertyExpression *expr) override;
+    void visit(EdgeTypeExpression *expr) override;
+    void visit(EdgeRankExpression *expr) override;
+    void visit(UnaryExpression *expr) override;
+    void visit(TypeCastingExpression *expr) override;
+    void visit(ArithmeticExpression *expr) override;
+    void visit(RelationalExpression *expr) override;
+    void visit(LogicalExpression *expr) override;
+    void visit(FunctionCallExpression *expr) override;
+
+private:
+    void resolve(const PropertyExpression *expr);
+
+    void setType(const Expression *expr, Value::Type type) {
+        if (type != Value::Type::__EMPTY__) {
+            types_[expr] = type;
+        }
+    }
+
+    PropTypeResolver                                        resolver_;
+    std::unordered_map<const Expression*, Value::Type>      types_;
+    size_t                                                  numSpecialized_{0};
+};
+
+}   // namespace nebula
+
+#endif  // EXPRESSION_INFERTYPEVISITOR_H_
@@ -5,13 +5,12 @@
  */
 
 #include "common/expression/ListComprehensionExpression.h"
+#include "common/expression/BindLocalVisitor.h"
 #include "common/expression/ExprVisitor.h"
 
 namespace nebula {
 
 const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
-    List ret;
-
     auto& listVal = collection_->eval(ctx);
     if (listVal.isNull() || listVal.empty()) {
         result_ = listVal;
@@ -25,13 +24,22 @@ const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
     auto& list = listVal.getList();
 
     if  (filter_ == nullptr && mapping_ == nullptr) {
-        result_ = std::move(list);
+        result_ = list;
         return result_;
     }
 
+    ExpressionContext::LocalFrame frame(ctx, 1, this);
+    auto slot = frame.base();
+    if (static_cast<int32_t>(slot) != localSlot_) {
+        bindLocals(slot);
+    }
+
+    // Filter and map in one pass, the result is at most as long as the collection
+    List ret;
+    ret.values.reserve(list.size());
     for (size_t i = 0; i < list.size(); ++i) {
         auto& v = list[i];
-        ctx.setVar(innerVar_, v);
+        ctx.bindLocal(slot, v);
         if (filter_ != nullptr) {
             auto& filterVal = filter_->eval(ctx);
             if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
@@ -53,6 +61,17 @@ const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
     return result_;
 }
 
+void ListComprehensionExpression::bindLocals(size_t slot) {
+    BindLocalVisitor visitor(innerVar_, slot, this);
+    if (filter_ != nullptr) {
+        filter_->accept(&visitor);
+    }
+    if (mapping_ != nullptr) {
+        mapping_->accept(&visitor);
+    }
+    localSlot_ = static_cast<int32_t>(slot);
+}
+
 Expression* ListComprehensionExpression::clone() const {
     auto expr =
         ListComprehensionExpression::make(pool_,
@@ -71,6 +71,7 @@ public:
 
     void setInnerVar(const std::string& name) {
         innerVar_ = name;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setCollection(Expression* expr) {
@@ -79,10 +80,12 @@ public:
 
     void setFilter(Expression* expr) {
         filter_ = expr;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setMapping(Expression* expr) {
         mapping_ = expr;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     bool hasFilter() const {
@@ -117,6 +120,9 @@ private:
 
     void resetFrom(Decoder& decoder) override;
 
+    // To resolve the references to `innerVar_' to the local slot `slot'
+    void bindLocals(size_t slot);
+
 private:
     std::string innerVar_;
     Expression* collection_{nullptr};
@@ -124,6 +130,8 @@ private:
     Expression* mapping_{nullptr};   // mapping_ is optional
     std::string originString_;
     Value result_;
+    // The local slot which `innerVar_' is bound to
+    int32_t localSlot_{ExpressionContext::kNoSlot};
 };
 
 }   // namespace nebula
@@ -6,6 +6,8 @@
 
 #include "common/expression/PathBuildExpression.h"
 
+#include <utility>
+
 #include "common/datatypes/Path.h"
 #include "common/expression/ExprVisitor.h"
 #include "common/thrift/ThriftTypes.h"
@@ -21,15 +23,15 @@ const Value& PathBuildExpression::eval(ExpressionContext& ctx) {
         return Value::kNullBadType;
     }
     if (val.isPath()) {
-        const auto& steps = val.getPath().steps;
-        path.steps.insert(path.steps.end(), steps.begin(), steps.end());
+        // Shared with the path rather than copied
+        path.steps = val.getPath().steps;
     }
 
     for (size_t i = 1; i < items_.size(); ++i) {
         auto& value = items_[i]->eval(ctx);
         if (value.isEdge()) {
             if (!path.steps.empty()) {
-                const auto& lastStep = path.steps.back();
+                const auto& lastStep = std::as_const(path.steps).back();
                 const auto& edge = value.getEdge();
                 if (lastStep.dst.vid != edge.src) {
                     return Value::kNullBadData;
@@ -42,22 +44,20 @@ const Value& PathBuildExpression::eval(ExpressionContext& ctx) {
             if (path.steps.empty()) {
                 return Value::kNullBadData;
             }
-            auto& lastStep = path.steps.back();
             const auto& vert = value.getVertex();
-            if (lastStep.dst.vid != vert.vid) {
+            if (std::as_const(path.steps).back().dst.vid != vert.vid) {
                 return Value::kNullBadData;
             }
-            getVertex(value, lastStep.dst);
+            getVertex(value, path.steps.back().dst);
         } else if (value.isPath()) {
             const auto& p = value.getPath();
             if (!path.steps.empty()) {
-                auto& lastStep = path.steps.back();
-                if (lastStep.dst.vid != p.src.vid) {
+                if (std::as_const(path.steps).back().dst.vid != p.src.vid) {
                     return Value::kNullBadData;
                 }
-                lastStep.dst = p.src;
+                path.steps.back().dst = p.src;
             }
-            path.steps.insert(path.steps.end(), p.steps.begin(), p.steps.end());
+            path.steps.append(p.steps);
         } else {
             if ((i & 1) == 1 || path.steps.empty() || !getVertex(value, path.steps.back().dst)) {
                 return Value::kNullBadData;
@@ -65,7 +65,7 @@ const Value& PathBuildExpression::eval(ExpressionContext& ctx) {
         }
     }
 
-    result_ = path;
+    result_ = std::move(path);
     return result_;
 }
 
@@ -5,6 +5,7 @@
  */
 
 #include "common/expression/PredicateExpression.h"
+#include "common/expression/BindLocalVisitor.h"
 #include "common/expression/ExprVisitor.h"
 
 namespace nebula {
@@ -77,12 +78,17 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
     }
     auto& list = listVal.getList();
 
+    ExpressionContext::LocalFrame frame(ctx, 1, this);
+    auto slot = frame.base();
+    if (static_cast<int32_t>(slot) != localSlot_) {
+        bindLocals(slot);
+    }
+
     switch (type) {
         case Type::ALL: {
             result_ = true;
             for (size_t i = 0; i < list.size(); ++i) {
-                auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                ctx.bindLocal(slot, list[i]);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
@@ -97,8 +103,7 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
         case Type::ANY: {
             result_ = false;
             for (size_t i = 0; i < list.size(); ++i) {
-                auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                ctx.bindLocal(slot, list[i]);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
@@ -113,8 +118,7 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
         case Type::SINGLE: {
             result_ = false;
             for (size_t i = 0; i < list.size(); ++i) {
-                auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                ctx.bindLocal(slot, list[i]);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
@@ -133,8 +137,7 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
         case Type::NONE: {
             result_ = true;
             for (size_t i = 0; i < list.size(); ++i) {
-                auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                ctx.bindLocal(slot, list[i]);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
@@ -153,6 +156,14 @@ const Value& PredicateExpression::eval(ExpressionContext& ctx) {
     return result_;
 }
 
+void PredicateExpression::bindLocals(size_t slot) {
+    BindLocalVisitor visitor(innerVar_, slot, this);
+    if (filter_ != nullptr) {
+        filter_->accept(&visitor);
+    }
+    localSlot_ = static_cast<int32_t>(slot);
+}
+
 bool PredicateExpression::operator==(const Expression& rhs) const {
     if (kind() != rhs.kind()) {
         return false;
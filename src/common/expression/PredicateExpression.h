@@ -75,6 +75,7 @@ public:
 
     void setInnerVar(const std::string& name) {
         innerVar_ = name;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setCollection(Expression* expr) {
@@ -83,6 +84,7 @@ public:
 
     void setFilter(Expression* expr) {
         filter_ = expr;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setOriginString(const std::string& s) {
@@ -117,6 +119,9 @@ private:
     void writeTo(Encoder& encoder) const override;
     void resetFrom(Decoder& decoder) override;
 
+    // To resolve the references to `innerVar_' to the local slot `slot'
+    void bindLocals(size_t slot);
+
 private:
     static std::unordered_map<std::string, Type> typeMap_;
 
@@ -126,6 +131,8 @@ private:
     Expression* filter_;
     std::string originString_;
     Value result_;
+    // The local slot which `innerVar_' is bound to
+    int32_t localSlot_{ExpressionContext::kNoSlot};
 };
 
 }   // namespace nebula
@@ -53,27 +53,51 @@ const Value& PropertyExpression::eval(ExpressionContext& ctx) {
 }
 
 const Value& EdgePropertyExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getEdgePropBySlot(slot);
+    }
     result_ = ctx.getEdgeProp(sym_, prop_);
     return result_;
 }
 
+int32_t EdgePropertyExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getEdgePropSlot(sym_, prop_);
+}
+
 void EdgePropertyExpression::accept(ExprVisitor *visitor) {
     visitor->visit(this);
 }
 
 const Value& TagPropertyExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getTagPropBySlot(slot);
+    }
     result_ = ctx.getTagProp(sym_, prop_);
     return result_;
 }
 
+int32_t TagPropertyExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getTagPropSlot(sym_, prop_);
+}
+
 void TagPropertyExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
 
 const Value& InputPropertyExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getInputPropBySlot(slot);
+    }
     return ctx.getInputProp(prop_);
 }
 
+int32_t InputPropertyExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getInputPropSlot(prop_);
+}
+
 void InputPropertyExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
@@ -87,54 +111,102 @@ void VariablePropertyExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& SourcePropertyExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getSrcPropBySlot(slot);
+    }
     result_ = ctx.getSrcProp(sym_, prop_);
     return result_;
 }
 
+int32_t SourcePropertyExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getSrcPropSlot(sym_, prop_);
+}
+
 void SourcePropertyExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
 
 const Value& DestPropertyExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getDstPropBySlot(slot);
+    }
     return ctx.getDstProp(sym_, prop_);
 }
 
+int32_t DestPropertyExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getDstPropSlot(sym_, prop_);
+}
+
 void DestPropertyExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
 
 const Value& EdgeSrcIdExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getEdgePropBySlot(slot);
+    }
     result_ = ctx.getEdgeProp(sym_, prop_);
     return result_;
 }
 
+int32_t EdgeSrcIdExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getEdgePropSlot(sym_, prop_);
+}
+
 void EdgeSrcIdExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
 
 const Value& EdgeTypeExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getEdgePropBySlot(slot);
+    }
     result_ = ctx.getEdgeProp(sym_, prop_);
     return result_;
 }
 
+int32_t EdgeTypeExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getEdgePropSlot(sym_, prop_);
+}
+
 void EdgeTypeExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
 
 const Value& EdgeRankExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getEdgePropBySlot(slot);
+    }
     result_ = ctx.getEdgeProp(sym_, prop_);
     return result_;
 }
 
+int32_t EdgeRankExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getEdgePropSlot(sym_, prop_);
+}
+
 void EdgeRankExpression::accept(ExprVisitor* visitor) {
     visitor->visit(this);
 }
 
 const Value& EdgeDstIdExpression::eval(ExpressionContext& ctx) {
+    auto slot = slotOf(ctx);
+    if (slot != ExpressionContext::kNoSlot) {
+        return ctx.getEdgePropBySlot(slot);
+    }
     result_ = ctx.getEdgeProp(sym_, prop_);
     return result_;
 }
 
+int32_t EdgeDstIdExpression::resolveSlot(const ExpressionContext& ctx) const {
+    return ctx.getEdgePropSlot(sym_, prop_);
+}
+
 void EdgeDstIdExpression::accept(ExprVisitor * visitor) {
     visitor->visit(this);
 }
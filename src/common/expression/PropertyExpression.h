@@ -46,6 +46,20 @@ public:
 
     std::string toString() const override;
 
+    /**
+     * To resolve the property to a slot of `ctx' ahead of the evaluation,
+     * otherwise it is done on the first evaluation in each slot epoch of contexts.
+     * See ExpressionContext::slotEpoch.
+     */
+    void bindSlot(const ExpressionContext& ctx) {
+        slot_ = resolveSlot(ctx);
+        slotEpoch_ = ctx.slotEpoch();
+    }
+
+    int32_t slot() const {
+        return slot_;
+    }
+
 protected:
     PropertyExpression(ObjectPool* pool,
                        Kind kind,
@@ -57,9 +71,25 @@ protected:
     void writeTo(Encoder& encoder) const override;
     void resetFrom(Decoder& decoder) override;
 
+    // The slot of the property in `ctx', kNoSlot if it is not supported
+    virtual int32_t resolveSlot(const ExpressionContext& ctx) const {
+        UNUSED(ctx);
+        return ExpressionContext::kNoSlot;
+    }
+
+    int32_t slotOf(const ExpressionContext& ctx) {
+        if (slotEpoch_ != ctx.slotEpoch()) {
+            bindSlot(ctx);
+        }
+        return slot_;
+    }
+
     std::string ref_;
     std::string sym_;
     std::string prop_;
+
+    uint64_t    slotEpoch_{0};
+    int32_t     slot_{ExpressionContext::kNoSlot};
 };
 
 // edge_name.any_prop_name
@@ -83,6 +113,9 @@ public:
         return EdgePropertyExpression::make(pool_, sym(), prop());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit EdgePropertyExpression(ObjectPool* pool,
                                     const std::string& edge = "",
@@ -114,6 +147,9 @@ public:
         return TagPropertyExpression::make(pool_, sym(), prop());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit TagPropertyExpression(ObjectPool* pool,
                                    const std::string& tag = "",
@@ -143,6 +179,9 @@ public:
         return InputPropertyExpression::make(pool_, prop());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit InputPropertyExpression(ObjectPool* pool, const std::string& prop = "")
         : PropertyExpression(pool, Kind::kInputProperty, kInputRef, "", prop) {}
@@ -199,6 +238,9 @@ public:
         return SourcePropertyExpression::make(pool_, sym(), prop());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit SourcePropertyExpression(ObjectPool* pool,
                                       const std::string& tag = "",
@@ -230,6 +272,9 @@ public:
         return DestPropertyExpression::make(pool_, sym(), prop());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit DestPropertyExpression(ObjectPool* pool,
                                     const std::string& tag = "",
@@ -256,6 +301,9 @@ public:
         return EdgeSrcIdExpression::make(pool_, sym());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit EdgeSrcIdExpression(ObjectPool* pool, const std::string& edge = "")
         : PropertyExpression(pool, Kind::kEdgeSrc, "", edge, kSrc) {}
@@ -283,6 +331,9 @@ public:
         return EdgeTypeExpression::make(pool_, sym());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit EdgeTypeExpression(ObjectPool* pool, const std::string& edge = "")
         : PropertyExpression(pool, Kind::kEdgeType, "", edge, kType) {}
@@ -310,6 +361,9 @@ public:
         return EdgeRankExpression::make(pool_, sym());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit EdgeRankExpression(ObjectPool* pool, const std::string& edge = "")
         : PropertyExpression(pool, Kind::kEdgeRank, "", edge, kRank) {}
@@ -337,6 +391,9 @@ public:
         return EdgeDstIdExpression::make(pool_, sym());
     }
 
+protected:
+    int32_t resolveSlot(const ExpressionContext& ctx) const override;
+
 private:
     explicit EdgeDstIdExpression(ObjectPool* pool, const std::string& edge = "")
         : PropertyExpression(pool, Kind::kEdgeDst, "", edge, kDst) {}
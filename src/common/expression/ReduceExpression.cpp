@@ -5,6 +5,7 @@
  */
 
 #include "common/expression/ReduceExpression.h"
+#include "common/expression/BindLocalVisitor.h"
 #include "common/expression/ExprVisitor.h"
 
 namespace nebula {
@@ -23,18 +24,39 @@ const Value& ReduceExpression::eval(ExpressionContext& ctx) {
     }
     auto& list = listVal.getList();
 
-    ctx.setVar(accumulator_, initVal);
+    ExpressionContext::LocalFrame frame(ctx, 2, this);
+    auto slot = frame.base();
+    if (static_cast<int32_t>(slot) != localSlot_) {
+        bindLocals(slot);
+    }
+
+    // The accumulator is double buffered, since the mapping could refer to a part of
+    // the current one, which must not be overwritten while it is copied
+    Value acc[2] = {initVal, Value()};
+    size_t cur = 0;
     for (size_t i = 0; i < list.size(); ++i) {
-        auto& v = list[i];
-        ctx.setVar(innerVar_, v);
+        ctx.bindLocal(slot, acc[cur]);
+        ctx.bindLocal(slot + 1, list[i]);
         auto& mappingVal = mapping_->eval(ctx);
-        ctx.setVar(accumulator_, mappingVal);
+        if (&mappingVal != &acc[cur]) {
+            acc[cur ^ 1] = mappingVal;
+            cur ^= 1;
+        }
     }
 
-    result_ = ctx.getVar(accumulator_);
+    result_ = std::move(acc[cur]);
     return result_;
 }
 
+void ReduceExpression::bindLocals(size_t slot) {
+    // The inner variable shadows the accumulator of the same name
+    BindLocalVisitor accVisitor(accumulator_, slot, this);
+    mapping_->accept(&accVisitor);
+    BindLocalVisitor innerVisitor(innerVar_, slot + 1, this);
+    mapping_->accept(&innerVisitor);
+    localSlot_ = static_cast<int32_t>(slot);
+}
+
 Expression* ReduceExpression::clone() const {
     auto expr = ReduceExpression::make(pool_,
                                        accumulator_,
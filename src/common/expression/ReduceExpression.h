@@ -74,6 +74,7 @@ public:
 
     void setAccumulator(const std::string& name) {
         accumulator_ = name;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setInitial(Expression* expr) {
@@ -82,6 +83,7 @@ public:
 
     void setInnerVar(const std::string& name) {
         innerVar_ = name;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setCollection(Expression* expr) {
@@ -90,6 +92,7 @@ public:
 
     void setMapping(Expression* expr) {
         mapping_ = expr;
+        localSlot_ = ExpressionContext::kNoSlot;
     }
 
     void setOriginString(const std::string& s) {
@@ -117,6 +120,10 @@ private:
     void writeTo(Encoder& encoder) const override;
     void resetFrom(Decoder& decoder) override;
 
+    // To resolve the references to `accumulator_' and `innerVar_' to the local slots
+    // `slot' and `slot + 1'
+    void bindLocals(size_t slot);
+
 private:
     std::string accumulator_;
     Expression* initial_;
@@ -125,6 +132,8 @@ private:
     Expression* mapping_;
     std::string originString_;
     Value result_;
+    // The local slot which `accumulator_' is bound to, followed by that of `innerVar_'
+    int32_t localSlot_{ExpressionContext::kNoSlot};
 };
 
 }   // namespace nebula
@@ -8,6 +8,7 @@
 #include "common/datatypes/List.h"
 #include "common/datatypes/Set.h"
 #include "common/datatypes/Map.h"
+#include "common/expression/ConstantExpression.h"
 #include "common/expression/ExprVisitor.h"
 
 namespace nebula {
@@ -15,6 +16,33 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
     auto& lhs = lhs_->eval(ctx);
     auto& rhs = rhs_->eval(ctx);
 
+    if (specialized_ != Value::Type::__EMPTY__ &&
+        lhs.type() == specialized_ &&
+        rhs.type() == specialized_) {
+        // The same as Value::lessThan() and Value::equal() of the same types
+        switch (specialized_) {
+            case Value::Type::INT: {
+                auto l = lhs.getInt();
+                auto r = rhs.getInt();
+                evalCompare(l < r, l == r);
+                break;
+            }
+            case Value::Type::FLOAT: {
+                auto l = lhs.getFloat();
+                auto r = rhs.getFloat();
+                auto eq = std::abs(l - r) < kEpsilon;
+                evalCompare(std::abs(l - r) >= kEpsilon && l < r, eq);
+                break;
+            }
+            default: {
+                auto cmp = lhs.getStr().compare(rhs.getStr());
+                evalCompare(cmp < 0, cmp == 0);
+                break;
+            }
+        }
+        return result_;
+    }
+
     switch (kind_) {
         case Kind::kRelEQ:
             result_ = lhs.equal(rhs);
@@ -130,8 +158,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
                 result_ = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = lhs.getStr().size() >= rhs.getStr().size() &&
-                          lhs.getStr().find(rhs.getStr()) != std::string::npos;
+                result_ = contains(lhs.getStr(), rhs.getStr());
             } else {
                 result_ = Value::kNullValue;
             }
@@ -143,8 +170,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
                 result_ = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = !(lhs.getStr().size() >= rhs.getStr().size() &&
-                            lhs.getStr().find(rhs.getStr()) != std::string::npos);
+                result_ = !contains(lhs.getStr(), rhs.getStr());
             } else {
                 result_ = Value::kNullValue;
             }
@@ -156,8 +182,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
                 result_ = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = lhs.getStr().size() >= rhs.getStr().size() &&
-                          lhs.getStr().find(rhs.getStr()) == 0;
+                result_ = strings::startsWith(lhs.getStr(), rhs.getStr());
             } else {
                 result_ = Value::kNullValue;
             }
@@ -169,8 +194,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
                 result_ = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = !(lhs.getStr().size() >= rhs.getStr().size() &&
-                            lhs.getStr().find(rhs.getStr()) == 0);
+                result_ = !strings::startsWith(lhs.getStr(), rhs.getStr());
             } else {
                 result_ = Value::kNullValue;
             }
@@ -182,10 +206,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
                 result_ = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = lhs.getStr().size() >= rhs.getStr().size() &&
-                          lhs.getStr().compare(lhs.getStr().size() - rhs.getStr().size(),
-                                               rhs.getStr().size(),
-                                               rhs.getStr()) == 0;
+                result_ = strings::endsWith(lhs.getStr(), rhs.getStr());
             } else {
                 result_ = Value::kNullValue;
             }
@@ -197,10 +218,7 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
                 result_ = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = !(lhs.getStr().size() >= rhs.getStr().size() &&
-                            lhs.getStr().compare(lhs.getStr().size() - rhs.getStr().size(),
-                                                 rhs.getStr().size(),
-                                                 rhs.getStr()) == 0);
+                result_ = !strings::endsWith(lhs.getStr(), rhs.getStr());
             } else {
                 result_ = Value::kNullValue;
             }
@@ -212,6 +230,62 @@ const Value& RelationalExpression::eval(ExpressionContext& ctx) {
     return result_;
 }
 
+bool RelationalExpression::contains(const std::string& str, const std::string& pattern) {
+    if (rhs_->kind() != Kind::kConstant) {
+        return strings::contains(str, pattern);
+    }
+    // Prepared once, unless the constant is replaced or its value is set again
+    auto version = static_cast<const ConstantExpression*>(rhs_)->version();
+    if (searcher_ == nullptr || searcherVersion_ != version) {
+        searcher_ = std::make_unique<strings::Searcher>(pattern);
+        searcherVersion_ = version;
+    }
+    return searcher_->contains(str);
+}
+
+void RelationalExpression::specialize(Value::Type type) {
+    specialized_ = Value::Type::__EMPTY__;
+    switch (kind_) {
+        case Kind::kRelEQ:
+        case Kind::kRelNE:
+        case Kind::kRelLT:
+        case Kind::kRelLE:
+        case Kind::kRelGT:
+        case Kind::kRelGE:
+            break;
+        default:
+            return;
+    }
+    if (type == Value::Type::INT || type == Value::Type::FLOAT || type == Value::Type::STRING) {
+        specialized_ = type;
+    }
+}
+
+void RelationalExpression::evalCompare(bool lt, bool eq) {
+    switch (kind_) {
+        case Kind::kRelEQ:
+            result_.setBool(eq);
+            break;
+        case Kind::kRelNE:
+            result_.setBool(!eq);
+            break;
+        case Kind::kRelLT:
+            result_.setBool(lt);
+            break;
+        case Kind::kRelLE:
+            result_.setBool(lt || eq);
+            break;
+        case Kind::kRelGT:
+            result_.setBool(!lt && !eq);
+            break;
+        case Kind::kRelGE:
+            result_.setBool(!lt || eq);
+            break;
+        default:
+            LOG(FATAL) << "Unspecialized type: " << kind_;
+    }
+}
+
 std::string RelationalExpression::toString() const {
     std::string op;
     switch (kind_) {
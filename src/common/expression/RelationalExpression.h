@@ -7,6 +7,7 @@
 #ifndef COMMON_EXPRESSION_RELATIONALEXPRESSION_H_
 #define COMMON_EXPRESSION_RELATIONALEXPRESSION_H_
 
+#include "common/base/StringKernels.h"
 #include "common/expression/BinaryExpression.h"
 
 namespace nebula {
@@ -133,20 +134,50 @@ public:
     void accept(ExprVisitor* visitor) override;
 
     Expression* clone() const override {
-        return pool_->add(
+        auto* expr = pool_->add(
             new RelationalExpression(pool_, kind(), left()->clone(), right()->clone()));
+        expr->specialized_ = specialized_;
+        return expr;
     }
 
     bool isRelExpr() const override {
         return true;
     }
 
+    void setRight(Expression* expr) override {
+        BinaryExpression::setRight(expr);
+        searcher_.reset();
+    }
+
+    /**
+     * To take a fast path when both operands are of `type', which is inferred statically,
+     * e.g. by InferTypeVisitor. The generic comparisons are still used whenever the actual
+     * types differ, e.g. for null. Only INT, FLOAT and STRING of ==, !=, <, <=, > and >=
+     * are specialized, otherwise it is a no-op.
+     */
+    void specialize(Value::Type type);
+
+    // The type specialized for, __EMPTY__ if none
+    Value::Type specializedType() const {
+        return specialized_;
+    }
+
 private:
     explicit RelationalExpression(ObjectPool* pool, Kind kind, Expression* lhs, Expression* rhs)
         : BinaryExpression(pool, kind, lhs, rhs) {}
 
+    // To compare by the results of `less than' and `equal to'
+    void evalCompare(bool lt, bool eq);
+
+    // Whether `str' contains `pattern', with a searcher prepared for the constant ones
+    bool contains(const std::string& str, const std::string& pattern);
+
 private:
     Value result_;
+    Value::Type specialized_{Value::Type::__EMPTY__};
+    std::unique_ptr<strings::Searcher> searcher_;
+    // The version of the constant which `searcher_' is prepared for
+    uint32_t searcherVersion_{0};
 };
 
 }   // namespace nebula
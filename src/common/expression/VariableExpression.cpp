@@ -10,6 +10,14 @@
 
 namespace nebula {
 const Value& VariableExpression::eval(ExpressionContext& ctx) {
+    if (localSlot_ != ExpressionContext::kNoSlot && ctx.isLocalOf(localSlot_, localOwner_)) {
+        auto* pending = ctx.pendingLocal(localSlot_);
+        if (pending != nullptr) {
+            // The frames pushed by the evaluation are popped when it returns
+            ctx.bindLocal(localSlot_, pending->eval(ctx));
+        }
+        return ctx.getLocal(localSlot_);
+    }
     return ctx.getVar(var_);
 }
 
@@ -27,6 +27,20 @@ public:
         return isInner_;
     }
 
+    /**
+     * To read the variable from the local slot `slot' of ExpressionContext instead
+     * of by its name. It is bound by the iterating expression declaring the variable,
+     * i.e. `owner' of the frame, and is read by the name in the frames of the others.
+     */
+    void bindLocal(size_t slot, const void* owner) {
+        localSlot_ = static_cast<int32_t>(slot);
+        localOwner_ = owner;
+    }
+
+    int32_t localSlot() const {
+        return localSlot_;
+    }
+
     const Value& eval(ExpressionContext& ctx) override;
 
     bool operator==(const Expression& rhs) const override {
@@ -56,6 +70,8 @@ private:
 private:
     bool isInner_{false};
     std::string var_;
+    int32_t localSlot_{ExpressionContext::kNoSlot};
+    const void* localOwner_{nullptr};
 };
 
 /*
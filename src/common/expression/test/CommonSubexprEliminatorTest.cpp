@@ -0,0 +1,192 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/test/TestBase.h"
+#include "common/expression/CommonSubexprEliminator.h"
+
+namespace nebula {
+
+class CommonSubexprEliminatorTest : public ExpressionTest {
+protected:
+    Expression* abs(Expression *arg) {
+        auto *args = ArgumentList::make(&pool);
+        args->addArgument(arg);
+        return FunctionCallExpression::make(&pool, "abs", args);
+    }
+
+    Expression* var() {
+        return VariableExpression::make(&pool, "n", true);
+    }
+
+    Expression* constant(Value val) {
+        return ConstantExpression::make(&pool, std::move(val));
+    }
+};
+
+TEST_F(CommonSubexprEliminatorTest, Eliminate) {
+    // abs($n) > 1 AND abs($n) < 10
+    auto *filter = LogicalExpression::makeAnd(
+        &pool,
+        RelationalExpression::makeGT(&pool, abs(var()), constant(1)),
+        RelationalExpression::makeLT(&pool, abs(var()), constant(10)));
+    // (abs($n) + 1) * 2
+    auto *column1 = ArithmeticExpression::makeMultiply(
+        &pool, ArithmeticExpression::makeAdd(&pool, abs(var()), constant(1)), constant(2));
+    // (abs($n) + 1) * 2 - abs($n)
+    auto *column2 = ArithmeticExpression::makeMinus(
+        &pool,
+        ArithmeticExpression::makeMultiply(
+            &pool, ArithmeticExpression::makeAdd(&pool, abs(var()), constant(1)), constant(2)),
+        abs(var()));
+    // $n + 1, nothing shared
+    auto *column3 = ArithmeticExpression::makeAdd(&pool, var(), constant(1));
+    std::vector<Expression*> exprs = {filter, column1, column2, column3};
+    std::vector<Expression*> expected;
+    for (auto *expr : exprs) {
+        expected.emplace_back(expr->clone());
+    }
+
+    CommonSubexprEliminator cse(&pool);
+    ASSERT_EQ(2, cse.eliminate(exprs));
+    auto hoisted = cse.hoisted();
+    ASSERT_EQ(2, hoisted.size());
+    EXPECT_EQ(*abs(var()), *hoisted[0]);
+    EXPECT_EQ(Expression::Kind::kMultiply, hoisted[1]->kind());
+    // The whole column is shared
+    EXPECT_EQ(Expression::Kind::kVar, exprs[1]->kind());
+    EXPECT_EQ(exprs[3], column3);
+    EXPECT_EQ(*expected[3], *exprs[3]);
+
+    for (auto n : {-20, -5, 0, 1, 3, 12}) {
+        gExpCtxt.setVar("n", n);
+        CommonSubexprEliminator::Row row(cse, gExpCtxt);
+        for (auto i = 0UL; i < exprs.size(); i++) {
+            EXPECT_EQ(Expression::eval(expected[i], gExpCtxt), Expression::eval(exprs[i], gExpCtxt))
+                << "n = " << n << ": " << expected[i]->toString();
+        }
+    }
+}
+
+TEST_F(CommonSubexprEliminatorTest, Guarded) {
+    auto guard = [this] () {
+        return RelationalExpression::makeGT(&pool, var(), constant(0));
+    };
+    // CASE WHEN $n > 0 THEN abs($n) END, and the same plus 1
+    auto *cases1 = CaseList::make(&pool);
+    cases1->add(guard(), abs(var()));
+    auto *cases2 = CaseList::make(&pool);
+    cases2->add(guard(), abs(var()));
+    auto *case1 = CaseExpression::make(&pool, cases1);
+    auto *case2 = CaseExpression::make(&pool, cases2);
+    // $n > 0 AND abs($n) > 1
+    auto *filter = LogicalExpression::makeAnd(
+        &pool, guard(), RelationalExpression::makeGT(&pool, abs(var()), constant(1)));
+    std::vector<Expression*> exprs = {
+        case1, ArithmeticExpression::makeAdd(&pool, case2, constant(1)), filter};
+    std::vector<Expression*> expected;
+    for (auto *expr : exprs) {
+        expected.emplace_back(expr->clone());
+    }
+    CommonSubexprEliminator cse(&pool);
+    // The CASE, the guard and abs($n)
+    ASSERT_EQ(3, cse.eliminate(exprs));
+
+    for (auto n : {-5, 0, 1, 3}) {
+        gExpCtxt.setVar("n", n);
+        CommonSubexprEliminator::Row row(cse, gExpCtxt);
+        // Evaluated on the first read, not by the construction of the row
+        gExpCtxt.setVar("n", n * 2);
+        for (auto i = 0UL; i < exprs.size(); i++) {
+            EXPECT_EQ(Expression::eval(expected[i], gExpCtxt), Expression::eval(exprs[i], gExpCtxt))
+                << "n = " << n << ": " << expected[i]->toString();
+        }
+    }
+}
+
+TEST_F(CommonSubexprEliminatorTest, ForeignFrame) {
+    // abs($n) + abs($n)
+    std::vector<Expression*> exprs = {ArithmeticExpression::makeAdd(&pool, abs(var()), abs(var()))};
+    CommonSubexprEliminator cse(&pool);
+    ASSERT_EQ(1, cse.eliminate(exprs));
+    gExpCtxt.setVar("n", -3);
+    {
+        CommonSubexprEliminator::Row row(cse, gExpCtxt);
+        EXPECT_EQ(Value(6), Expression::eval(exprs[0], gExpCtxt));
+    }
+    // The same slot in the frame of another owner is not read, but the variable by name
+    int owner = 0;
+    Value other(100);
+    ExpressionContext::LocalFrame frame(gExpCtxt, 1, &owner);
+    gExpCtxt.bindLocal(frame.base(), other);
+    gExpCtxt.setVar("__cse_0", 4);
+    EXPECT_EQ(Value(8), Expression::eval(exprs[0], gExpCtxt));
+}
+
+TEST_F(CommonSubexprEliminatorTest, StrictConstants) {
+    auto divide = [this] (Value divisor) {
+        return ArithmeticExpression::makeDivision(&pool, var(), constant(std::move(divisor)));
+    };
+    // $n / 2 and $n / 2.0, and the floats equal within epsilon only
+    std::vector<Expression*> exprs = {
+        divide(2), divide(2.0), divide(0.1), divide(0.1 + 1e-12),
+    };
+    std::vector<Expression*> expected;
+    for (auto *expr : exprs) {
+        expected.emplace_back(expr->clone());
+    }
+    CommonSubexprEliminator cse(&pool);
+    EXPECT_EQ(0, cse.eliminate(exprs));
+
+    gExpCtxt.setVar("n", 5);
+    CommonSubexprEliminator::Row row(cse, gExpCtxt);
+    EXPECT_EQ(Value(2), Expression::eval(exprs[0], gExpCtxt));
+    EXPECT_EQ(Value(2.5), Expression::eval(exprs[1], gExpCtxt));
+    for (auto i = 0UL; i < exprs.size(); i++) {
+        auto result = Expression::eval(exprs[i], gExpCtxt);
+        auto origin = Expression::eval(expected[i], gExpCtxt);
+        EXPECT_EQ(origin.type(), result.type()) << expected[i]->toString();
+        EXPECT_EQ(origin, result) << expected[i]->toString();
+    }
+
+    // But the same ones are shared
+    std::vector<Expression*> same = {
+        ArithmeticExpression::makeAdd(&pool, divide(2.0), constant(1)),
+        ArithmeticExpression::makeMinus(&pool, divide(2.0), constant(1)),
+    };
+    CommonSubexprEliminator sameCse(&pool);
+    ASSERT_EQ(1, sameCse.eliminate(same));
+    EXPECT_EQ(*divide(2.0), *sameCse.hoisted()[0]);
+}
+
+TEST_F(CommonSubexprEliminatorTest, Nothing) {
+    auto rand = [] () {
+        return FunctionCallExpression::make(&pool, "rand32", ArgumentList::make(&pool));
+    };
+    // rand32() + rand32() + abs(rand32()) + abs(rand32())
+    std::vector<Expression*> exprs = {
+        ArithmeticExpression::makeAdd(&pool, rand(), rand()),
+        ArithmeticExpression::makeAdd(&pool, abs(rand()), abs(rand())),
+        var(),
+        var(),
+        constant(1),
+        constant(1),
+    };
+    auto origin = exprs;
+    CommonSubexprEliminator cse(&pool);
+    EXPECT_EQ(0, cse.eliminate(exprs));
+    EXPECT_EQ(origin, exprs);
+    EXPECT_EQ(0, cse.numHoisted());
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -5,6 +5,7 @@
  */
 
 #include "common/expression/test/TestBase.h"
+#include "common/expression/ExpressionCache.h"
 
 namespace nebula {
 
@@ -537,6 +538,115 @@ TEST(ExpressionEncodeDecode, ListComprehensionExpression) {
     }
 }
 
+// like(edge).likeness > 80 AND like(edge).likeness < 1.5 * 100 AND like(edge).name != "Tim"
+static Expression* makeFilter(ObjectPool* p, const std::string& name) {
+    auto *gt = RelationalExpression::makeGT(p,
+                                            EdgePropertyExpression::make(p, "like", "likeness"),
+                                            ConstantExpression::make(p, 80));
+    auto *lt = RelationalExpression::makeLT(
+        p,
+        EdgePropertyExpression::make(p, "like", "likeness"),
+        ArithmeticExpression::makeMultiply(p,
+                                           ConstantExpression::make(p, 1.5),
+                                           ConstantExpression::make(p, -100)));
+    auto *ne = RelationalExpression::makeNE(p,
+                                            EdgePropertyExpression::make(p, "like", "name"),
+                                            ConstantExpression::make(p, name));
+    auto *filter = LogicalExpression::makeAnd(p, gt, lt);
+    filter->addOperand(ne);
+    filter->addOperand(ConstantExpression::make(p, Value(NullType::BAD_TYPE)));
+    filter->addOperand(ConstantExpression::make(p, Value(List({1, "a", 2.5}))));
+    return filter;
+}
+
+TEST(ExpressionEncodeDecode, Format) {
+    auto *origin = makeFilter(&pool, "Tim");
+
+    auto v1 = origin->encode(Expression::Format::kV1);
+    ASSERT_NE(Expression::kFormatMarker, static_cast<uint8_t>(v1[0]));
+    auto decoded = Expression::decode(&pool, v1);
+    ASSERT_NE(nullptr, decoded);
+    ASSERT_EQ(*origin, *decoded);
+
+    // V1 by default, which the binaries of the older versions decode
+    ASSERT_EQ(v1, origin->encode());
+    ASSERT_EQ(v1, Expression::encode(*origin));
+    ASSERT_EQ(v1, Expression::encodeForRpc(*origin));
+    ASSERT_EQ(v1, decoded->encode());
+
+    auto v2 = origin->encode(Expression::Format::kV2);
+    ASSERT_EQ(Expression::kFormatMarker, static_cast<uint8_t>(v2[0]));
+    ASSERT_EQ(static_cast<uint8_t>(Expression::Format::kV2), static_cast<uint8_t>(v2[1]));
+    ASSERT_LT(v2.size(), v1.size());
+    decoded = Expression::decode(&pool, v2);
+    ASSERT_NE(nullptr, decoded);
+    ASSERT_EQ(*origin, *decoded);
+    ASSERT_EQ(v2, decoded->encode(Expression::Format::kV2));
+    // Sent in V2 only if asked to
+    {
+        gflags::FlagSaver flagSaver;
+        FLAGS_expression_encode_v2 = true;
+        ASSERT_EQ(v2, Expression::encodeForRpc(*origin));
+    }
+    // Decoded from V2 and encoded again in V1
+    ASSERT_EQ(v1, decoded->encode());
+
+    // The V1 blob as written by the older versions, i.e. $var
+    std::string old(1, static_cast<char>(Expression::Kind::kVar));
+    size_t size = 3;
+    old.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    old.append("var");
+    decoded = Expression::decode(&pool, old);
+    ASSERT_NE(nullptr, decoded);
+    ASSERT_EQ(*VariableExpression::make(&pool, "var"), *decoded);
+    ASSERT_EQ(old, decoded->encode());
+
+    // Unknown version
+    v2[1] = 3;
+    ASSERT_EQ(nullptr, Expression::decode(&pool, v2));
+}
+
+TEST(ExpressionEncodeDecode, Cache) {
+    ExpressionCache cache(1024);
+    auto tim = makeFilter(&pool, "Tim")->encode();
+    auto tony = makeFilter(&pool, "Tony")->encode();
+
+    ASSERT_EQ(nullptr, cache.decode(""));
+    {
+        auto expr = cache.decode(tim);
+        ASSERT_NE(nullptr, expr);
+        ASSERT_EQ(*makeFilter(&pool, "Tim"), *expr);
+    }
+    {
+        // Reused once released
+        auto expr = cache.decode(tim);
+        ASSERT_EQ(*makeFilter(&pool, "Tim"), *expr);
+        ASSERT_EQ(1, cache.numDecoded());
+
+        // Held concurrently
+        auto another = cache.decode(tim);
+        ASSERT_NE(expr.get(), another.get());
+        ASSERT_EQ(*expr, *another);
+        ASSERT_EQ(2, cache.numDecoded());
+    }
+    {
+        auto expr = cache.decode(tony);
+        ASSERT_EQ(*makeFilter(&pool, "Tony"), *expr);
+        ASSERT_EQ(3, cache.numDecoded());
+    }
+    {
+        auto expr = cache.decode(tim);
+        auto another = cache.decode(tim);
+        ASSERT_EQ(3, cache.numDecoded());
+    }
+    {
+        // Of V2 as well
+        auto expr = cache.decode(makeFilter(&pool, "Tim")->encode(Expression::Format::kV2));
+        ASSERT_EQ(*makeFilter(&pool, "Tim"), *expr);
+        ASSERT_EQ(4, cache.numDecoded());
+    }
+}
+
 }   // namespace nebula
 
 int main(int argc, char **argv) {
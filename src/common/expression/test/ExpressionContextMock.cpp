@@ -45,6 +45,10 @@ std::unordered_map<std::string, Value> ExpressionContextMock::vals_ = {
     {"path_edge3", Value(Edge("3", "4", 1, "edge", 0, {}))},
 };
 
+std::vector<const Value*> ExpressionContextMock::slots_;
+uint64_t ExpressionContextMock::slotEpoch_ = ExpressionContext::nextSlotEpoch();
+size_t ExpressionContextMock::numResolved_ = 0;
+
 Value ExpressionContextMock::getColumn(int32_t index) const {
     auto row = vals_["versioned_var"].getList().values;
     auto size = row.size();
@@ -12,6 +12,9 @@ namespace nebula {
 
 class ExpressionContextMock final : public ExpressionContext {
 public:
+    // Without slots, the properties are read by the getters by name only
+    explicit ExpressionContextMock(bool withSlots = false) : withSlots_(withSlots) {}
+
     const Value& getVar(const std::string& var) const override {
         auto found = vals_.find(var);
         if (found == vals_.end()) {
@@ -124,11 +127,90 @@ public:
         if (var == "n" || var == "p" || var == "totalNum") {
             vals_.erase(var);
             vals_[var] = val;
+            // The erased value may be referred by some slot
+            slots_.clear();
+            slotEpoch_ = nextSlotEpoch();
+        }
+    }
+
+    uint64_t slotEpoch() const override {
+        return withSlots_ ? slotEpoch_ : 0;
+    }
+
+    int32_t getEdgePropSlot(const std::string& edgeType,
+                            const std::string& prop) const override {
+        UNUSED(edgeType);
+        return propSlot(prop);
+    }
+
+    int32_t getTagPropSlot(const std::string& tag,
+                           const std::string& prop) const override {
+        UNUSED(tag);
+        return propSlot(prop);
+    }
+
+    int32_t getSrcPropSlot(const std::string& tag,
+                           const std::string& prop) const override {
+        UNUSED(tag);
+        return propSlot(prop);
+    }
+
+    int32_t getDstPropSlot(const std::string& tag,
+                           const std::string& prop) const override {
+        UNUSED(tag);
+        return propSlot(prop);
+    }
+
+    int32_t getInputPropSlot(const std::string& prop) const override {
+        return propSlot(prop);
+    }
+
+    const Value& getEdgePropBySlot(int32_t slot) const override {
+        return *slots_[slot];
+    }
+
+    const Value& getTagPropBySlot(int32_t slot) const override {
+        return *slots_[slot];
+    }
+
+    const Value& getSrcPropBySlot(int32_t slot) const override {
+        return *slots_[slot];
+    }
+
+    const Value& getDstPropBySlot(int32_t slot) const override {
+        return *slots_[slot];
+    }
+
+    const Value& getInputPropBySlot(int32_t slot) const override {
+        return *slots_[slot];
+    }
+
+    // Number of the slot resolutions so far
+    static size_t numResolved() {
+        return numResolved_;
+    }
+
+private:
+    // The slots are shared by all the mocks with slots, just as `vals_'
+    int32_t propSlot(const std::string& prop) const {
+        if (!withSlots_) {
+            return kNoSlot;
+        }
+        numResolved_++;
+        auto found = vals_.find(prop);
+        if (found == vals_.end()) {
+            return kNoSlot;
         }
+        slots_.emplace_back(&found->second);
+        return static_cast<int32_t>(slots_.size() - 1);
     }
 
 private:
     static std::unordered_map<std::string, Value>      vals_;
+    static std::vector<const Value*>                   slots_;
+    static uint64_t                                    slotEpoch_;
+    static size_t                                      numResolved_;
+    bool                                               withSlots_{false};
     std::unordered_map<std::string, std::regex>        regex_;
 };
 }  // namespace nebula
@@ -15,9 +15,20 @@ nebula::ExpressionContextMock gExpCtxt;
 nebula::ObjectPool pool;
 namespace nebula {
 
-static FunctionCallExpression* expr = nullptr;
+static FunctionCallExpression* makeCall(const std::string& name, std::vector<Value> args) {
+    auto* argList = ArgumentList::make(&pool, args.size());
+    for (auto& arg : args) {
+        argList->addArgument(ConstantExpression::make(&pool, std::move(arg)));
+    }
+    return FunctionCallExpression::make(&pool, name, argList);
+}
 
-size_t funcCall(size_t iters) {
+// Through the expression, which dispatches to the overload of the argument types
+size_t funcCall(size_t iters, const char* name, std::vector<Value> args) {
+    FunctionCallExpression* expr = nullptr;
+    BENCHMARK_SUSPEND {
+        expr = makeCall(name, std::move(args));
+    }
     for (size_t i = 0; i < iters; ++i) {
         Value eval = Expression::eval(expr, gExpCtxt);
         folly::doNotOptimizeAway(eval);
@@ -25,15 +36,62 @@ size_t funcCall(size_t iters) {
     return iters;
 }
 
-BENCHMARK_NAMED_PARAM_MULTI(funcCall, FunctionCallBM)
+// Through the generic body, type switching behind std::function
+size_t genericCall(size_t iters, const char* name, std::vector<Value> args) {
+    FunctionManager::Function func;
+    BENCHMARK_SUSPEND {
+        func = FunctionManager::get(name, args.size()).value();
+    }
+    std::vector<FunctionManager::ArgType> argsRef(args.begin(), args.end());
+    for (size_t i = 0; i < iters; ++i) {
+        Value eval = func(argsRef);
+        folly::doNotOptimizeAway(eval);
+    }
+    return iters;
+}
+
+// Looking up the function by name on each call
+size_t lookupCall(size_t iters, const char* name, std::vector<Value> args) {
+    std::vector<FunctionManager::ArgType> argsRef(args.begin(), args.end());
+    for (size_t i = 0; i < iters; ++i) {
+        Value eval = FunctionManager::get(name, argsRef.size()).value()(argsRef);
+        folly::doNotOptimizeAway(eval);
+    }
+    return iters;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(lookupCall, abs_int, "abs", {-1})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(genericCall, abs_int, "abs", {-1})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(funcCall, abs_int, "abs", {-1})
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(lookupCall, floor_float, "floor", {1.5})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(genericCall, floor_float, "floor", {1.5})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(funcCall, floor_float, "floor", {1.5})
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(lookupCall, lower_string, "Lower", {"ABCDEFG"})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(genericCall, lower_string, "Lower", {"ABCDEFG"})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(funcCall, lower_string, "Lower", {"ABCDEFG"})
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(lookupCall, strcasecmp, "strcasecmp", {"abc", "ABD"})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(genericCall, strcasecmp, "strcasecmp", {"abc", "ABD"})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(funcCall, strcasecmp, "strcasecmp", {"abc", "ABD"})
+
+BENCHMARK_DRAW_LINE();
+
+// Without overloads
+BENCHMARK_NAMED_PARAM_MULTI(lookupCall, trim, "trim", {" abc "})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(genericCall, trim, "trim", {" abc "})
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(funcCall, trim, "trim", {" abc "})
 
 }   // namespace nebula
 
 int main(int argc, char** argv) {
-    nebula::ArgumentList* args = nebula::ArgumentList::make(&pool);
-    args->addArgument(nebula::ConstantExpression::make(&pool, 1));
-    nebula::expr = nebula::FunctionCallExpression::make(&pool, "abs", args);
-
     folly::init(&argc, &argv, true);
     folly::runBenchmarks();
 
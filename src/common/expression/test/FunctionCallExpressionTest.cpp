@@ -3,6 +3,7 @@
  * This source code is licensed under Apache 2.0 License,
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
+#include "common/expression/FoldConstantCallVisitor.h"
 #include "common/expression/test/TestBase.h"
 
 namespace nebula {
@@ -130,6 +131,104 @@ TEST_F(FunctionCallExpressionTest, FunctionCallToStringTest) {
         EXPECT_EQ(ep->toString(), "now()");
     }
 }
+
+static FunctionCallExpression *makeCall(ObjectPool *objPool,
+                                        const std::string &name,
+                                        const std::vector<Expression*> &args) {
+    auto *argList = ArgumentList::make(objPool, args.size());
+    for (auto *arg : args) {
+        argList->addArgument(arg);
+    }
+    return FunctionCallExpression::make(objPool, name, argList);
+}
+
+TEST_F(FunctionCallExpressionTest, FoldConstant) {
+    {
+        // upper(lower("ABC")) + "d"
+        auto *call = makeCall(
+            &pool, "upper", {makeCall(&pool, "lower", {ConstantExpression::make(&pool, "ABC")})});
+        auto *expr = ArithmeticExpression::makeAdd(&pool, call, ConstantExpression::make(&pool, "d"));
+        FoldConstantCallVisitor visitor;
+        EXPECT_EQ(expr, visitor.fold(expr));
+        EXPECT_EQ(2UL, visitor.numFolded());
+        ASSERT_EQ(Expression::Kind::kConstant, expr->left()->kind());
+        EXPECT_EQ(Value("ABC"), static_cast<ConstantExpression*>(expr->left())->value());
+        EXPECT_EQ(Value("ABCd"), Expression::eval(expr, gExpCtxt));
+    }
+    {
+        // the root itself
+        auto *expr = makeCall(&pool, "abs", {ConstantExpression::make(&pool, -1)});
+        FoldConstantCallVisitor visitor;
+        auto *folded = visitor.fold(expr);
+        ASSERT_EQ(Expression::Kind::kConstant, folded->kind());
+        EXPECT_EQ(Value(1), static_cast<ConstantExpression*>(folded)->value());
+    }
+    {
+        // impure or not over constants
+        std::vector<Expression*> exprs = {
+            makeCall(&pool, "rand", {}),
+            makeCall(&pool, "date", {}),
+            makeCall(&pool, "lower", {EdgePropertyExpression::make(&pool, "e1", "string16")}),
+            makeCall(&pool, "abs", {makeCall(&pool, "rand32", {})}),
+        };
+        for (auto *expr : exprs) {
+            FoldConstantCallVisitor visitor;
+            EXPECT_EQ(expr, visitor.fold(expr));
+            EXPECT_EQ(0UL, visitor.numFolded()) << expr->toString();
+        }
+        // pure with arguments
+        auto *expr = makeCall(&pool, "date", {ConstantExpression::make(&pool, "2020-01-01")});
+        FoldConstantCallVisitor visitor;
+        EXPECT_EQ(Expression::Kind::kConstant, visitor.fold(expr)->kind());
+    }
+}
+
+TEST_F(FunctionCallExpressionTest, Memo) {
+    auto *expr = makeCall(&pool, "abs", {VariableExpression::make(&pool, "n")});
+    expr->setMemoCapacity(4);
+    std::vector<std::pair<Value, Value>> cases = {
+        {-1, 1}, {2, 2}, {-1, 1}, {-1.0, 1.0}, {1, 1}, {1.0, 1.0},
+        {-3, 3}, {-4, 4}, {-5, 5}, {2, 2}, {"a", Value::kNullBadType}, {-1, 1},
+    };
+    for (auto &c : cases) {
+        gExpCtxt.setVar("n", c.first);
+        auto result = Expression::eval(expr, gExpCtxt);
+        EXPECT_EQ(c.second.type(), result.type()) << c.first;
+        EXPECT_EQ(c.second, result) << c.first;
+    }
+    // Not memoized for impure functions
+    auto *rand = makeCall(&pool, "rand32", {ConstantExpression::make(&pool, 1000000)});
+    rand->setMemoCapacity(4);
+    std::unordered_set<Value> results;
+    for (auto i = 0; i < 10; i++) {
+        results.emplace(Expression::eval(rand, gExpCtxt));
+    }
+    EXPECT_LT(1UL, results.size());
+}
+
+TEST_F(FunctionCallExpressionTest, AddArguments) {
+    {
+        // Builtins with an id at the arity 0
+        auto *rand = FunctionCallExpression::make(&pool, "rand32");
+        rand->args()->addArgument(ConstantExpression::make(&pool, 1));
+        EXPECT_EQ(Value(0), Expression::eval(rand, gExpCtxt));
+        rand->args()->addArgument(ConstantExpression::make(&pool, 2));
+        EXPECT_EQ(Value(1), Expression::eval(rand, gExpCtxt));
+
+        auto *date = FunctionCallExpression::make(&pool, "date");
+        EXPECT_EQ(Value::Type::DATE, Expression::eval(date, gExpCtxt).type());
+        date->args()->addArgument(ConstantExpression::make(&pool, "2020-01-01"));
+        EXPECT_EQ(Value(Date(2020, 1, 1)), Expression::eval(date, gExpCtxt));
+    }
+    {
+        // Not resolved at all before
+        auto *abs = FunctionCallExpression::make(&pool, "abs");
+        abs->setMemoCapacity(4);
+        abs->args()->addArgument(ConstantExpression::make(&pool, -1));
+        EXPECT_EQ(Value(1), Expression::eval(abs, gExpCtxt));
+        EXPECT_EQ(Value(1), Expression::eval(abs, gExpCtxt));
+    }
+}
 }   // namespace nebula
 
 int main(int argc, char **argv) {
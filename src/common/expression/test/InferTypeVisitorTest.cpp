@@ -0,0 +1,126 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/test/TestBase.h"
+#include "common/expression/InferTypeVisitor.h"
+
+namespace nebula {
+
+class InferTypeVisitorTest : public ExpressionTest {};
+
+TEST_F(InferTypeVisitorTest, Infer) {
+    InferTypeVisitor visitor([] (const PropertyExpression *expr) {
+        return expr->prop() == "likeness" ? Value::Type::INT : Value::Type::__EMPTY__;
+    });
+    // abs(-1) + 2 * like.likeness
+    auto *absCall = FunctionCallExpression::make(&pool, "abs", ArgumentList::make(&pool));
+    absCall->args()->addArgument(ConstantExpression::make(&pool, -1));
+    auto *likeness = EdgePropertyExpression::make(&pool, "like", "likeness");
+    auto *mul = ArithmeticExpression::makeMultiply(&pool,
+                                                   ConstantExpression::make(&pool, 2),
+                                                   likeness);
+    auto *add = ArithmeticExpression::makeAdd(&pool, absCall, mul);
+    // 1.5 * 2
+    auto *mixed = ArithmeticExpression::makeMultiply(&pool,
+                                                     ConstantExpression::make(&pool, 1.5),
+                                                     ConstantExpression::make(&pool, 2));
+    // like.name == "Tim"
+    auto *name = RelationalExpression::makeEQ(&pool,
+                                              EdgePropertyExpression::make(&pool, "like", "name"),
+                                              ConstantExpression::make(&pool, "Tim"));
+    auto *gt = RelationalExpression::makeGT(&pool, add, ConstantExpression::make(&pool, 10));
+    auto *lt = RelationalExpression::makeLT(&pool, mixed, ConstantExpression::make(&pool, 3.5));
+    auto *expr = LogicalExpression::makeAnd(&pool, gt, lt);
+    expr->addOperand(name);
+    expr->accept(&visitor);
+
+    EXPECT_EQ(Value::Type::INT, visitor.typeOf(absCall));
+    EXPECT_EQ(Value::Type::INT, visitor.typeOf(likeness));
+    EXPECT_EQ(Value::Type::INT, visitor.typeOf(mul));
+    EXPECT_EQ(Value::Type::INT, visitor.typeOf(add));
+    EXPECT_EQ(Value::Type::FLOAT, visitor.typeOf(mixed));
+    EXPECT_EQ(Value::Type::BOOL, visitor.typeOf(name));
+    EXPECT_EQ(Value::Type::BOOL, visitor.typeOf(expr));
+    EXPECT_EQ(Value::Type::__EMPTY__, visitor.typeOf(name->left()));
+
+    // mul, add, > and <
+    EXPECT_EQ(4, visitor.numSpecialized());
+    EXPECT_EQ(Value::Type::INT, add->specializedType());
+    EXPECT_EQ(Value::Type::__EMPTY__, mixed->specializedType());
+    EXPECT_EQ(Value::Type::__EMPTY__, name->specializedType());
+    EXPECT_EQ(Value::Type::INT, gt->specializedType());
+    EXPECT_EQ(Value::Type::FLOAT, lt->specializedType());
+}
+
+TEST_F(InferTypeVisitorTest, SameAsGeneric) {
+    std::vector<std::pair<Value, Value>> operands = {
+        {1, 2},
+        {-3, -3},
+        {std::numeric_limits<int64_t>::max(), 1},
+        {std::numeric_limits<int64_t>::min(), -1},
+        {1.0, 1.0 + 1e-9},
+        {1.0, 2.5},
+        {-0.5, std::numeric_limits<double>::quiet_NaN()},
+        {"abc", "abd"},
+        {"abc", "abc"},
+        {"", "a"},
+        {1, 1.0},
+        {Value::kNullValue, 1},
+        {"a", Value::kNullValue},
+    };
+    std::vector<Expression::Kind> arithmetic = {
+        Expression::Kind::kAdd, Expression::Kind::kMinus, Expression::Kind::kMultiply,
+    };
+    std::vector<Expression::Kind> relational = {
+        Expression::Kind::kRelEQ, Expression::Kind::kRelNE, Expression::Kind::kRelLT,
+        Expression::Kind::kRelLE, Expression::Kind::kRelGT, Expression::Kind::kRelGE,
+    };
+    auto isSame = [] (const Value &lhs, const Value &rhs) {
+        return lhs.type() == rhs.type() &&
+               (lhs.type() == Value::Type::FLOAT
+                    ? std::isnan(lhs.getFloat()) == std::isnan(rhs.getFloat()) &&
+                      (std::isnan(lhs.getFloat()) || lhs.getFloat() == rhs.getFloat())
+                    : lhs == rhs);
+    };
+    for (auto &operand : operands) {
+        for (auto type : {Value::Type::INT, Value::Type::FLOAT, Value::Type::STRING}) {
+            for (auto kind : arithmetic) {
+                auto *generic = ArithmeticExpression::makeKind(
+                    &pool, kind,
+                    ConstantExpression::make(&pool, operand.first),
+                    ConstantExpression::make(&pool, operand.second));
+                auto *specialized = static_cast<ArithmeticExpression*>(generic->clone());
+                specialized->specialize(type);
+                auto expected = Expression::eval(generic, gExpCtxt);
+                auto result = Expression::eval(specialized, gExpCtxt);
+                EXPECT_TRUE(isSame(expected, result))
+                    << specialized->toString() << ": " << expected << " vs. " << result;
+            }
+            for (auto kind : relational) {
+                auto *generic = RelationalExpression::makeKind(
+                    &pool, kind,
+                    ConstantExpression::make(&pool, operand.first),
+                    ConstantExpression::make(&pool, operand.second));
+                auto *specialized = static_cast<RelationalExpression*>(generic->clone());
+                specialized->specialize(type);
+                auto expected = Expression::eval(generic, gExpCtxt);
+                auto result = Expression::eval(specialized, gExpCtxt);
+                EXPECT_TRUE(isSame(expected, result))
+                    << specialized->toString() << ": " << expected << " vs. " << result;
+            }
+        }
+    }
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
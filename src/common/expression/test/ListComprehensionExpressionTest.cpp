@@ -73,6 +73,67 @@ TEST_F(ListComprehensionExpressionTest, ListComprehensionEvaluate) {
     }
 }
 
+TEST_F(ListComprehensionExpressionTest, NestedScopes) {
+    auto makeList = [] (std::vector<Expression*> items) {
+        auto listItems = ExpressionList::make(&pool);
+        for (auto *item : items) {
+            listItems->add(item);
+        }
+        return ListExpression::make(&pool, listItems);
+    };
+    {
+        // [m IN [1, 2] | [n IN [10, 20] | m + n]]
+        auto inner = ListComprehensionExpression::make(
+            &pool,
+            "n",
+            makeList({ConstantExpression::make(&pool, 10), ConstantExpression::make(&pool, 20)}),
+            nullptr,
+            ArithmeticExpression::makeAdd(&pool,
+                                          VariableExpression::make(&pool, "m"),
+                                          VariableExpression::make(&pool, "n")));
+        auto expr = ListComprehensionExpression::make(
+            &pool,
+            "m",
+            makeList({ConstantExpression::make(&pool, 1), ConstantExpression::make(&pool, 2)}),
+            nullptr,
+            inner);
+
+        List expected({Value(List({11, 21})), Value(List({12, 22}))});
+        for (auto i = 0; i < 2; i++) {
+            auto value = Expression::eval(expr, gExpCtxt);
+            ASSERT_TRUE(value.isList());
+            ASSERT_EQ(expected, value.getList());
+            ASSERT_EQ(0, gExpCtxt.numLocals());
+        }
+    }
+    {
+        // [n IN [1, 2, 3] | [n IN [n, n * 10] WHERE n > 5]], the inner `n' shadows the outer one
+        auto inner = ListComprehensionExpression::make(
+            &pool,
+            "n",
+            makeList({VariableExpression::make(&pool, "n"),
+                      ArithmeticExpression::makeMultiply(&pool,
+                                                         VariableExpression::make(&pool, "n"),
+                                                         ConstantExpression::make(&pool, 10))}),
+            RelationalExpression::makeGT(
+                &pool, VariableExpression::make(&pool, "n"), ConstantExpression::make(&pool, 5)));
+        auto expr = ListComprehensionExpression::make(
+            &pool,
+            "n",
+            makeList({ConstantExpression::make(&pool, 1),
+                      ConstantExpression::make(&pool, 2),
+                      ConstantExpression::make(&pool, 3)}),
+            nullptr,
+            inner);
+
+        List expected({Value(List({10})), Value(List({20})), Value(List({30}))});
+        auto value = Expression::eval(expr, gExpCtxt);
+        ASSERT_TRUE(value.isList());
+        ASSERT_EQ(expected, value.getList());
+        ASSERT_EQ(0, gExpCtxt.numLocals());
+    }
+}
+
 TEST_F(ListComprehensionExpressionTest, ListComprehensionExprToString) {
     {
         ArgumentList *argList = ArgumentList::make(&pool);
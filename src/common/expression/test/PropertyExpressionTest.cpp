@@ -3,6 +3,7 @@
  * This source code is licensed under Apache 2.0 License,
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
+#include "common/expression/BindSlotVisitor.h"
 #include "common/expression/test/TestBase.h"
 
 namespace nebula {
@@ -127,6 +128,58 @@ TEST_F(PropertyExpressionTest, PropertyToStringTest) {
         EXPECT_EQ(ep->toString(), "like._dst");
     }
 }
+
+TEST_F(PropertyExpressionTest, SlotBinding) {
+    ExpressionContextMock ctx(true);
+    // e1.int == 1 AND $^.source.srcProperty > 10
+    auto *expr = LogicalExpression::makeAnd(
+        &pool,
+        RelationalExpression::makeEQ(&pool,
+                                     EdgePropertyExpression::make(&pool, "e1", "int"),
+                                     ConstantExpression::make(&pool, 1)),
+        RelationalExpression::makeGT(
+            &pool,
+            SourcePropertyExpression::make(&pool, "source", "srcProperty"),
+            ConstantExpression::make(&pool, 10)));
+    {
+        BindSlotVisitor binder(ctx);
+        expr->accept(&binder);
+        EXPECT_EQ(2UL, binder.numBound());
+        // Resolved only once
+        auto resolved = ExpressionContextMock::numResolved();
+        for (auto i = 0; i < 100; i++) {
+            EXPECT_EQ(Value(true), Expression::eval(expr, ctx));
+        }
+        EXPECT_EQ(resolved, ExpressionContextMock::numResolved());
+    }
+    {
+        // Rebound lazily once the slots of the context change
+        auto resolved = ExpressionContextMock::numResolved();
+        ctx.setVar("n", Value(1));
+        for (auto i = 0; i < 100; i++) {
+            EXPECT_EQ(Value(true), Expression::eval(expr, ctx));
+        }
+        EXPECT_EQ(resolved + 2, ExpressionContextMock::numResolved());
+    }
+    {
+        // Fall back to the getters by name
+        auto *ep = TagPropertyExpression::make(&pool, "t1", "not_exist");
+        EXPECT_EQ(Value::kNullValue, Expression::eval(ep, ctx));
+        EXPECT_EQ(ExpressionContext::kNoSlot, ep->slot());
+    }
+    {
+        // Bound to the slots of another context, and read by name from one without slots
+        auto resolved = ExpressionContextMock::numResolved();
+        EXPECT_EQ(Value(true), Expression::eval(expr, gExpCtxt));
+        auto *ep = EdgePropertyExpression::make(&pool, "e1", "int");
+        EXPECT_EQ(Value(1), Expression::eval(ep, gExpCtxt));
+        EXPECT_EQ(ExpressionContext::kNoSlot, ep->slot());
+        BindSlotVisitor binder(gExpCtxt);
+        expr->accept(&binder);
+        EXPECT_EQ(0UL, binder.numBound());
+        EXPECT_EQ(resolved, ExpressionContextMock::numResolved());
+    }
+}
 }   // namespace nebula
 
 int main(int argc, char **argv) {
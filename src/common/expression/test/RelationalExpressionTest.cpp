@@ -816,6 +816,19 @@ TEST_F(RelationalExpressionTest, RelationContains) {
         EXPECT_EQ(eval.type(), Value::Type::NULLVALUE);
         EXPECT_EQ(eval, Value::kNullBadType);
     }
+    {
+        // The searcher prepared for the constant follows it when it is changed
+        auto *pattern = ConstantExpression::make(&pool, std::string(40, 'a'));
+        auto *expr = RelationalExpression::makeContains(
+            &pool, ConstantExpression::make(&pool, std::string(50, 'a')), pattern);
+        EXPECT_EQ(Expression::eval(expr, gExpCtxt), true);
+        pattern->setValue(std::string(40, 'b'));
+        EXPECT_EQ(Expression::eval(expr, gExpCtxt), false);
+        expr->setRight(ConstantExpression::make(&pool, std::string(45, 'a')));
+        EXPECT_EQ(Expression::eval(expr, gExpCtxt), true);
+        static_cast<BinaryExpression*>(expr)->setRight(ConstantExpression::make(&pool, "c"));
+        EXPECT_EQ(Expression::eval(expr, gExpCtxt), false);
+    }
 }
 
 TEST_F(RelationalExpressionTest, RelationStartsWith) {
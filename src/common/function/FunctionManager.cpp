@@ -4,11 +4,13 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
-#include <boost/algorithm/string/replace.hpp>
+#include <dlfcn.h>
 
 #include "FunctionManager.h"
 
 #include "common/base/Base.h"
+#include "common/base/MurmurHash2.h"
+#include "common/base/StringKernels.h"
 #include "common/datatypes/DataSet.h"
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/List.h"
@@ -17,12 +19,59 @@
 #include "common/datatypes/Set.h"
 #include "common/datatypes/Vertex.h"
 #include "common/expression/Expression.h"
+#include "common/function/UdfAbi.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/time/TimeUtils.h"
 #include "common/time/WallClock.h"
 
 namespace nebula {
 
+/**
+ * A dlopen-ed shared object, which is closed on destruction.
+ */
+class FunctionManager::Library final {
+public:
+    static StatusOr<std::shared_ptr<const Library>> open(const std::string &soname) {
+        auto *handle = ::dlopen(soname.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == nullptr) {
+            return Status::Error("Failed to open `%s': %s", soname.c_str(), ::dlerror());
+        }
+        auto library = std::shared_ptr<Library>(new Library(soname, handle));
+        auto entry = reinterpret_cast<nebula_udf_entry_fn>(::dlsym(handle, NEBULA_UDF_ENTRY_NAME));
+        if (entry == nullptr) {
+            return Status::Error("Symbol `%s' not found in `%s'",
+                                 NEBULA_UDF_ENTRY_NAME, soname.c_str());
+        }
+        library->module_ = entry();
+        if (library->module_ == nullptr) {
+            return Status::Error("No module provided by `%s'", soname.c_str());
+        }
+        if (library->module_->abiVersion != NEBULA_UDF_ABI_VERSION) {
+            return Status::Error("ABI version of `%s' mismatch: %u, but %u expected",
+                                 soname.c_str(),
+                                 library->module_->abiVersion,
+                                 NEBULA_UDF_ABI_VERSION);
+        }
+        return library;
+    }
+
+    ~Library() {
+        VLOG(1) << "Close the shared object " << soname_;
+        ::dlclose(handle_);
+    }
+
+    const nebula_udf_module* module() const {
+        return module_;
+    }
+
+private:
+    Library(const std::string &soname, void *handle) : soname_(soname), handle_(handle) {}
+
+    std::string                     soname_;
+    void                           *handle_{nullptr};
+    const nebula_udf_module        *module_{nullptr};
+};
+
 // static
 FunctionManager &FunctionManager::instance() {
     static FunctionManager instance;
@@ -244,12 +293,23 @@ FunctionManager::getReturnType(const std::string& funcName,
                                const std::vector<Value::Type> &argsType) {
     auto func = funcName;
     std::transform(func.begin(), func.end(), func.begin(), ::tolower);
+    std::vector<TypeSignature> dynamicSignatures;
+    const std::vector<TypeSignature> *signatures = nullptr;
     auto iter = typeSignature_.find(func);
-    if (iter == typeSignature_.end()) {
-        return Status::Error("Function `%s' not defined", funcName.c_str());
+    if (iter != typeSignature_.end()) {
+        signatures = &iter->second;
+    } else {
+        auto &manager = instance();
+        folly::RWSpinLock::ReadHolder holder(manager.lock_);
+        auto found = manager.dynamicFunctions_.find(func);
+        if (found == manager.dynamicFunctions_.end()) {
+            return Status::Error("Function `%s' not defined", funcName.c_str());
+        }
+        dynamicSignatures = found->second->signatures_;
+        signatures = &dynamicSignatures;
     }
 
-    for (const auto &args : iter->second) {
+    for (const auto &args : *signatures) {
         if (argsType == args.argsType_) {
             return args.returnType_;
         }
@@ -267,6 +327,56 @@ FunctionManager::getReturnType(const std::string& funcName,
     return Status::Error("Parameter's type error");
 }
 
+namespace {
+
+/**
+ * The hash of hash(), which is frozen as std::hash<Value> was before the strings of Value
+ * were hashed by WyHash, since the results might have been stored. It was built with
+ * libstdc++ on 64-bit, where std::hash of a string or a nonzero double is MurmurHash2
+ * of the bytes, so that it stays the same with any other standard library.
+ */
+size_t frozenHash(const Value &v) {
+    switch (v.type()) {
+        case Value::Type::__EMPTY__:
+            return 0;
+        case Value::Type::NULLVALUE:
+            return ~0UL;
+        case Value::Type::BOOL:
+            return v.getBool();
+        case Value::Type::INT:
+            return static_cast<size_t>(v.getInt());
+        case Value::Type::FLOAT: {
+            auto f = v.getFloat();
+            return f == 0.0 ? 0 : MurmurHash2()(reinterpret_cast<const char*>(&f), sizeof(f));
+        }
+        case Value::Type::STRING:
+            return MurmurHash2()(v.getStr());
+        case Value::Type::LIST: {
+            size_t seed = 0;
+            for (const auto &item : v.getList().values) {
+                seed ^= frozenHash(item) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+        case Value::Type::DATETIME: {
+            // The qword of the layout from the year at the least significant bits
+            const auto &dt = v.getDateTime();
+            return static_cast<uint64_t>(static_cast<uint16_t>(dt.year)) |
+                   static_cast<uint64_t>(dt.month) << 16 |
+                   static_cast<uint64_t>(dt.day) << 20 |
+                   static_cast<uint64_t>(dt.hour) << 25 |
+                   static_cast<uint64_t>(dt.minute) << 30 |
+                   static_cast<uint64_t>(dt.sec) << 36 |
+                   static_cast<uint64_t>(dt.microsec) << 42;
+        }
+        default:
+            // Not frozen, but left to std::hash<Value>
+            return std::hash<Value>()(v);
+    }
+}
+
+}   // namespace
+
 FunctionManager::FunctionManager() {
     {
         // absolute value
@@ -822,7 +932,7 @@ FunctionManager::FunctionManager() {
         auto &attr = functions_["rand"];
         attr.minArity_ = 0;
         attr.maxArity_ = 0;
-        attr.isPure_ = true;
+        attr.isPure_ = false;
         attr.body_ = [](const auto &args) -> Value {
             UNUSED(args);
             return folly::Random::randDouble01();
@@ -931,9 +1041,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    std::string value(args[0].get().getStr());
-                    folly::toLowerAscii(value);
-                    return value;
+                    return strings::toLower(args[0].get().getStr());
                 }
                 default: {
                     return Value::kNullBadType;
@@ -953,11 +1061,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    std::string value(args[0].get().getStr());
-                    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
-                        return std::toupper(c);
-                    });
-                    return value;
+                    return strings::toUpper(args[0].get().getStr());
                 }
                 default: {
                     return Value::kNullBadType;
@@ -977,11 +1081,10 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    auto value = args[0].get().getStr();
-                    return static_cast<int64_t>(value.length());
+                    return static_cast<int64_t>(args[0].get().getStr().length());
                 }
                 case Value::Type::PATH: {
-                    auto path = args[0].get().getPath();
+                    auto &path = args[0].get().getPath();
                     return static_cast<int64_t>(path.steps.size());
                 }
                 default: {
@@ -1001,8 +1104,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    std::string value(args[0].get().getStr());
-                    return folly::trimWhitespace(value).toString();
+                    return folly::trimWhitespace(args[0].get().getStr()).toString();
                 }
                 default: {
                     return Value::kNullBadType;
@@ -1021,8 +1123,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    std::string value(args[0].get().getStr());
-                    return folly::ltrimWhitespace(value).toString();
+                    return folly::ltrimWhitespace(args[0].get().getStr()).toString();
                 }
                 default: {
                     return Value::kNullBadType;
@@ -1041,8 +1142,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    std::string value(args[0].get().getStr());
-                    return folly::rtrimWhitespace(value).toString();
+                    return folly::rtrimWhitespace(args[0].get().getStr()).toString();
                 }
                 default: {
                     return Value::kNullBadType;
@@ -1120,10 +1220,9 @@ FunctionManager::FunctionManager() {
                 return Value::kNullValue;
             }
             if (args[0].get().isStr() && args[1].get().isStr() && args[2].get().isStr()) {
-                std::string origStr(args[0].get().getStr());
-                std::string search(args[1].get().getStr());
-                std::string newStr(args[2].get().getStr());
-                return boost::replace_all_copy(origStr, search, newStr);
+                return strings::replaceAll(args[0].get().getStr(),
+                                           args[1].get().getStr(),
+                                           args[2].get().getStr());
             }
             return Value::kNullBadType;
         };
@@ -1139,9 +1238,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::STRING: {
-                    std::string origStr(args[0].get().getStr());
-                    std::reverse(origStr.begin(), origStr.end());
-                    return origStr;
+                    return strings::reverse(args[0].get().getStr());
                 }
                 case Value::Type::LIST: {
                     auto& list = args[0].get().getList();
@@ -1172,11 +1269,12 @@ FunctionManager::FunctionManager() {
                     if (!args[1].get().isStr()) {
                         return Value::kNullBadType;
                     }
-                    std::string origStr(args[0].get().getStr());
-                    std::string delim(args[1].get().getStr());
-                    List res;
                     std::vector<folly::StringPiece> substrings;
-                    folly::split<folly::StringPiece>(delim, origStr, substrings);
+                    folly::split<folly::StringPiece>(args[1].get().getStr(),
+                                                     args[0].get().getStr(),
+                                                     substrings);
+                    List res;
+                    res.values.reserve(substrings.size());
                     for (auto str : substrings) {
                         res.emplace_back(str.toString());
                     }
@@ -1263,24 +1361,11 @@ FunctionManager::FunctionManager() {
         attr.isPure_ = true;
         attr.body_ = [](const auto &args) -> Value {
             if (args[0].get().isStr() && args[1].get().isInt() && args[2].get().isStr()) {
-                auto value = args[0].get().getStr();
                 auto size = args[1].get().getInt();
                 if (size < 0) {
                     return std::string("");
-                } else if (size < static_cast<int64_t>(value.size())) {
-                    return value.substr(0, static_cast<int32_t>(size));
-                } else {
-                    auto extra = args[2].get().getStr();
-                    size -= value.size();
-                    std::stringstream stream;
-                    while (size > static_cast<int64_t>(extra.size())) {
-                        stream << extra;
-                        size -= extra.size();
-                    }
-                    stream << extra.substr(0, size);
-                    stream << value;
-                    return stream.str();
                 }
+                return strings::pad(args[0].get().getStr(), size, args[2].get().getStr(), true);
             }
             return Value::kNullBadType;
         };
@@ -1292,25 +1377,11 @@ FunctionManager::FunctionManager() {
         attr.isPure_ = true;
         attr.body_ = [](const auto &args) -> Value {
             if (args[0].get().isStr() && args[1].get().isInt() && args[2].get().isStr()) {
-                auto value = args[0].get().getStr();
-                if (args[1].get().getInt() < 0) {
-                    return "";
-                }
-                size_t size = args[1].get().getInt();
-                if (size < value.size()) {
-                    return value.substr(0, static_cast<int32_t>(size));
-                } else {
-                    auto extra = args[2].get().getStr();
-                    std::stringstream stream;
-                    stream << value;
-                    size -= value.size();
-                    while (size > extra.size()) {
-                        stream << extra;
-                        size -= extra.size();
-                    }
-                    stream << extra.substr(0, size);
-                    return stream.str();
+                auto size = args[1].get().getInt();
+                if (size < 0) {
+                    return std::string("");
                 }
+                return strings::pad(args[0].get().getStr(), size, args[2].get().getStr(), false);
             }
             return Value::kNullBadType;
         };
@@ -1330,7 +1401,7 @@ FunctionManager::FunctionManager() {
                 (argSize == 3 && !args[2].get().isInt())) {
                 return Value::kNullBadType;
             }
-            auto value = args[0].get().getStr();
+            auto &value = args[0].get().getStr();
             auto start = args[1].get().getInt();
             auto length = 0;
             if (argSize == 3) {
@@ -1370,7 +1441,7 @@ FunctionManager::FunctionManager() {
                 case Value::Type::EDGE:
                 case Value::Type::PATH:
                 case Value::Type::LIST: {
-                    return static_cast<int64_t>(std::hash<nebula::Value>()(args[0].get()));
+                    return static_cast<int64_t>(frozenHash(args[0].get()));
                 }
                 default:
                     LOG(ERROR) << "Hash has not been implemented for " << args[0].get().type();
@@ -1483,6 +1554,7 @@ FunctionManager::FunctionManager() {
         attr.minArity_ = 0;
         attr.maxArity_ = 1;
         attr.isPure_ = false;
+        attr.isPureWithArgs_ = true;
         attr.body_ = [](const auto &args) -> Value {
             switch (args.size()) {
                 case 0: {
@@ -1521,6 +1593,7 @@ FunctionManager::FunctionManager() {
         attr.minArity_ = 0;
         attr.maxArity_ = 1;
         attr.isPure_ = false;
+        attr.isPureWithArgs_ = true;
         attr.body_ = [](const auto &args) -> Value {
             switch (args.size()) {
                 case 0: {
@@ -1555,6 +1628,7 @@ FunctionManager::FunctionManager() {
         attr.minArity_ = 0;
         attr.maxArity_ = 1;
         attr.isPure_ = false;
+        attr.isPureWithArgs_ = true;
         attr.body_ = [](const auto &args) -> Value {
             switch (args.size()) {
                 case 0: {
@@ -1587,6 +1661,7 @@ FunctionManager::FunctionManager() {
         attr.minArity_ = 0;
         attr.maxArity_ = 1;
         attr.isPure_ = false;
+        attr.isPureWithArgs_ = true;
         attr.body_ = [](const auto &args) -> Value {
             if (args.size() == 0) {
                 return time::WallClock::fastNowInSec();
@@ -1684,13 +1759,15 @@ FunctionManager::FunctionManager() {
                 case Value::Type::VERTEX: {
                     Map props;
                     for (auto& tag : args[0].get().getVertex().tags) {
-                        props.kvs.insert(tag.props.cbegin(), tag.props.cend());
+                        for (auto& prop : tag.props) {
+                            props.kvs.emplace(prop.first, prop.second);
+                        }
                     }
                     return Value(std::move(props));
                 }
                 case Value::Type::EDGE: {
                     Map props;
-                    props.kvs = args[0].get().getEdge().props;
+                    props.kvs = args[0].get().getEdge().props.toMap();
                     return Value(std::move(props));
                 }
                 case Value::Type::MAP: {
@@ -1966,6 +2043,7 @@ FunctionManager::FunctionManager() {
                 case Value::Type::PATH: {
                     auto &path = args[0].get().getPath();
                     List result;
+                    result.values.reserve(path.steps.size() + 1);
                     result.emplace_back(path.src);
                     for (auto &step : path.steps) {
                         result.emplace_back(step.dst);
@@ -2014,15 +2092,16 @@ FunctionManager::FunctionManager() {
                 case Value::Type::PATH: {
                     auto &path = args[0].get().getPath();
                     List result;
+                    result.values.reserve(path.steps.size());
                     auto src = path.src.vid;
-                    for (size_t i = 0; i < path.steps.size(); ++i) {
+                    for (const auto &step : path.steps) {
                         Edge edge;
                         edge.src = src;
-                        edge.dst = path.steps[i].dst.vid;
-                        edge.type = path.steps[i].type;
-                        edge.name = path.steps[i].name;
-                        edge.ranking = path.steps[i].ranking;
-                        edge.props = path.steps[i].props;
+                        edge.dst = step.dst.vid;
+                        edge.type = step.type;
+                        edge.name = step.name;
+                        edge.ranking = step.ranking;
+                        edge.props = step.props;
 
                         src = edge.dst;
                         result.values.emplace_back(std::move(edge));
@@ -2070,9 +2149,7 @@ FunctionManager::FunctionManager() {
             if (!args[0].get().isPath()) {
                 return Value::kNullBadType;
             }
-            auto path = args[0].get().getPath();
-            path.reverse();
-            return path;
+            return args[0].get().getPath().reversed();
         };
     }
     {
@@ -2105,13 +2182,153 @@ FunctionManager::FunctionManager() {
             return ds.rows[rowIndex][colIndex];
         };
     }
+
+    addOverloads();
 }   // NOLINT
 
+void FunctionManager::addOverload(const std::string &func,
+                                  std::vector<Value::Type> argsType,
+                                  TypedFunction body) {
+    auto iter = ids_.find(func);
+    CHECK(iter != ids_.end()) << func;
+    if (folly::kIsDebug) {
+        auto signatures = typeSignature_.find(func);
+        CHECK(signatures != typeSignature_.end()) << func;
+        CHECK(std::any_of(signatures->second.begin(), signatures->second.end(),
+                          [&argsType] (const auto &sig) { return sig.argsType_ == argsType; }))
+            << "Overload of `" << func << "' mismatches the type signatures";
+    }
+    overloads_[iter->second].emplace_back(Overload{std::move(argsType), body});
+}
+
+void FunctionManager::addOverloads() {
+    for (auto &func : functions_) {
+        auto id = static_cast<FunctionId>(ids_.size());
+        ids_.emplace(func.first, id);
+    }
+    overloads_.resize(ids_.size());
+
+    // The overloads below must behave the same as the generic bodies
+    addOverload("abs", {Value::Type::INT}, [] (const auto &args) -> Value {
+        return std::abs(args[0].get().getInt());
+    });
+    addOverload("abs", {Value::Type::FLOAT}, [] (const auto &args) -> Value {
+        return std::abs(args[0].get().getFloat());
+    });
+    addOverload("floor", {Value::Type::INT}, [] (const auto &args) -> Value {
+        return std::floor(args[0].get().getInt());
+    });
+    addOverload("floor", {Value::Type::FLOAT}, [] (const auto &args) -> Value {
+        return std::floor(args[0].get().getFloat());
+    });
+    addOverload("ceil", {Value::Type::INT}, [] (const auto &args) -> Value {
+        return std::ceil(args[0].get().getInt());
+    });
+    addOverload("ceil", {Value::Type::FLOAT}, [] (const auto &args) -> Value {
+        return std::ceil(args[0].get().getFloat());
+    });
+    addOverload("round", {Value::Type::INT}, [] (const auto &args) -> Value {
+        return std::round(args[0].get().getInt());
+    });
+    addOverload("round", {Value::Type::FLOAT}, [] (const auto &args) -> Value {
+        return std::round(args[0].get().getFloat());
+    });
+    addOverload("sqrt", {Value::Type::INT}, [] (const auto &args) -> Value {
+        auto val = args[0].get().getInt();
+        if (val < 0) {
+            return Value::kNullValue;
+        }
+        return std::sqrt(val);
+    });
+    addOverload("sqrt", {Value::Type::FLOAT}, [] (const auto &args) -> Value {
+        auto val = args[0].get().getFloat();
+        if (val < 0) {
+            return Value::kNullValue;
+        }
+        return std::sqrt(val);
+    });
+    for (auto *func : {"lower", "tolower"}) {
+        addOverload(func, {Value::Type::STRING}, [] (const auto &args) -> Value {
+            return strings::toLower(args[0].get().getStr());
+        });
+    }
+    for (auto *func : {"upper", "toupper"}) {
+        addOverload(func, {Value::Type::STRING}, [] (const auto &args) -> Value {
+            return strings::toUpper(args[0].get().getStr());
+        });
+    }
+    addOverload("length", {Value::Type::STRING}, [] (const auto &args) -> Value {
+        return static_cast<int64_t>(args[0].get().getStr().length());
+    });
+    addOverload("length", {Value::Type::PATH}, [] (const auto &args) -> Value {
+        return static_cast<int64_t>(args[0].get().getPath().steps.size());
+    });
+    addOverload("strcasecmp", {Value::Type::STRING, Value::Type::STRING},
+                [] (const auto &args) -> Value {
+        return static_cast<int64_t>(
+            ::strcasecmp(args[0].get().getStr().c_str(), args[1].get().getStr().c_str()));
+    });
+}
+
 // static
 StatusOr<FunctionManager::Function> FunctionManager::get(const std::string &func, size_t arity) {
     auto result = instance().getInternal(func, arity);
     NG_RETURN_IF_ERROR(result);
-    return result.value().body_;
+    return result.value()->body_;
+}
+
+// static
+StatusOr<FunctionManager::FunctionId>
+FunctionManager::getId(const std::string &func, size_t arity) {
+    auto &manager = instance();
+    auto iter = manager.ids_.find(func);
+    if (iter == manager.ids_.end()) {
+        iter = manager.ids_.find(toLower(func));
+        if (iter == manager.ids_.end()) {
+            return Status::Error("Builtin function `%s' not defined", func.c_str());
+        }
+    }
+    NG_RETURN_IF_ERROR(checkArity(iter->first, arity, manager.functions_.at(iter->first)));
+    return iter->second;
+}
+
+// static
+FunctionManager::TypedFunction
+FunctionManager::getOverload(FunctionId id, const std::vector<Value::Type> &argsType) {
+    auto &manager = instance();
+    DCHECK_LT(id, manager.overloads_.size());
+    for (auto &overload : manager.overloads_[id]) {
+        if (overload.argsType_ == argsType) {
+            return overload.body_;
+        }
+    }
+    return nullptr;
+}
+
+// static
+StatusOr<FunctionManager::BatchFunction>
+FunctionManager::getBatch(const std::string &func, size_t arity) {
+    auto result = instance().getInternal(func, arity);
+    NG_RETURN_IF_ERROR(result);
+    auto attr = std::move(result).value();
+    if (attr->batch_) {
+        return attr->batch_;
+    }
+    return [body = attr->body_] (const std::vector<const Value*> &columns,
+                                           size_t numRows,
+                                           std::vector<Value> &results) {
+        results.clear();
+        results.reserve(numRows);
+        std::vector<ArgType> args;
+        args.reserve(columns.size());
+        for (auto row = 0UL; row < numRows; row++) {
+            args.clear();
+            for (auto *column : columns) {
+                args.emplace_back(column[row]);
+            }
+            results.emplace_back(body(args));
+        }
+    };
 }
 
 // static
@@ -2124,21 +2341,47 @@ Status FunctionManager::find(const std::string &func, const size_t arity) {
 /*static*/ StatusOr<bool> FunctionManager::getIsPure(const std::string &func, size_t arity) {
     auto result = instance().getInternal(func, arity);
     NG_RETURN_IF_ERROR(result);
-    return result.value().isPure_;
+    auto &attr = result.value();
+    return attr->isPure_ || (arity > 0 && attr->isPureWithArgs_);
 }
 
-/*static*/ StatusOr<const FunctionManager::FunctionAttributes>
-FunctionManager::getInternal(std::string func,
-                             size_t arity) const {
-    // check existence
-    std::transform(func.begin(), func.end(), func.begin(), ::tolower);
-    auto iter = functions_.find(func);
-    if (iter == functions_.end()) {
+// static
+std::string FunctionManager::toLower(const std::string &func) {
+    auto lower = func;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower;
+}
+
+StatusOr<std::shared_ptr<const FunctionManager::FunctionAttributes>>
+FunctionManager::getInternal(const std::string &funcName, size_t arity) const {
+    // Names are mostly in lower case already
+    auto iter = functions_.find(funcName);
+    if (iter != functions_.end()) {
+        NG_RETURN_IF_ERROR(checkArity(funcName, arity, iter->second));
+        // Builtin ones live as long as the manager, so no ownership is shared
+        return std::shared_ptr<const FunctionAttributes>(std::shared_ptr<void>(), &iter->second);
+    }
+    auto func = toLower(funcName);
+    iter = functions_.find(func);
+    if (iter != functions_.end()) {
+        NG_RETURN_IF_ERROR(checkArity(func, arity, iter->second));
+        return std::shared_ptr<const FunctionAttributes>(std::shared_ptr<void>(), &iter->second);
+    }
+    folly::RWSpinLock::ReadHolder holder(lock_);
+    auto found = dynamicFunctions_.find(func);
+    if (found == dynamicFunctions_.end()) {
         return Status::Error("Function `%s' not defined", func.c_str());
     }
-    // check arity
-    auto minArity = iter->second.minArity_;
-    auto maxArity = iter->second.maxArity_;
+    NG_RETURN_IF_ERROR(checkArity(func, arity, *found->second));
+    return found->second;
+}
+
+// static
+Status FunctionManager::checkArity(const std::string &func,
+                                   size_t arity,
+                                   const FunctionAttributes &attr) {
+    auto minArity = attr.minArity_;
+    auto maxArity = attr.maxArity_;
     if (arity < minArity || arity > maxArity) {
         if (minArity == maxArity) {
             return Status::Error("Arity not match for function `%s': "
@@ -2155,7 +2398,7 @@ FunctionManager::getInternal(std::string func,
                                  maxArity);
         }
     }
-    return iter->second;
+    return Status::OK();
 }
 
 // static
@@ -2163,17 +2406,177 @@ Status FunctionManager::load(const std::string &name, const std::vector<std::str
     return instance().loadInternal(name, funcs);
 }
 
-Status FunctionManager::loadInternal(const std::string &, const std::vector<std::string> &) {
-    return Status::Error("Dynamic function loading not supported yet");
+Status FunctionManager::loadInternal(const std::string &soname,
+                                     const std::vector<std::string> &funcs) {
+    std::lock_guard<std::mutex> guard(loadLock_);
+    std::shared_ptr<const Library> library;
+    {
+        folly::RWSpinLock::ReadHolder holder(lock_);
+        auto iter = libraries_.find(soname);
+        if (iter != libraries_.end()) {
+            library = iter->second;
+        }
+    }
+    if (library == nullptr) {
+        auto result = Library::open(soname);
+        NG_RETURN_IF_ERROR(result);
+        library = std::move(result).value();
+    }
+
+    std::unordered_set<std::string> wanted;
+    for (auto func : funcs) {
+        std::transform(func.begin(), func.end(), func.begin(), ::tolower);
+        wanted.emplace(std::move(func));
+    }
+
+    std::unordered_map<std::string, FunctionAttributes> loaded;
+    const auto *module = library->module();
+    for (auto i = 0U; i < module->numFunctions; i++) {
+        const auto &desc = module->functions[i];
+        if (desc.name == nullptr) {
+            return Status::Error("Function without name in `%s'", soname.c_str());
+        }
+        std::string name = desc.name;
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (!wanted.empty() && wanted.count(name) == 0) {
+            continue;
+        }
+        auto attr = makeAttributes(library, desc);
+        NG_RETURN_IF_ERROR(attr);
+        if (!loaded.emplace(name, std::move(attr).value()).second) {
+            return Status::Error("Function `%s' defined twice in `%s'",
+                                 name.c_str(), soname.c_str());
+        }
+    }
+    for (auto &func : wanted) {
+        if (loaded.count(func) == 0) {
+            return Status::Error("Function `%s' not found in `%s'", func.c_str(), soname.c_str());
+        }
+    }
+
+    folly::RWSpinLock::WriteHolder holder(lock_);
+    for (auto &func : loaded) {
+        if (functions_.count(func.first) != 0 || dynamicFunctions_.count(func.first) != 0) {
+            return Status::Error("Function `%s' already exists", func.first.c_str());
+        }
+    }
+    for (auto &func : loaded) {
+        VLOG(1) << "Load function `" << func.first << "' from " << soname;
+        dynamicFunctions_.emplace(
+            func.first, std::make_shared<const FunctionAttributes>(std::move(func.second)));
+    }
+    libraries_.emplace(soname, std::move(library));
+    return Status::OK();
+}
+
+// static
+StatusOr<FunctionManager::FunctionAttributes>
+FunctionManager::makeAttributes(std::shared_ptr<const Library> library,
+                                const nebula_udf_function &desc) {
+    if (desc.scalar == nullptr) {
+        return Status::Error("Function `%s' has no scalar entry", desc.name);
+    }
+    if (desc.minArity > desc.maxArity) {
+        return Status::Error("Arity of function `%s' is invalid: %u-%u",
+                             desc.name, desc.minArity, desc.maxArity);
+    }
+
+    FunctionAttributes attr;
+    attr.minArity_ = desc.minArity;
+    attr.maxArity_ = desc.maxArity;
+    attr.isPure_ = desc.isPure != 0;
+    for (auto i = 0U; i < desc.numSignatures; i++) {
+        const auto &sig = desc.signatures[i];
+        if (sig.numArgs < desc.minArity || sig.numArgs > desc.maxArity) {
+            return Status::Error("Signature of function `%s' mismatch its arity", desc.name);
+        }
+        TypeSignature signature;
+        for (auto j = 0U; j < sig.numArgs; j++) {
+            signature.argsType_.emplace_back(static_cast<Value::Type>(sig.argTypes[j]));
+        }
+        signature.returnType_ = static_cast<Value::Type>(sig.returnType);
+        attr.signatures_.emplace_back(std::move(signature));
+    }
+
+    // Both the entries hold the shared object, in case of unloading while being called
+    attr.body_ = [library, scalar = desc.scalar] (const std::vector<ArgType> &args) -> Value {
+        std::vector<const nebula_udf_value*> argv;
+        argv.reserve(args.size());
+        for (auto &arg : args) {
+            argv.emplace_back(udf::handle(&arg.get()));
+        }
+        Value result;
+        scalar(argv.data(), argv.size(), udf::handle(&result));
+        return result;
+    };
+    if (desc.batch != nullptr) {
+        attr.batch_ = [library, batch = desc.batch] (const std::vector<const Value*> &columns,
+                                                      size_t numRows,
+                                                      std::vector<Value> &results) {
+            std::vector<const nebula_udf_value*> argv;
+            argv.reserve(columns.size());
+            for (auto *column : columns) {
+                argv.emplace_back(udf::handle(column));
+            }
+            results.clear();
+            results.resize(numRows);
+            batch(argv.data(), argv.size(), numRows, udf::handle(results.data()));
+        };
+    }
+    attr.library_ = std::move(library);
+    return attr;
 }
 
 // static
 Status FunctionManager::unload(const std::string &name, const std::vector<std::string> &funcs) {
-    return instance().loadInternal(name, funcs);
+    return instance().unloadInternal(name, funcs);
 }
 
-Status FunctionManager::unloadInternal(const std::string &, const std::vector<std::string> &) {
-    return Status::Error("Dynamic function unloading not supported yet");
+Status FunctionManager::unloadInternal(const std::string &soname,
+                                       const std::vector<std::string> &funcs) {
+    std::lock_guard<std::mutex> guard(loadLock_);
+    // Declared ahead of the holder to be released out of the lock,
+    // since the shared object might be closed then
+    std::shared_ptr<const Library> library;
+    folly::RWSpinLock::WriteHolder holder(lock_);
+    auto iter = libraries_.find(soname);
+    if (iter == libraries_.end()) {
+        return Status::Error("Shared object `%s' not loaded", soname.c_str());
+    }
+    auto belongs = [&iter] (const FunctionAttributes &attr) {
+        return attr.library_ == iter->second;
+    };
+
+    std::vector<std::string> toUnload;
+    if (funcs.empty()) {
+        for (auto &func : dynamicFunctions_) {
+            if (belongs(*func.second)) {
+                toUnload.emplace_back(func.first);
+            }
+        }
+    } else {
+        for (auto func : funcs) {
+            std::transform(func.begin(), func.end(), func.begin(), ::tolower);
+            auto found = dynamicFunctions_.find(func);
+            if (found == dynamicFunctions_.end() || !belongs(*found->second)) {
+                return Status::Error("Function `%s' not loaded from `%s'",
+                                     func.c_str(), soname.c_str());
+            }
+            toUnload.emplace_back(std::move(func));
+        }
+    }
+    for (auto &func : toUnload) {
+        VLOG(1) << "Unload function `" << func << "' of " << soname;
+        dynamicFunctions_.erase(func);
+    }
+
+    auto inUse = std::any_of(dynamicFunctions_.begin(), dynamicFunctions_.end(),
+                             [&belongs] (const auto &func) { return belongs(*func.second); });
+    if (!inUse) {
+        library = std::move(iter->second);
+        libraries_.erase(iter);
+    }
+    return Status::OK();
 }
 
 }   // namespace nebula
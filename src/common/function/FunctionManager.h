@@ -11,12 +11,18 @@
 #include "common/base/Status.h"
 #include "common/datatypes/Value.h"
 #include <folly/futures/Future.h>
+#include <folly/RWSpinLock.h>
+
+struct nebula_udf_function;
 
 /**
  * FunctionManager is for managing builtin and dynamic-loaded functions,
  * which users could use as function call expressions.
  *
- * TODO(dutor) To implement dynamic loading.
+ * Dynamic functions are loaded from shared objects conforming to UdfAbi.h.
+ * Each function obtained holds a reference to its shared object, so that
+ * the shared object is closed only after the unloading and the release of all
+ * the functions obtained before.
  */
 
 namespace nebula {
@@ -33,12 +39,45 @@ class FunctionManager final {
 public:
     using ArgType = std::reference_wrapper<const Value>;
     using Function = std::function<Value(const std::vector<ArgType>&)>;
+    /**
+     * Column-at-a-time calling convention.
+     * Each of `columns' points to `numRows' contiguous values of an argument,
+     * and `results' is filled with `numRows' values.
+     */
+    using BatchFunction = std::function<void(const std::vector<const Value*> &columns,
+                                             size_t numRows,
+                                             std::vector<Value> &results)>;
+    // Dense id of the builtin functions
+    using FunctionId = uint32_t;
+    /**
+     * An overload of a builtin function, specialized to the types of its arguments,
+     * which are not checked again.
+     */
+    using TypedFunction = Value (*)(const std::vector<ArgType>&);
 
     /**
      * To obtain a function named `func', with the actual arity.
      */
     static StatusOr<Function> get(const std::string &func, size_t arity);
 
+    /**
+     * To obtain the batch version of a function, which falls back to calling
+     * the scalar one row by row if the function has no batch entry point.
+     */
+    static StatusOr<BatchFunction> getBatch(const std::string &func, size_t arity);
+
+    /**
+     * To resolve a builtin function to its id once, for the repeated dispatching
+     * by `getOverload'.
+     */
+    static StatusOr<FunctionId> getId(const std::string &func, size_t arity);
+
+    /**
+     * To select the overload of the function `id' for the argument types,
+     * nullptr if there is none, then the generic body should be called.
+     */
+    static TypedFunction getOverload(FunctionId id, const std::vector<Value::Type> &argsType);
+
     /**
      * To Check the validity of the function named `func', with the actual arity.
      * Only used for parser check.
@@ -48,12 +87,15 @@ public:
     static StatusOr<bool> getIsPure(const std::string &func, size_t arity);
 
     /**
-     * To load a set of functions from a shared object dynamically.
+     * To load a set of functions from a shared object dynamically,
+     * all the functions of it if `funcs' is empty.
+     * Nothing is loaded if any of the functions fails.
      */
     static Status load(const std::string &soname, const std::vector<std::string> &funcs);
 
     /**
-     * To unload a shared object.
+     * To unload a set of functions of a shared object, all of them if `funcs' is empty.
+     * The shared object is closed once none of its functions is in use.
      */
     static Status unload(const std::string &soname, const std::vector<std::string> &funcs);
 
@@ -64,12 +106,20 @@ public:
                                                const std::vector<Value::Type> &argsType);
 
 private:
+    class Library;
+
     struct FunctionAttributes final {
         size_t minArity_{0};
         size_t maxArity_{0};
         // pure means same input same result
         bool     isPure_{true};
+        // pure unless called without arguments, e.g. `date()' is today
+        bool     isPureWithArgs_{false};
         Function body_;
+        // Only set for the dynamic functions
+        BatchFunction batch_;
+        std::vector<TypeSignature> signatures_;
+        std::shared_ptr<const Library> library_;
     };
 
     /**
@@ -79,8 +129,30 @@ private:
 
     static FunctionManager &instance();
 
-    StatusOr<const FunctionAttributes>
-    getInternal(std::string func, size_t arity) const;
+    struct Overload final {
+        std::vector<Value::Type> argsType_;
+        TypedFunction body_;
+    };
+
+    // To register an overload, whose argument types must be in `typeSignature_'
+    void addOverload(const std::string &func,
+                     std::vector<Value::Type> argsType,
+                     TypedFunction body);
+
+    void addOverloads();
+
+    static std::string toLower(const std::string &func);
+
+    // Builtin functions are returned without sharing the ownership
+    StatusOr<std::shared_ptr<const FunctionAttributes>>
+    getInternal(const std::string &func, size_t arity) const;
+
+    static Status checkArity(const std::string &func,
+                             size_t arity,
+                             const FunctionAttributes &attr);
+
+    static StatusOr<FunctionAttributes> makeAttributes(std::shared_ptr<const Library> library,
+                                                       const nebula_udf_function &desc);
 
     Status loadInternal(const std::string &soname, const std::vector<std::string> &funcs);
 
@@ -88,7 +160,17 @@ private:
 
     static std::unordered_map<std::string, std::vector<TypeSignature>> typeSignature_;
 
+    // Builtin functions, which are never changed after construction
     std::unordered_map<std::string, FunctionAttributes> functions_;
+    std::unordered_map<std::string, FunctionId> ids_;
+    // Indexed by id
+    std::vector<std::vector<Overload>> overloads_;
+
+    // To serialize the loading and unloading
+    std::mutex loadLock_;
+    mutable folly::RWSpinLock lock_;
+    std::unordered_map<std::string, std::shared_ptr<const FunctionAttributes>> dynamicFunctions_;
+    std::unordered_map<std::string, std::shared_ptr<const Library>> libraries_;
 };
 
 }   // namespace nebula
@@ -0,0 +1,117 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_FUNCTION_UDFABI_H_
+#define COMMON_FUNCTION_UDFABI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The binary interface between FunctionManager and the shared objects of
+ * user defined functions.
+ *
+ * A shared object exports `NEBULA_UDF_ENTRY', a C function returning a static
+ * `nebula_udf_module', which lists the functions it provides. The module is
+ * rejected if its `abiVersion' differs from `NEBULA_UDF_ABI_VERSION' of the loader,
+ * so bump the version on any incompatible change of the structures below.
+ *
+ * Values are passed as opaque `nebula_udf_value', which are `nebula::Value' of the
+ * loading process, so the shared object must be built against the same headers.
+ * It could refer to the symbols of the process, which is linked with `-rdynamic'.
+ *
+ * A function provides a scalar entry point, and optionally a batch one which is called
+ * with a column of values per argument. The batch entry point, if absent,
+ * is emulated by calling the scalar one row by row.
+ *
+ * All the entry points must be thread safe.
+ */
+
+#define NEBULA_UDF_ABI_VERSION      1
+#define NEBULA_UDF_ENTRY            nebula_udf_module_entry
+#define NEBULA_UDF_ENTRY_NAME       "nebula_udf_module_entry"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct nebula_udf_value nebula_udf_value;
+
+/**
+ * @args    `arity' arguments
+ * @result  an empty value to be assigned
+ */
+typedef void (*nebula_udf_scalar_fn)(const nebula_udf_value *const *args,
+                                     size_t arity,
+                                     nebula_udf_value *result);
+
+/**
+ * @columns `arity' columns, each of which points to `numRows' contiguous values
+ * @results `numRows' contiguous empty values to be assigned
+ */
+typedef void (*nebula_udf_batch_fn)(const nebula_udf_value *const *columns,
+                                    size_t arity,
+                                    size_t numRows,
+                                    nebula_udf_value *results);
+
+typedef struct nebula_udf_signature {
+    // Values of `nebula::Value::Type'
+    const uint64_t             *argTypes;
+    uint32_t                    numArgs;
+    uint64_t                    returnType;
+} nebula_udf_signature;
+
+typedef struct nebula_udf_function {
+    // Case insensitive, as the builtin ones
+    const char                 *name;
+    uint32_t                    minArity;
+    uint32_t                    maxArity;
+    // Whether the same arguments always give the same result
+    uint32_t                    isPure;
+    const nebula_udf_signature *signatures;
+    uint32_t                    numSignatures;
+    nebula_udf_scalar_fn        scalar;
+    // Optional
+    nebula_udf_batch_fn         batch;
+} nebula_udf_function;
+
+typedef struct nebula_udf_module {
+    uint32_t                    abiVersion;
+    const nebula_udf_function  *functions;
+    uint32_t                    numFunctions;
+} nebula_udf_module;
+
+typedef const nebula_udf_module *(*nebula_udf_entry_fn)(void);
+
+#ifdef __cplusplus
+}   // extern "C"
+
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace udf {
+
+inline const Value& value(const nebula_udf_value *v) {
+    return *reinterpret_cast<const Value*>(v);
+}
+
+inline Value& value(nebula_udf_value *v) {
+    return *reinterpret_cast<Value*>(v);
+}
+
+inline const nebula_udf_value* handle(const Value *v) {
+    return reinterpret_cast<const nebula_udf_value*>(v);
+}
+
+inline nebula_udf_value* handle(Value *v) {
+    return reinterpret_cast<nebula_udf_value*>(v);
+}
+
+}   // namespace udf
+}   // namespace nebula
+#endif
+
+#endif  // COMMON_FUNCTION_UDFABI_H_
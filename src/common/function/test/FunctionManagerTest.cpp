@@ -369,6 +369,23 @@ TEST_F(FunctionManagerTest, functionCall) {
         auto res = std::move(result).value()(genArgsRef({false}));
         EXPECT_EQ(res, 0);
     }
+    {
+        // The strings in a list are hashed as they used to be, as well as the bare ones
+        auto result = FunctionManager::get("hash", 1);
+        ASSERT_TRUE(result.ok());
+        auto hash = std::move(result).value();
+        auto res = hash(genArgsRef({List({"Hello"})}));
+        EXPECT_EQ(res, 2275118705557543022);
+        res = hash(genArgsRef({List({List({"Hello"})})}));
+        EXPECT_EQ(res, static_cast<int64_t>(2275118705557543022 + 0x9e3779b9UL));
+    }
+    {
+        // The date times are hashed as they used to be
+        auto result = FunctionManager::get("hash", 1);
+        ASSERT_TRUE(result.ok());
+        auto res = std::move(result).value()(genArgsRef({DateTime(2021, 1, 1, 0, 0, 0, 0)}));
+        EXPECT_EQ(res, 1116133);
+    }
     {
         auto result = FunctionManager::get("size", 1);
         ASSERT_TRUE(result.ok());
@@ -1823,6 +1840,126 @@ TEST_F(FunctionManagerTest, DataSetRowCol) {
     }
 }
 
+TEST_F(FunctionManagerTest, Overload) {
+    // Overloads behave the same as the generic bodies
+    std::vector<std::pair<std::string, std::vector<Value>>> calls = {
+        {"abs", {-1}},
+        {"abs", {-1.5}},
+        {"floor", {3}},
+        {"floor", {-1.5}},
+        {"ceil", {1.5}},
+        {"round", {2.5}},
+        {"sqrt", {4}},
+        {"sqrt", {-4.0}},
+        {"lower", {"AbC"}},
+        {"ToUpper", {"AbC"}},
+        {"length", {"abc"}},
+        {"length", {createPath(1, {2, 3})}},
+        {"strcasecmp", {"abc", "ABD"}},
+    };
+    for (auto &call : calls) {
+        auto id = FunctionManager::getId(call.first, call.second.size());
+        ASSERT_TRUE(id.ok()) << call.first;
+        std::vector<Value::Type> argsType;
+        for (auto &arg : call.second) {
+            argsType.emplace_back(arg.type());
+        }
+        auto overload = FunctionManager::getOverload(id.value(), argsType);
+        ASSERT_NE(nullptr, overload) << call.first;
+        auto generic = FunctionManager::get(call.first, call.second.size());
+        ASSERT_TRUE(generic.ok());
+        auto args = genArgsRef(call.second);
+        auto expected = generic.value()(args);
+        auto result = overload(args);
+        EXPECT_EQ(expected.type(), result.type()) << call.first;
+        EXPECT_EQ(expected, result) << call.first;
+    }
+    {
+        auto id = FunctionManager::getId("abs", 1);
+        ASSERT_TRUE(id.ok());
+        EXPECT_EQ(nullptr, FunctionManager::getOverload(id.value(), {Value::Type::STRING}));
+        EXPECT_FALSE(FunctionManager::getId("abs", 2).ok());
+        EXPECT_FALSE(FunctionManager::getId("not_exist", 1).ok());
+    }
+}
+
+TEST_F(FunctionManagerTest, DynamicLoading) {
+    const std::string soname = NEBULA_SAMPLE_UDF_PATH;
+    {
+        EXPECT_FALSE(FunctionManager::load("/not/exist/libudf.so", {}).ok());
+        EXPECT_FALSE(FunctionManager::load(soname, {"not_exist"}).ok());
+        EXPECT_FALSE(FunctionManager::find("sample_score", 2).ok());
+    }
+    ASSERT_TRUE(FunctionManager::load(soname, {}).ok());
+    {
+        // Already loaded, or conflict with the builtin ones
+        EXPECT_FALSE(FunctionManager::load(soname, {"sample_score"}).ok());
+    }
+    // scalar
+    {
+        TEST_FUNCTION(sample_score, std::vector<Value>({3, 0.5}), Value(2.5));
+        TEST_FUNCTION(SAMPLE_SCORE, std::vector<Value>({3, 0.5}), Value(2.5));
+        TEST_FUNCTION(sample_score, std::vector<Value>({"3", 0.5}), Value::kNullBadType);
+        TEST_FUNCTION(sample_counter, std::vector<Value>(), Value::Type::INT);
+        EXPECT_FALSE(FunctionManager::find("sample_score", 1).ok());
+        EXPECT_TRUE(FunctionManager::getIsPure("sample_score", 2).value());
+        EXPECT_FALSE(FunctionManager::getIsPure("sample_counter", 0).value());
+        auto type = FunctionManager::getReturnType("sample_score",
+                                                   {Value::Type::INT, Value::Type::FLOAT});
+        ASSERT_TRUE(type.ok());
+        EXPECT_EQ(Value::Type::FLOAT, type.value());
+    }
+    // batch
+    {
+        std::vector<Value> xs = {1, 2, 3};
+        std::vector<Value> weights = {1.0, 2.0, 3.0};
+        auto batch = FunctionManager::getBatch("sample_score", 2);
+        ASSERT_TRUE(batch.ok());
+        std::vector<Value> results;
+        batch.value()({xs.data(), weights.data()}, xs.size(), results);
+        EXPECT_EQ(std::vector<Value>({2.0, 5.0, 10.0}), results);
+    }
+    // batch emulated by the scalar entry
+    {
+        std::vector<Value> xs = {-1, 2, Value::kNullValue};
+        auto batch = FunctionManager::getBatch("abs", 1);
+        ASSERT_TRUE(batch.ok());
+        std::vector<Value> results;
+        batch.value()({xs.data()}, xs.size(), results);
+        EXPECT_EQ(std::vector<Value>({1, 2, Value::kNullValue}), results);
+
+        batch = FunctionManager::getBatch("sample_counter", 0);
+        ASSERT_TRUE(batch.ok());
+        batch.value()({}, 4, results);
+        ASSERT_EQ(4UL, results.size());
+        EXPECT_LT(results[0].getInt(), results[3].getInt());
+    }
+    // hot unloading
+    {
+        auto score = FunctionManager::get("sample_score", 2);
+        ASSERT_TRUE(score.ok());
+
+        ASSERT_TRUE(FunctionManager::unload(soname, {"sample_score"}).ok());
+        EXPECT_FALSE(FunctionManager::find("sample_score", 2).ok());
+        EXPECT_TRUE(FunctionManager::find("sample_counter", 0).ok());
+        EXPECT_FALSE(FunctionManager::unload(soname, {"sample_score"}).ok());
+        ASSERT_TRUE(FunctionManager::unload(soname, {}).ok());
+        EXPECT_FALSE(FunctionManager::find("sample_counter", 0).ok());
+        EXPECT_FALSE(FunctionManager::unload(soname, {}).ok());
+
+        // Still callable, since the shared object is held by the function
+        std::vector<Value> args = {4, 0.5};
+        EXPECT_EQ(Value(3.0), score.value()(genArgsRef(args)));
+    }
+    // reload
+    {
+        ASSERT_TRUE(FunctionManager::load(soname, {"sample_score"}).ok());
+        TEST_FUNCTION(sample_score, std::vector<Value>({3, 0.5}), Value(2.5));
+        EXPECT_FALSE(FunctionManager::find("sample_counter", 0).ok());
+        ASSERT_TRUE(FunctionManager::unload(soname, {}).ok());
+    }
+}
+
 }   // namespace nebula
 
 int main(int argc, char **argv) {
@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <atomic>
+
+#include "common/function/UdfAbi.h"
+
+/**
+ * A sample shared object of user defined functions, loaded by FunctionManagerTest.
+ */
+
+namespace nebula {
+namespace {
+
+Value score(const Value &x, const Value &weight) {
+    if (!x.isInt() || !weight.isFloat()) {
+        return Value::kNullBadType;
+    }
+    return static_cast<double>(x.getInt()) * weight.getFloat() + 1.0;
+}
+
+void scoreScalar(const nebula_udf_value *const *args, size_t, nebula_udf_value *result) {
+    udf::value(result) = score(udf::value(args[0]), udf::value(args[1]));
+}
+
+void scoreBatch(const nebula_udf_value *const *columns,
+                size_t,
+                size_t numRows,
+                nebula_udf_value *results) {
+    const auto *xs = &udf::value(columns[0]);
+    const auto *weights = &udf::value(columns[1]);
+    auto *out = &udf::value(results);
+    for (auto i = 0UL; i < numRows; i++) {
+        out[i] = score(xs[i], weights[i]);
+    }
+}
+
+// Counts the calls, which makes it impure
+void counter(const nebula_udf_value *const *, size_t, nebula_udf_value *result) {
+    static std::atomic<int64_t> count{0};
+    udf::value(result) = ++count;
+}
+
+const uint64_t kScoreArgs[] = {
+    static_cast<uint64_t>(Value::Type::INT),
+    static_cast<uint64_t>(Value::Type::FLOAT),
+};
+
+const nebula_udf_signature kScoreSignatures[] = {
+    {kScoreArgs, 2, static_cast<uint64_t>(Value::Type::FLOAT)},
+};
+
+const nebula_udf_signature kCounterSignatures[] = {
+    {nullptr, 0, static_cast<uint64_t>(Value::Type::INT)},
+};
+
+const nebula_udf_function kFunctions[] = {
+    {"sample_score", 2, 2, 1, kScoreSignatures, 1, scoreScalar, scoreBatch},
+    {"sample_counter", 0, 0, 0, kCounterSignatures, 1, counter, nullptr},
+};
+
+const nebula_udf_module kModule = {
+    NEBULA_UDF_ABI_VERSION,
+    kFunctions,
+    sizeof(kFunctions) / sizeof(kFunctions[0]),
+};
+
+}   // namespace
+}   // namespace nebula
+
+extern "C" const nebula_udf_module* NEBULA_UDF_ENTRY() {
+    return &nebula::kModule;
+}
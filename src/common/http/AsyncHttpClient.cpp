@@ -0,0 +1,548 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/http/AsyncHttpClient.h"
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/io/IOBuf.h>
+#include <folly/io/async/AsyncSocket.h>
+#include <folly/io/async/AsyncTimeout.h>
+
+DEFINE_int32(http_client_threads, 2, "Number of IO threads of the async http client");
+DEFINE_int32(http_client_max_connections_per_host, 8,
+             "Max number of connections kept to one http host");
+DEFINE_int32(http_client_max_pipeline_depth, 4,
+             "Max number of requests in flight on one http connection");
+DEFINE_int32(http_client_connect_timeout_ms, 3000,
+             "Timeout in milliseconds to connect to a http host");
+DEFINE_int32(http_client_timeout_ms, 60000,
+             "Timeout in milliseconds to wait for a http response");
+
+namespace nebula {
+namespace http {
+
+namespace {
+
+constexpr size_t kReadBufferSize = 64 * 1024;
+constexpr int32_t kMaxRetries = 1;
+
+struct Url {
+    std::string     host;
+    uint16_t        port{80};
+    // The path and query
+    std::string     target;
+};
+
+StatusOr<Url> parseUrl(const std::string& url) {
+    folly::StringPiece rest(url);
+    if (rest.startsWith("https://")) {
+        return Status::Error("Https is not supported: %s", url.c_str());
+    }
+    rest.removePrefix("http://");
+
+    Url result;
+    auto slash = rest.find('/');
+    auto authority = rest.subpiece(0, slash);
+    result.target = slash == folly::StringPiece::npos ? "/" : rest.subpiece(slash).str();
+
+    folly::StringPiece port;
+    if (authority.startsWith('[')) {
+        // IPv6 address, e.g. [::1]:8080
+        auto close = authority.find(']');
+        if (close == folly::StringPiece::npos) {
+            return Status::Error("Invalid url: %s", url.c_str());
+        }
+        result.host = authority.subpiece(1, close - 1).str();
+        port = authority.subpiece(close + 1);
+        if (!port.empty() && !port.removePrefix(':')) {
+            return Status::Error("Invalid url: %s", url.c_str());
+        }
+    } else {
+        auto colon = authority.rfind(':');
+        result.host = authority.subpiece(0, colon).str();
+        if (colon != folly::StringPiece::npos) {
+            port = authority.subpiece(colon + 1);
+        }
+    }
+    if (!port.empty()) {
+        auto p = folly::tryTo<uint16_t>(port);
+        if (!p.hasValue()) {
+            return Status::Error("Invalid port in url: %s", url.c_str());
+        }
+        result.port = p.value();
+    }
+    if (result.host.empty()) {
+        return Status::Error("Invalid url: %s", url.c_str());
+    }
+    return result;
+}
+
+std::unique_ptr<folly::IOBuf> serialize(const HttpRequest& request, const Url& url) {
+    auto equals = [] (folly::StringPiece lhs, folly::StringPiece rhs) {
+        return lhs.equals(rhs, folly::AsciiCaseInsensitive());
+    };
+    std::string raw;
+    raw.reserve(256 + request.body.size());
+    folly::toAppend(request.method, " ", url.target, " HTTP/1.1\r\n", &raw);
+    auto hasHost = false;
+    auto hasLength = false;
+    for (auto& header : request.headers) {
+        hasHost = hasHost || equals(header.first, "Host");
+        hasLength = hasLength || equals(header.first, "Content-Length");
+        folly::toAppend(header.first, ": ", header.second, "\r\n", &raw);
+    }
+    if (!hasHost) {
+        folly::toAppend("Host: ", url.host, ":", url.port, "\r\n", &raw);
+    }
+    if (!hasLength && (!request.body.empty() || request.method == "POST" ||
+                       request.method == "PUT")) {
+        folly::toAppend("Content-Length: ", request.body.size(), "\r\n", &raw);
+    }
+    raw.append("\r\n");
+    raw.append(request.body);
+    return folly::IOBuf::copyBuffer(raw);
+}
+
+bool isIdempotent(const std::string& method) {
+    return method == "GET" || method == "HEAD" || method == "PUT" ||
+           method == "DELETE" || method == "OPTIONS";
+}
+
+}   // namespace
+
+
+struct AsyncHttpClient::Pending {
+    // The serialized request, kept for retrying
+    std::unique_ptr<folly::IOBuf>                   data;
+    bool                                            idempotent{false};
+    bool                                            noBody{false};
+    int32_t                                         retries{0};
+    folly::Promise<StatusOr<HttpResponse>>          promise;
+};
+
+
+/**
+ * A connection to the host, on which requests are pipelined and responses
+ * are matched in order. It lives in the thread of the event base.
+ */
+class AsyncHttpClient::Connection final : public folly::AsyncSocket::ConnectCallback,
+                                          public folly::AsyncReader::ReadCallback,
+                                          public folly::AsyncWriter::WriteCallback {
+public:
+    Connection(HostPool* pool, folly::EventBase* evb);
+    ~Connection() override = default;
+
+    void connect(const folly::SocketAddress& addr);
+
+    // Whether it could take more requests
+    bool ready() const {
+        return state_ == State::kReady && keepAlive_;
+    }
+
+    bool connecting() const {
+        return state_ == State::kConnecting;
+    }
+
+    bool everConnected() const {
+        return everConnected_;
+    }
+
+    size_t inflight() const {
+        return inflight_.size();
+    }
+
+    void send(Pending pending);
+
+    /**
+     * To close the connection. The in-flight requests are failed with `status',
+     * except the idempotent ones which could be retried if `retryable'.
+     */
+    void close(const Status& status, bool retryable);
+
+    void connectSuccess() noexcept override;
+    void connectErr(const folly::AsyncSocketException& ex) noexcept override;
+
+    void getReadBuffer(void** buf, size_t* len) override;
+    void readDataAvailable(size_t len) noexcept override;
+    void readEOF() noexcept override;
+    void readErr(const folly::AsyncSocketException& ex) noexcept override;
+
+    void writeSuccess() noexcept override {
+    }
+    void writeErr(size_t, const folly::AsyncSocketException& ex) noexcept override;
+
+private:
+    void onResponse();
+    void resetTimeout();
+
+    enum class State : uint8_t {
+        kConnecting,
+        kReady,
+        kClosed,
+    };
+
+private:
+    HostPool                                   *pool_{nullptr};
+    folly::AsyncSocket::UniquePtr               socket_;
+    std::unique_ptr<folly::AsyncTimeout>        timeout_;
+    State                                       state_{State::kConnecting};
+    bool                                        everConnected_{false};
+    bool                                        keepAlive_{true};
+    std::deque<Pending>                         inflight_;
+    HttpResponseParser                          parser_;
+    std::unique_ptr<char[]>                     readBuf_;
+};
+
+
+/**
+ * The connections and waiting requests of one host.
+ * All methods except the constructor must be called in the thread of `evb_'.
+ */
+class AsyncHttpClient::HostPool final : public std::enable_shared_from_this<HostPool> {
+public:
+    HostPool(AsyncHttpClient* client, folly::EventBase* evb, std::string host, uint16_t port)
+        : client_(client), evb_(evb), host_(std::move(host)), port_(port) {}
+
+    folly::EventBase* evb() const {
+        return evb_;
+    }
+
+    void enqueue(Pending pending) {
+        waiting_.emplace_back(std::move(pending));
+        dispatch();
+    }
+
+    void dispatch();
+
+    void onConnected() {
+        connecting_--;
+        dispatch();
+    }
+
+    void onClosed(Connection* conn, std::deque<Pending> retry, const Status& status);
+
+    void closeAll();
+
+private:
+    void connect();
+    Connection* pickConnection(bool idleOnly) const;
+    void failWaiting(const Status& status);
+
+private:
+    AsyncHttpClient                                *client_{nullptr};
+    folly::EventBase                               *evb_{nullptr};
+    const std::string                               host_;
+    const uint16_t                                  port_;
+    std::deque<Pending>                             waiting_;
+    std::list<std::unique_ptr<Connection>>          connections_;
+    size_t                                          connecting_{0};
+};
+
+
+AsyncHttpClient::Connection::Connection(HostPool* pool, folly::EventBase* evb)
+    : pool_(pool)
+    , socket_(new folly::AsyncSocket(evb))
+    , readBuf_(std::make_unique<char[]>(kReadBufferSize)) {
+    timeout_ = folly::AsyncTimeout::make(*evb, [this] () noexcept {
+        close(Status::Error("Http request timeout"), false);
+    });
+}
+
+void AsyncHttpClient::Connection::connect(const folly::SocketAddress& addr) {
+    socket_->connect(this, addr, FLAGS_http_client_connect_timeout_ms);
+}
+
+void AsyncHttpClient::Connection::send(Pending pending) {
+    DCHECK(ready());
+    if (inflight_.empty()) {
+        parser_.reset(pending.noBody);
+    }
+    auto data = pending.data->clone();
+    inflight_.emplace_back(std::move(pending));
+    if (inflight_.size() == 1) {
+        resetTimeout();
+    }
+    socket_->writeChain(this, std::move(data));
+}
+
+void AsyncHttpClient::Connection::close(const Status& status, bool retryable) {
+    if (state_ == State::kClosed) {
+        return;
+    }
+    state_ = State::kClosed;
+    timeout_->cancelTimeout();
+    socket_->setReadCB(nullptr);
+    socket_->closeNow();
+
+    std::deque<Pending> retry;
+    auto head = true;
+    for (auto& pending : inflight_) {
+        // The head one has been partially answered if the parser has started
+        auto safe = retryable && pending.idempotent && !(head && parser_.started());
+        if (safe && pending.retries < kMaxRetries) {
+            pending.retries++;
+            retry.emplace_back(std::move(pending));
+        } else {
+            pending.promise.setValue(StatusOr<HttpResponse>(status));
+        }
+        head = false;
+    }
+    inflight_.clear();
+    pool_->onClosed(this, std::move(retry), status);
+}
+
+void AsyncHttpClient::Connection::connectSuccess() noexcept {
+    if (state_ != State::kConnecting) {
+        return;
+    }
+    state_ = State::kReady;
+    everConnected_ = true;
+    socket_->setNoDelay(true);
+    socket_->setReadCB(this);
+    pool_->onConnected();
+}
+
+void AsyncHttpClient::Connection::connectErr(const folly::AsyncSocketException& ex) noexcept {
+    close(Status::Error("Connect failed: %s", ex.what()), true);
+}
+
+void AsyncHttpClient::Connection::getReadBuffer(void** buf, size_t* len) {
+    *buf = readBuf_.get();
+    *len = kReadBufferSize;
+}
+
+void AsyncHttpClient::Connection::readDataAvailable(size_t len) noexcept {
+    folly::StringPiece data(readBuf_.get(), len);
+    while (!data.empty() && state_ != State::kClosed) {
+        if (inflight_.empty()) {
+            close(Status::Error("Unexpected data from http server"), false);
+            return;
+        }
+        auto status = parser_.parse(data);
+        if (!status.ok()) {
+            close(status, false);
+            return;
+        }
+        if (parser_.done()) {
+            onResponse();
+        }
+    }
+}
+
+void AsyncHttpClient::Connection::readEOF() noexcept {
+    if (!inflight_.empty()) {
+        auto status = parser_.onEof();
+        if (status.ok()) {
+            // The body delimited by the closing of connection
+            onResponse();
+        } else {
+            close(status, true);
+            return;
+        }
+    }
+    close(Status::Error("Connection closed by http server"), true);
+}
+
+void AsyncHttpClient::Connection::readErr(const folly::AsyncSocketException& ex) noexcept {
+    close(Status::Error("Read failed: %s", ex.what()), true);
+}
+
+void AsyncHttpClient::Connection::writeErr(size_t,
+                                           const folly::AsyncSocketException& ex) noexcept {
+    close(Status::Error("Write failed: %s", ex.what()), true);
+}
+
+void AsyncHttpClient::Connection::onResponse() {
+    auto pending = std::move(inflight_.front());
+    inflight_.pop_front();
+    keepAlive_ = parser_.keepAlive();
+    pending.promise.setValue(StatusOr<HttpResponse>(parser_.release()));
+    parser_.reset(inflight_.empty() ? false : inflight_.front().noBody);
+
+    if (!keepAlive_) {
+        // The server does not process the requests behind the one it closes after,
+        // so all of them are safe to resend.
+        std::deque<Pending> retry;
+        retry.swap(inflight_);
+        close(Status::Error("Connection closed by http server"), false);
+        for (auto& p : retry) {
+            pool_->enqueue(std::move(p));
+        }
+        return;
+    }
+    resetTimeout();
+    pool_->dispatch();
+}
+
+void AsyncHttpClient::Connection::resetTimeout() {
+    if (inflight_.empty()) {
+        timeout_->cancelTimeout();
+    } else {
+        timeout_->scheduleTimeout(FLAGS_http_client_timeout_ms);
+    }
+}
+
+
+void AsyncHttpClient::HostPool::dispatch() {
+    while (!waiting_.empty()) {
+        // Prefer an idle connection, then a new one, and pipeline at last
+        auto* conn = pickConnection(true);
+        if (conn == nullptr) {
+            auto canConnect = connections_.size() <
+                              static_cast<size_t>(FLAGS_http_client_max_connections_per_host);
+            if (canConnect && connecting_ < waiting_.size()) {
+                connect();
+                continue;
+            }
+            if (waiting_.size() <= connecting_) {
+                // Wait for the connections being established
+                break;
+            }
+            conn = pickConnection(false);
+            if (conn == nullptr) {
+                break;
+            }
+        }
+        auto pending = std::move(waiting_.front());
+        waiting_.pop_front();
+        conn->send(std::move(pending));
+    }
+}
+
+AsyncHttpClient::Connection* AsyncHttpClient::HostPool::pickConnection(bool idleOnly) const {
+    Connection* picked = nullptr;
+    auto depth = static_cast<size_t>(std::max(FLAGS_http_client_max_pipeline_depth, 1));
+    for (auto& conn : connections_) {
+        if (!conn->ready() || conn->inflight() >= depth) {
+            continue;
+        }
+        if (idleOnly && conn->inflight() > 0) {
+            continue;
+        }
+        if (picked == nullptr || conn->inflight() < picked->inflight()) {
+            picked = conn.get();
+        }
+    }
+    return picked;
+}
+
+void AsyncHttpClient::HostPool::connect() {
+    folly::SocketAddress addr;
+    try {
+        addr.setFromHostPort(host_, port_);
+    } catch (const std::exception& ex) {
+        failWaiting(Status::Error("Resolve %s failed: %s", host_.c_str(), ex.what()));
+        return;
+    }
+    connections_.emplace_back(std::make_unique<Connection>(this, evb_));
+    connecting_++;
+    client_->numConnections_.fetch_add(1, std::memory_order_relaxed);
+    connections_.back()->connect(addr);
+}
+
+void AsyncHttpClient::HostPool::onClosed(Connection* conn,
+                                         std::deque<Pending> retry,
+                                         const Status& status) {
+    if (!conn->everConnected()) {
+        connecting_--;
+    }
+    client_->numConnections_.fetch_sub(1, std::memory_order_relaxed);
+    // Resend in the original order, ahead of the waiting ones
+    for (auto iter = retry.rbegin(); iter != retry.rend(); ++iter) {
+        waiting_.emplace_front(std::move(*iter));
+    }
+    // We are in the callback of the connection, so destroy it later
+    evb_->runInLoop([self = shared_from_this(), conn] () {
+        self->connections_.remove_if([conn] (const auto& c) { return c.get() == conn; });
+    });
+
+    auto alive = std::any_of(connections_.begin(), connections_.end(), [] (const auto& c) {
+        return c->ready() || c->connecting();
+    });
+    if (!conn->everConnected() && !alive) {
+        // The host is unreachable, fail them rather than reconnecting endlessly
+        failWaiting(status);
+        return;
+    }
+    dispatch();
+}
+
+void AsyncHttpClient::HostPool::closeAll() {
+    failWaiting(Status::Error("Http client is shutting down"));
+    for (auto& conn : connections_) {
+        conn->close(Status::Error("Http client is shutting down"), false);
+    }
+    connections_.clear();
+}
+
+void AsyncHttpClient::HostPool::failWaiting(const Status& status) {
+    auto waiting = std::move(waiting_);
+    waiting_.clear();
+    for (auto& pending : waiting) {
+        pending.promise.setValue(StatusOr<HttpResponse>(status));
+    }
+}
+
+
+AsyncHttpClient::AsyncHttpClient(size_t numThreads) {
+    ioPool_ = std::make_unique<folly::IOThreadPoolExecutor>(
+        std::max<size_t>(numThreads, 1),
+        std::make_shared<folly::NamedThreadFactory>("http-client"));
+}
+
+AsyncHttpClient::~AsyncHttpClient() {
+    decltype(hostPools_) pools;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        pools.swap(hostPools_);
+    }
+    for (auto& entry : pools) {
+        auto pool = entry.second;
+        pool->evb()->runInEventBaseThreadAndWait([pool] () {
+            pool->closeAll();
+        });
+    }
+    ioPool_->join();
+}
+
+// static
+AsyncHttpClient& AsyncHttpClient::instance() {
+    static AsyncHttpClient client;
+    return client;
+}
+
+folly::Future<StatusOr<HttpResponse>> AsyncHttpClient::send(HttpRequest request) {
+    auto url = parseUrl(request.url);
+    if (!url.ok()) {
+        return folly::makeFuture<StatusOr<HttpResponse>>(url.status());
+    }
+    Pending pending;
+    pending.data = serialize(request, url.value());
+    pending.idempotent = isIdempotent(request.method);
+    pending.noBody = request.method == "HEAD";
+    auto future = pending.promise.getFuture();
+
+    auto pool = getHostPool(url.value().host, url.value().port);
+    pool->evb()->runInEventBaseThread([pool, pending = std::move(pending)] () mutable {
+        pool->enqueue(std::move(pending));
+    });
+    return future;
+}
+
+std::shared_ptr<AsyncHttpClient::HostPool>
+AsyncHttpClient::getHostPool(const std::string& host, uint16_t port) {
+    auto key = folly::stringPrintf("%s:%u", host.c_str(), port);
+    std::lock_guard<std::mutex> guard(lock_);
+    auto iter = hostPools_.find(key);
+    if (iter != hostPools_.end()) {
+        return iter->second;
+    }
+    auto pool = std::make_shared<HostPool>(this, ioPool_->getEventBase(), host, port);
+    hostPools_.emplace(std::move(key), pool);
+    return pool;
+}
+
+}   // namespace http
+}   // namespace nebula
@@ -0,0 +1,83 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_HTTP_ASYNCHTTPCLIENT_H_
+#define COMMON_HTTP_ASYNCHTTPCLIENT_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/http/HttpResponseParser.h"
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+
+DECLARE_int32(http_client_threads);
+DECLARE_int32(http_client_max_connections_per_host);
+DECLARE_int32(http_client_max_pipeline_depth);
+DECLARE_int32(http_client_connect_timeout_ms);
+DECLARE_int32(http_client_timeout_ms);
+
+namespace nebula {
+namespace http {
+
+struct HttpRequest {
+    std::string                                         method{"GET"};
+    // e.g. http://127.0.0.1:9200/index/_search?timeout=10ms
+    std::string                                         url;
+    std::vector<std::pair<std::string, std::string>>    headers;
+    std::string                                         body;
+};
+
+/**
+ * AsyncHttpClient is an in-process, non-blocking HTTP/1.1 client.
+ *
+ * Connections to each host are kept alive and pooled, up to
+ * `FLAGS_http_client_max_connections_per_host'. When all of them are busy, requests are
+ * pipelined on the least loaded one, up to `FLAGS_http_client_max_pipeline_depth'
+ * in flight, and the rest wait in the queue of the host.
+ *
+ * All the work of a host is done in one IO thread, and the futures are fulfilled there,
+ * so do not block in the continuations.
+ *
+ * Only plain `http' is supported.
+ */
+class AsyncHttpClient final {
+public:
+    explicit AsyncHttpClient(size_t numThreads = FLAGS_http_client_threads);
+    ~AsyncHttpClient();
+
+    // The process wide client
+    static AsyncHttpClient& instance();
+
+    /**
+     * To send a request.
+     * A response of any status code is a successful one, while the failures of connecting,
+     * sending, receiving or parsing are returned as the error status.
+     */
+    folly::Future<StatusOr<HttpResponse>> send(HttpRequest request);
+
+    // Number of connections currently established or being established
+    size_t numConnections() const {
+        return numConnections_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Pending;
+    class Connection;
+    class HostPool;
+
+    std::shared_ptr<HostPool> getHostPool(const std::string& host, uint16_t port);
+
+private:
+    std::unique_ptr<folly::IOThreadPoolExecutor>                    ioPool_;
+    std::mutex                                                      lock_;
+    std::unordered_map<std::string, std::shared_ptr<HostPool>>      hostPools_;
+    std::atomic<size_t>                                             numConnections_{0};
+};
+
+}   // namespace http
+}   // namespace nebula
+
+#endif  // COMMON_HTTP_ASYNCHTTPCLIENT_H_
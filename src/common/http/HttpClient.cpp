@@ -10,6 +10,10 @@
 namespace nebula {
 namespace http {
 
+StatusOr<std::string> HttpClient::get(const std::string& path) {
+    return getAsync(path).get();
+}
+
 StatusOr<std::string> HttpClient::get(const std::string& path, const std::string& options) {
     auto command = folly::stringPrintf("/usr/bin/curl %s \"%s\"", options.c_str(), path.c_str());
     LOG(INFO) << "HTTP Get Command: " << command;
@@ -76,24 +80,53 @@ StatusOr<std::string> HttpClient::put(const std::string& path, const folly::dyna
 StatusOr<std::string> HttpClient::sendRequest(const std::string& path,
                                               const folly::dynamic& data,
                                               const std::string& reqType) {
-    std::string command;
-    if (data.empty()) {
-        command = folly::stringPrintf("curl -X %s -s \"%s\"", reqType.c_str(), path.c_str());
-    } else {
-        command =
-            folly::stringPrintf("curl -X %s -H \"Content-Type: application/json\" -d'%s' -s \"%s\"",
-                                reqType.c_str(),
-                                folly::toJson(data).c_str(),
-                                path.c_str());
-    }
-    LOG(INFO) << folly::stringPrintf("HTTP %s Command: %s", reqType.c_str(), command.c_str());
-    auto result = nebula::ProcessUtils::runCommand(command.c_str());
-    if (result.ok()) {
-        return result.value();
-    } else {
-        return Status::Error(
-            folly::stringPrintf("Http %s Failed: %s", reqType.c_str(), path.c_str()));
+    return sendRequestAsync(path, data, reqType).get();
+}
+
+folly::Future<StatusOr<std::string>> HttpClient::getAsync(const std::string& path) {
+    HttpRequest request;
+    request.method = "GET";
+    request.url = path;
+    return sendAsync(std::move(request));
+}
+
+folly::Future<StatusOr<std::string>> HttpClient::postAsync(const std::string& path,
+                                                           const folly::dynamic& data) {
+    return sendRequestAsync(path, data, "POST");
+}
+
+folly::Future<StatusOr<std::string>> HttpClient::putAsync(const std::string& path,
+                                                          const folly::dynamic& data) {
+    return sendRequestAsync(path, data, "PUT");
+}
+
+folly::Future<StatusOr<std::string>> HttpClient::sendRequestAsync(const std::string& path,
+                                                                  const folly::dynamic& data,
+                                                                  const std::string& reqType) {
+    HttpRequest request;
+    request.method = reqType;
+    request.url = path;
+    if (!data.empty()) {
+        request.headers.emplace_back("Content-Type", "application/json");
+        request.body = folly::toJson(data);
     }
+    return sendAsync(std::move(request));
+}
+
+folly::Future<StatusOr<std::string>> HttpClient::sendAsync(HttpRequest request) {
+    VLOG(2) << "HTTP " << request.method << " " << request.url;
+    auto method = request.method;
+    auto url = request.url;
+    return AsyncHttpClient::instance().send(std::move(request))
+        .thenValue([method = std::move(method), url = std::move(url)] (auto&& resp)
+                -> StatusOr<std::string> {
+            if (!resp.ok()) {
+                LOG(ERROR) << "Http " << method << " " << url << " failed: " << resp.status();
+                return Status::Error(
+                    folly::stringPrintf("Http %s Failed: %s", method.c_str(), url.c_str()));
+            }
+            return std::move(resp).value().body;
+        });
 }
 
 }   // namespace http
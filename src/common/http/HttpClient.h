@@ -9,6 +9,7 @@
 
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
+#include "common/http/AsyncHttpClient.h"
 
 namespace nebula {
 namespace http {
@@ -19,9 +20,12 @@ public:
 
     ~HttpClient() = default;
     // Send a http GET request
-    static StatusOr<std::string> get(const std::string& path, const std::string& options = "-G");
+    static StatusOr<std::string> get(const std::string& path);
+    // Send a http GET request by curl with the given options, which forks a process per call,
+    // prefer the one above
+    static StatusOr<std::string> get(const std::string& path, const std::string& options);
 
-    // Send a http POST request
+    // Send a http POST request by curl with the given options
     static StatusOr<std::string> post(const std::string& path, const std::string& header);
     // Send a http POST request with a different function signature
     static StatusOr<std::string> post(const std::string& path,
@@ -29,14 +33,30 @@ public:
     static StatusOr<std::string> post(const std::string& path,
                                       const folly::dynamic& data = folly::dynamic::object());
 
-    // Send a http PUT request
+    // Send a http PUT request by curl with the given options
     static StatusOr<std::string> put(const std::string& path, const std::string& header);
     static StatusOr<std::string> put(const std::string& path,
                                       const std::unordered_map<std::string, std::string>& header);
     static StatusOr<std::string> put(const std::string& path,
                                       const folly::dynamic& data = folly::dynamic::object());
 
+    /**
+     * The asynchronous ones, which are served by AsyncHttpClient in process.
+     * The future is fulfilled with the body of the response, whatever the status code is.
+     */
+    static folly::Future<StatusOr<std::string>> getAsync(const std::string& path);
+    static folly::Future<StatusOr<std::string>> postAsync(
+        const std::string& path,
+        const folly::dynamic& data = folly::dynamic::object());
+    static folly::Future<StatusOr<std::string>> putAsync(
+        const std::string& path,
+        const folly::dynamic& data = folly::dynamic::object());
+    static folly::Future<StatusOr<std::string>> sendAsync(HttpRequest request);
+
 protected:
+    static folly::Future<StatusOr<std::string>> sendRequestAsync(const std::string& path,
+                                                                 const folly::dynamic& data,
+                                                                 const std::string& reqType);
     static StatusOr<std::string> sendRequest(const std::string& path,
                                              const folly::dynamic& data,
                                              const std::string& reqType);
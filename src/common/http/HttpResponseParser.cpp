@@ -0,0 +1,199 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/http/HttpResponseParser.h"
+
+namespace nebula {
+namespace http {
+
+void HttpResponseParser::reset(bool noBody) {
+    state_ = State::kStatusLine;
+    noBody_ = noBody;
+    keepAlive_ = true;
+    chunked_ = false;
+    hasLength_ = false;
+    remaining_ = 0;
+    line_.clear();
+    response_ = HttpResponse();
+}
+
+Status HttpResponseParser::parse(folly::StringPiece &data) {
+    while (!data.empty() && state_ != State::kDone) {
+        switch (state_) {
+            case State::kStatusLine:
+            case State::kHeader:
+            case State::kChunkSize:
+            case State::kChunkEnd:
+            case State::kTrailer: {
+                auto complete = readLine(data);
+                NG_RETURN_IF_ERROR(complete);
+                if (!complete.value()) {
+                    break;
+                }
+                if (state_ == State::kStatusLine) {
+                    NG_RETURN_IF_ERROR(onStatusLine());
+                    state_ = State::kHeader;
+                } else if (state_ == State::kHeader) {
+                    if (line_.empty()) {
+                        onHeadersDone();
+                    } else {
+                        NG_RETURN_IF_ERROR(onHeaderLine());
+                    }
+                } else if (state_ == State::kChunkSize) {
+                    // Chunk extensions after ';' are ignored
+                    auto size = folly::StringPiece(line_).split_step(';');
+                    size_t length = 0;
+                    try {
+                        length = std::stoul(folly::trimWhitespace(size).str(), nullptr, 16);
+                    } catch (const std::exception &) {
+                        return Status::Error("Invalid chunk size `%s'", line_.c_str());
+                    }
+                    remaining_ = length;
+                    state_ = length == 0 ? State::kTrailer : State::kChunkData;
+                } else if (state_ == State::kChunkEnd) {
+                    if (!line_.empty()) {
+                        return Status::Error("Missing CRLF after chunk data");
+                    }
+                    state_ = State::kChunkSize;
+                } else if (line_.empty()) {
+                    // The trailers are ignored
+                    state_ = State::kDone;
+                }
+                line_.clear();
+                break;
+            }
+            case State::kBody:
+            case State::kChunkData:
+            case State::kUntilClose: {
+                readBody(data);
+                break;
+            }
+            case State::kDone: {
+                break;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status HttpResponseParser::onEof() {
+    if (state_ == State::kUntilClose) {
+        state_ = State::kDone;
+        return Status::OK();
+    }
+    if (state_ == State::kDone) {
+        return Status::OK();
+    }
+    if (!started()) {
+        return Status::Error("Connection closed before response");
+    }
+    return Status::Error("Connection closed with an incomplete response");
+}
+
+StatusOr<bool> HttpResponseParser::readLine(folly::StringPiece &data) {
+    auto pos = data.find('\n');
+    auto len = pos == folly::StringPiece::npos ? data.size() : pos;
+    if (line_.size() + len > kMaxLineLength) {
+        return Status::Error("Line of http response too long");
+    }
+    line_.append(data.data(), len);
+    if (pos == folly::StringPiece::npos) {
+        data.clear();
+        return false;
+    }
+    data.advance(pos + 1);
+    if (!line_.empty() && line_.back() == '\r') {
+        line_.pop_back();
+    }
+    return true;
+}
+
+Status HttpResponseParser::onStatusLine() {
+    // HTTP/1.1 200 OK
+    folly::StringPiece line(line_);
+    if (!line.startsWith("HTTP/1.")) {
+        return Status::Error("Invalid status line `%s'", line_.c_str());
+    }
+    auto version = line.split_step(' ');
+    auto code = folly::tryTo<int32_t>(line.split_step(' '));
+    if (!code.hasValue()) {
+        return Status::Error("Invalid status line `%s'", line_.c_str());
+    }
+    response_.status = code.value();
+    // Connections of HTTP/1.0 are not persistent by default
+    keepAlive_ = version != "HTTP/1.0";
+    return Status::OK();
+}
+
+Status HttpResponseParser::onHeaderLine() {
+    auto pos = line_.find(':');
+    if (pos == std::string::npos) {
+        return Status::Error("Invalid header line `%s'", line_.c_str());
+    }
+    auto name = folly::trimWhitespace(folly::StringPiece(line_.data(), pos));
+    auto value = folly::trimWhitespace(folly::StringPiece(line_).subpiece(pos + 1));
+    auto equals = [] (folly::StringPiece lhs, folly::StringPiece rhs) {
+        return lhs.equals(rhs, folly::AsciiCaseInsensitive());
+    };
+    if (equals(name, "Content-Length")) {
+        auto length = folly::tryTo<size_t>(value);
+        if (!length.hasValue()) {
+            return Status::Error("Invalid header line `%s'", line_.c_str());
+        }
+        hasLength_ = true;
+        remaining_ = length.value();
+    } else if (equals(name, "Transfer-Encoding")) {
+        chunked_ = folly::StringPiece(value).endsWith("chunked", folly::AsciiCaseInsensitive());
+    } else if (equals(name, "Connection")) {
+        if (equals(value, "close")) {
+            keepAlive_ = false;
+        } else if (equals(value, "keep-alive")) {
+            keepAlive_ = true;
+        }
+    }
+    response_.headers.emplace_back(name.str(), value.str());
+    return Status::OK();
+}
+
+void HttpResponseParser::onHeadersDone() {
+    auto status = response_.status;
+    if (status >= 100 && status < 200) {
+        // Skip the interim response, e.g. 100 Continue
+        auto noBody = noBody_;
+        reset(noBody);
+        return;
+    }
+    if (noBody_ || status == 204 || status == 304) {
+        state_ = State::kDone;
+    } else if (chunked_) {
+        state_ = State::kChunkSize;
+    } else if (hasLength_) {
+        state_ = remaining_ == 0 ? State::kDone : State::kBody;
+        response_.body.reserve(remaining_);
+    } else {
+        // The body is delimited by the closing of connection
+        keepAlive_ = false;
+        state_ = State::kUntilClose;
+    }
+}
+
+void HttpResponseParser::readBody(folly::StringPiece &data) {
+    if (state_ == State::kUntilClose) {
+        response_.body.append(data.data(), data.size());
+        data.clear();
+        return;
+    }
+    auto len = std::min(remaining_, data.size());
+    response_.body.append(data.data(), len);
+    data.advance(len);
+    remaining_ -= len;
+    if (remaining_ == 0) {
+        state_ = state_ == State::kBody ? State::kDone : State::kChunkEnd;
+    }
+}
+
+}   // namespace http
+}   // namespace nebula
@@ -0,0 +1,107 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_HTTP_HTTPRESPONSEPARSER_H_
+#define COMMON_HTTP_HTTPRESPONSEPARSER_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+
+namespace nebula {
+namespace http {
+
+struct HttpResponse {
+    int32_t                                             status{0};
+    std::vector<std::pair<std::string, std::string>>    headers;
+    std::string                                         body;
+};
+
+/**
+ * An incremental parser of HTTP/1.x responses, which handles
+ * the Content-Length, chunked and until-close bodies.
+ *
+ * Bytes are fed as they arrive from the connection. Since responses may be pipelined,
+ * `parse' stops right after a complete response, leaving the rest of the bytes
+ * for the next one.
+ */
+class HttpResponseParser final {
+public:
+    HttpResponseParser() = default;
+
+    /**
+     * To prepare for the next response.
+     * @noBody  whether the response carries no body, i.e. the one of a HEAD request
+     */
+    void reset(bool noBody = false);
+
+    /**
+     * To consume bytes from the front of `data', until a response is complete
+     * or `data' is exhausted.
+     */
+    Status parse(folly::StringPiece &data);
+
+    /**
+     * To tell the parser that the peer has closed the connection.
+     */
+    Status onEof();
+
+    // Whether any byte of the current response has been received
+    bool started() const {
+        return state_ != State::kStatusLine || !line_.empty();
+    }
+
+    bool done() const {
+        return state_ == State::kDone;
+    }
+
+    // Whether the connection could be reused after this response
+    bool keepAlive() const {
+        return keepAlive_;
+    }
+
+    // To take the completed response
+    HttpResponse release() {
+        DCHECK(done());
+        return std::move(response_);
+    }
+
+private:
+    enum class State : uint8_t {
+        kStatusLine,
+        kHeader,
+        kBody,
+        kChunkSize,
+        kChunkData,
+        kChunkEnd,
+        kTrailer,
+        kUntilClose,
+        kDone,
+    };
+
+    // To accumulate bytes of a line, return true if the line is complete
+    StatusOr<bool> readLine(folly::StringPiece &data);
+    Status onStatusLine();
+    Status onHeaderLine();
+    void onHeadersDone();
+    void readBody(folly::StringPiece &data);
+
+    static constexpr size_t kMaxLineLength = 64 * 1024;
+
+private:
+    State                                   state_{State::kStatusLine};
+    bool                                    noBody_{false};
+    bool                                    keepAlive_{true};
+    bool                                    chunked_{false};
+    bool                                    hasLength_{false};
+    size_t                                  remaining_{0};
+    std::string                             line_;
+    HttpResponse                            response_;
+};
+
+}   // namespace http
+}   // namespace nebula
+
+#endif  // COMMON_HTTP_HTTPRESPONSEPARSER_H_
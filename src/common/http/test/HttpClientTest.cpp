@@ -5,6 +5,7 @@
  */
 
 #include "common/http/HttpClient.h"
+#include "common/http/HttpResponseParser.h"
 
 #include <gtest/gtest.h>
 #include <proxygen/httpserver/RequestHandler.h>
@@ -47,6 +48,52 @@ public:
                    << proxygen::getErrorString(error);
     }
 };
+
+// Reply with the method and body of the request
+class EchoHandler : public proxygen::RequestHandler {
+public:
+    EchoHandler() = default;
+
+    void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override {
+        method_ = headers->getMethodString();
+    }
+
+    void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override {
+        if (body_) {
+            body_->prependChain(std::move(body));
+        } else {
+            body_ = std::move(body);
+        }
+    }
+
+    void onEOM() noexcept override {
+        std::string body = method_ + " ";
+        if (body_) {
+            body.append(body_->moveToFbString().toStdString());
+        }
+        proxygen::ResponseBuilder(downstream_)
+            .status(WebServiceUtils::to(HttpStatusCode::OK),
+                    WebServiceUtils::toString(HttpStatusCode::OK))
+            .body(std::move(body))
+            .sendWithEOM();
+    }
+
+    void onUpgrade(proxygen::UpgradeProtocol) noexcept override {
+    }
+
+    void requestComplete() noexcept override {
+        delete this;
+    }
+
+    void onError(proxygen::ProxygenError error) noexcept override {
+        LOG(ERROR) << "EchoHandler Error: " << proxygen::getErrorString(error);
+    }
+
+private:
+    std::string                         method_;
+    std::unique_ptr<folly::IOBuf>       body_;
+};
+
 class HttpClientTestEnv : public ::testing::Environment {
 public:
     void SetUp() override {
@@ -58,6 +105,8 @@ public:
 
         auto& router = webSvc_->router();
         router.get("/path").handler([](auto&&) { return new HttpClientHandler(); });
+        router.post("/echo").handler([](auto&&) { return new EchoHandler(); });
+        router.put("/echo").handler([](auto&&) { return new EchoHandler(); });
 
         auto status = webSvc_->start();
         ASSERT_TRUE(status.ok()) << status;
@@ -89,6 +138,129 @@ TEST(HttpClient, get) {
     }
 }
 
+TEST(HttpClient, post) {
+    auto url = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                   FLAGS_ws_http_port, "/echo");
+    {
+        auto result = HttpClient::post(url, folly::dynamic::object("key", "value"));
+        ASSERT_TRUE(result.ok());
+        ASSERT_EQ("POST {\"key\":\"value\"}", result.value());
+    }
+    {
+        auto result = HttpClient::put(url);
+        ASSERT_TRUE(result.ok());
+        ASSERT_EQ("PUT ", result.value());
+    }
+}
+
+TEST(HttpClient, async) {
+    auto url = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                   FLAGS_ws_http_port, "/path");
+    std::vector<folly::Future<StatusOr<std::string>>> futures;
+    for (auto i = 0; i < 100; i++) {
+        futures.emplace_back(HttpClient::getAsync(url));
+    }
+    auto results = folly::collectAll(futures).get();
+    for (auto& result : results) {
+        ASSERT_TRUE(result.hasValue());
+        ASSERT_TRUE(result.value().ok());
+        ASSERT_EQ("HttpClientHandler successfully", result.value().value());
+    }
+    // Connections are kept alive and bounded
+    ASSERT_LE(AsyncHttpClient::instance().numConnections(),
+              static_cast<size_t>(FLAGS_http_client_max_connections_per_host));
+}
+
+TEST(HttpClient, pipeline) {
+    AsyncHttpClient client(1);
+    auto url = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                   FLAGS_ws_http_port, "/echo");
+    std::vector<folly::Future<StatusOr<HttpResponse>>> futures;
+    for (auto i = 0; i < 64; i++) {
+        HttpRequest request;
+        request.method = "POST";
+        request.url = url;
+        request.body = folly::to<std::string>(i);
+        futures.emplace_back(client.send(std::move(request)));
+    }
+    // Responses are matched with the requests in order, even if they are pipelined
+    for (auto i = 0; i < 64; i++) {
+        auto result = std::move(futures[i]).get();
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(200, result.value().status);
+        ASSERT_EQ(folly::to<std::string>("POST ", i), result.value().body);
+    }
+    ASSERT_LE(client.numConnections(),
+              static_cast<size_t>(FLAGS_http_client_max_connections_per_host));
+}
+
+TEST(HttpClient, unreachable) {
+    AsyncHttpClient client(1);
+    {
+        HttpRequest request;
+        request.url = "http://127.0.0.1:1/path";
+        auto result = client.send(std::move(request)).get();
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        HttpRequest request;
+        request.url = "https://127.0.0.1/path";
+        auto result = client.send(std::move(request)).get();
+        ASSERT_FALSE(result.ok());
+    }
+}
+
+TEST(HttpResponseParser, parse) {
+    HttpResponseParser parser;
+    {
+        // Two pipelined responses, fed byte by byte
+        std::string data = "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello"
+                           "HTTP/1.1 404 Not Found\r\nTransfer-Encoding: chunked\r\n\r\n"
+                           "3\r\nfoo\r\n3;ext=1\r\nbar\r\n0\r\nX-Trailer: 1\r\n\r\n";
+        std::vector<HttpResponse> responses;
+        parser.reset();
+        for (auto c : data) {
+            folly::StringPiece piece(&c, 1);
+            ASSERT_TRUE(parser.parse(piece).ok());
+            ASSERT_TRUE(piece.empty());
+            if (parser.done()) {
+                responses.emplace_back(parser.release());
+                parser.reset();
+            }
+        }
+        ASSERT_EQ(2, responses.size());
+        ASSERT_EQ(200, responses[0].status);
+        ASSERT_EQ("hello", responses[0].body);
+        ASSERT_EQ(404, responses[1].status);
+        ASSERT_EQ("foobar", responses[1].body);
+        ASSERT_TRUE(parser.keepAlive());
+    }
+    {
+        // Body delimited by closing of the connection
+        parser.reset();
+        folly::StringPiece data = "HTTP/1.0 200 OK\r\n\r\nuntil close";
+        ASSERT_TRUE(parser.parse(data).ok());
+        ASSERT_FALSE(parser.done());
+        ASSERT_TRUE(parser.onEof().ok());
+        ASSERT_TRUE(parser.done());
+        ASSERT_FALSE(parser.keepAlive());
+        ASSERT_EQ("until close", parser.release().body);
+    }
+    {
+        // Truncated
+        parser.reset();
+        folly::StringPiece data = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nhello";
+        ASSERT_TRUE(parser.parse(data).ok());
+        ASSERT_FALSE(parser.onEof().ok());
+    }
+    {
+        // Malformed
+        parser.reset();
+        folly::StringPiece data = "HTTP/1.1 abc OK\r\n\r\n";
+        ASSERT_FALSE(parser.parse(data).ok());
+    }
+}
+
 }   // namespace http
 }   // namespace nebula
 
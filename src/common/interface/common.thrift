@@ -139,6 +139,9 @@ struct Row {
 struct DataSet {
     1: list<binary>    column_names;   // Column names
     2: list<Row>       rows;
+    // The rows packed column by column in place of `rows', see datatypes/PackedRows.h,
+    // which is only written to the receivers asking for it
+    3: optional binary packed_rows;
 } (cpp.type = "nebula::DataSet")
 
 
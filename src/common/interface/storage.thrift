@@ -165,7 +165,14 @@ struct GetNeighborsRequest {
     // partId => rows
     3: map<common.PartitionID, list<common.Row>>
         (cpp.template = "std::unordered_map")   parts,
-    4: TraverseSpec                             traverse_spec;
+    4: TraverseSpec                             traverse_spec,
+    // Whether the vertices of the response could be returned as packed_rows
+    5: optional bool                            accept_packed_rows = false,
+    // If set, the vertices are returned in the chunks of about chunk_bytes, each of which
+    //   ends at a source vertex. The next chunk is asked for by the same request with the
+    //   cursor set to the next_cursor of the response
+    6: optional i64                             chunk_bytes,
+    7: optional binary                          cursor;
 }
 
 
@@ -223,6 +230,8 @@ struct GetNeighborsResponse {
     //   "_expr:<alias1>:<alias2>:..."
     //
     2: optional common.DataSet vertices,
+    // Where the next chunk starts, if chunk_bytes of the request is set and there is more
+    3: optional binary next_cursor,
 }
 /*
  * End of GetNeighbors section
@@ -543,6 +552,8 @@ struct ScanVertexRequest {
     9: bool                                 only_latest_version = false,
     // if set to false, forbid follower read
     10: bool                                enable_read_from_follower = true,
+    // the data in this response is cut after about chunk_bytes, even if less than limit
+    11: optional i64                        chunk_bytes,
 }
 
 struct ScanVertexResponse {
@@ -573,6 +584,8 @@ struct ScanEdgeRequest {
     9: bool                                only_latest_version = false,
     // if set to false, forbid follower read
     10: bool                                enable_read_from_follower = true,
+    // the data in this response is cut after about chunk_bytes, even if less than limit
+    11: optional i64                        chunk_bytes,
 }
 
 struct ScanEdgeResponse {
@@ -132,6 +132,7 @@ void NebulaSchemaProvider::addField(folly::StringPiece name,
                          nullFlagPos);
     fieldNameIndex_.emplace(name.toString(),
                             static_cast<int64_t>(fields_.size() - 1));
+    std::atomic_store(&propLayout_, std::shared_ptr<const PropLayout>());
 }
 
 /*static*/
@@ -211,5 +212,21 @@ StatusOr<std::pair<std::string, int64_t>> NebulaSchemaProvider::getTTLInfo() con
     return std::make_pair(ttlCol, ttlDuration);
 }
 
+
+std::shared_ptr<const PropLayout> NebulaSchemaProvider::propLayout() const {
+    auto layout = std::atomic_load(&propLayout_);
+    if (layout == nullptr) {
+        std::vector<std::string> names;
+        names.reserve(fields_.size());
+        for (const auto& field : fields_) {
+            names.emplace_back(field.name());
+        }
+        // Racing ones build the same interned layout
+        layout = PropLayout::intern(std::move(names));
+        std::atomic_store(&propLayout_, layout);
+    }
+    return layout;
+}
+
 }  // namespace meta
 }  // namespace nebula
@@ -10,6 +10,7 @@
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include <folly/RWSpinLock.h>
+#include "common/datatypes/Props.h"
 #include "common/meta/SchemaProviderIf.h"
 
 namespace nebula {
@@ -117,6 +118,9 @@ public:
 
     StatusOr<std::pair<std::string, int64_t>> getTTLInfo() const;
 
+    // Names of the fields in order, to be shared by the props read with the schema
+    std::shared_ptr<const PropLayout> propLayout() const;
+
 protected:
     NebulaSchemaProvider() = default;
 
@@ -128,6 +132,8 @@ protected:
     std::vector<SchemaField>                    fields_;
     size_t                                      numNullableFields_;
     cpp2::SchemaProp                            schemaProp_;
+    // Built on demand, and reset whenever a field is added
+    mutable std::shared_ptr<const PropLayout>   propLayout_;
 };
 
 }  // namespace meta
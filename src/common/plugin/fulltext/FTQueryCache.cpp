@@ -0,0 +1,103 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/plugin/fulltext/FTQueryCache.h"
+#include "common/time/WallClock.h"
+
+DEFINE_int32(ft_query_cache_capacity, 0,
+             "Max number of fulltext lookup results to cache, 0 to disable the cache. "
+             "The writes through the listeners of storage are only covered by the TTL");
+DEFINE_int32(ft_query_cache_ttl_ms, 10000,
+             "Time in milliseconds a cached fulltext lookup result lives, 0 to disable the cache");
+
+namespace nebula {
+namespace plugin {
+
+FTQueryCache::FTQueryCache(size_t capacity, int64_t ttlMs) : ttlMs_(ttlMs) {
+    if (capacity > 0 && ttlMs > 0) {
+        // ConcurrentLRUCache requires more entries than its 16 buckets
+        cache_ = std::make_unique<ConcurrentLRUCache<std::string, std::shared_ptr<const Entry>>>(
+            std::max<size_t>(capacity, 32));
+    }
+    hits_ = StatsManager::registerStats("ft_query_cache_hits", "rate, sum");
+    misses_ = StatsManager::registerStats("ft_query_cache_misses", "rate, sum");
+}
+
+// static
+FTQueryCache& FTQueryCache::instance() {
+    static FTQueryCache cache(std::max(FLAGS_ft_query_cache_capacity, 0),
+                              FLAGS_ft_query_cache_ttl_ms);
+    return cache;
+}
+
+uint64_t FTQueryCache::generation(const std::string& index) const {
+    folly::RWSpinLock::ReadHolder rh(lock_);
+    auto it = generations_.find(index);
+    return it == generations_.end() ? base_ : it->second;
+}
+
+bool FTQueryCache::get(const std::string& index,
+                       const std::string& key,
+                       std::vector<std::string>& rows) {
+    if (!enabled()) {
+        return false;
+    }
+    auto entry = cache_->get(key);
+    if (entry.ok()) {
+        auto& e = entry.value();
+        if (e->expireAt > time::WallClock::fastNowInMilliSec() &&
+            e->generation == generation(index)) {
+            rows.insert(rows.end(), e->rows.begin(), e->rows.end());
+            StatsManager::addValue(hits_);
+            return true;
+        }
+        cache_->evict(key);
+    }
+    StatsManager::addValue(misses_);
+    return false;
+}
+
+void FTQueryCache::put(const std::string& index,
+                       std::string key,
+                       const std::vector<std::string>& rows,
+                       uint64_t gen) {
+    if (!enabled() || gen != generation(index)) {
+        // The index has been written since the query was sent
+        return;
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->generation = gen;
+    entry->expireAt = time::WallClock::fastNowInMilliSec() + ttlMs_;
+    entry->rows = rows;
+    cache_->insert(std::move(key), std::move(entry));
+}
+
+void FTQueryCache::invalidate(const std::string& index) {
+    if (!enabled()) {
+        return;
+    }
+    folly::RWSpinLock::WriteHolder wh(lock_);
+    generations_[index] = ++counter_;
+}
+
+void FTQueryCache::remove(const std::string& index) {
+    if (!enabled()) {
+        return;
+    }
+    folly::RWSpinLock::WriteHolder wh(lock_);
+    generations_.erase(index);
+    // Stales the results of all the indexes without a generation of their own, this one included
+    base_ = ++counter_;
+}
+
+void FTQueryCache::clear() {
+    if (enabled()) {
+        cache_->clear();
+    }
+}
+
+}  // namespace plugin
+}  // namespace nebula
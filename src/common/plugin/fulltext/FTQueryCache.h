@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_PLUGIN_FULLTEXT_FTQUERYCACHE_H_
+#define COMMON_PLUGIN_FULLTEXT_FTQUERYCACHE_H_
+
+#include "common/base/Base.h"
+#include "common/base/ConcurrentLRUCache.h"
+#include "common/stats/StatsManager.h"
+#include <folly/RWSpinLock.h>
+
+DECLARE_int32(ft_query_cache_capacity);
+DECLARE_int32(ft_query_cache_ttl_ms);
+
+namespace nebula {
+namespace plugin {
+
+/**
+ * FTQueryCache keeps the rows of recent fulltext lookups, which expire after
+ * `FLAGS_ft_query_cache_ttl_ms'.
+ *
+ * Each index has a generation, which is bumped by `invalidate' whenever the index is written
+ * in this process. A cached result is only served if it was fetched in the current generation
+ * of its index. Writes from other processes are only covered by the TTL, which are all of them
+ * for the indexes fed by the listeners of storage. So it is disabled unless
+ * `FLAGS_ft_query_cache_capacity' is set.
+ *
+ * The generations are taken from one counter, so that the generation of an index dropped by
+ * `remove' is never seen again, even if an index of the same name is created later.
+ */
+class FTQueryCache final {
+public:
+    FTQueryCache(size_t capacity, int64_t ttlMs);
+
+    static FTQueryCache& instance();
+
+    bool enabled() const {
+        return cache_ != nullptr;
+    }
+
+    // The generation of `index', to be taken before sending the query
+    uint64_t generation(const std::string& index) const;
+
+    // To append the cached rows to `rows', return false if it is missed
+    bool get(const std::string& index, const std::string& key, std::vector<std::string>& rows);
+
+    void put(const std::string& index,
+             std::string key,
+             const std::vector<std::string>& rows,
+             uint64_t gen);
+
+    // To drop all the cached results of `index'
+    void invalidate(const std::string& index);
+
+    // To forget `index' which is dropped, along with its cached results
+    void remove(const std::string& index);
+
+    void clear();
+
+private:
+    struct Entry {
+        uint64_t                            generation{0};
+        int64_t                             expireAt{0};
+        std::vector<std::string>            rows;
+    };
+
+    const int64_t                                                       ttlMs_;
+    std::unique_ptr<ConcurrentLRUCache<std::string, std::shared_ptr<const Entry>>>  cache_;
+    mutable folly::RWSpinLock                                           lock_;
+    std::unordered_map<std::string, uint64_t>                           generations_;
+    // The last generation taken
+    uint64_t                                                            counter_{0};
+    // The generation of the indexes not in `generations_'
+    uint64_t                                                            base_{0};
+    CounterId                                                           hits_;
+    CounterId                                                           misses_;
+};
+
+}  // namespace plugin
+}  // namespace nebula
+
+#endif  // COMMON_PLUGIN_FULLTEXT_FTQUERYCACHE_H_
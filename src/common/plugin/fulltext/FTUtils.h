@@ -14,14 +14,10 @@
 #include "common/encryption/MD5Utils.h"
 #include "common/encryption/Base64.h"
 #include "common/base/CommonMacro.h"
+#include "common/http/HttpClient.h"
 
-#define CURL "/usr/bin/curl"
-#define XPUT " -XPUT"
-#define XPOST " -XPOST"
-#define XGET " -XGET"
-#define XDELETE " -XDELETE"
-#define CURL_CONTENT_JSON " -H \"Content-Type: application/json; charset=utf-8\""
-#define CURL_CONTENT_NDJSON " -H \"Content-Type: application/x-ndjson; charset=utf-8\""
+#define CONTENT_JSON "application/json; charset=utf-8"
+#define CONTENT_NDJSON "application/x-ndjson; charset=utf-8"
 #define ESCAPE_SINGLE_QUOTE  "\'\\\'\'"
 
 namespace nebula {
@@ -78,6 +74,7 @@ struct HttpClient {
         password.clear();
     }
 
+    // The auth and the url prefix as the curl command line took them, kept for the callers
     std::string toString() const {
         std::stringstream os;
         if (!user.empty()) {
@@ -89,6 +86,28 @@ struct HttpClient {
         os << " \"http://" << host.host << ":" << host.port << "/";
         return os.str();
     }
+
+    // e.g. http://127.0.0.1:9200/index1/_search
+    std::string url(const std::string& path) const {
+        return folly::stringPrintf("http://%s:%d/%s", host.host.c_str(), host.port, path.c_str());
+    }
+
+    // To build a request to the host, authorized by the basic scheme if the user is given
+    http::HttpRequest request(const std::string& method,
+                              const std::string& path,
+                              const std::string& contentType = CONTENT_JSON,
+                              std::string body = "") const {
+        http::HttpRequest req;
+        req.method = method;
+        req.url = url(path);
+        req.headers.emplace_back("Content-Type", contentType);
+        if (!user.empty()) {
+            req.headers.emplace_back("Authorization",
+                                     "Basic " + encryption::Base64::encode(user + ":" + password));
+        }
+        req.body = std::move(body);
+        return req;
+    }
 };
 
 struct DocItem {
@@ -173,6 +192,7 @@ struct DocIDTraits {
         return ((v.size() > MAX_INDEX_TYPE_LENGTH) ? v.substr(0, MAX_INDEX_TYPE_LENGTH) : v);
     }
 
+    // Deprecated, no quoting is needed since the requests are no longer sent by the shell
     static std::string normalizedJson(const std::string &v) {
         return boost::replace_all_copy(v, "'", ESCAPE_SINGLE_QUOTE);
     }
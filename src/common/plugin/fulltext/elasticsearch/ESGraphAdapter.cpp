@@ -4,7 +4,7 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
-#include "common/process/ProcessUtils.h"
+#include "common/plugin/fulltext/FTQueryCache.h"
 #include "common/plugin/fulltext/elasticsearch/ESGraphAdapter.h"
 
 namespace nebula {
@@ -17,42 +17,21 @@ StatusOr<bool> ESGraphAdapter::prefix(const HttpClient& client,
                                       const DocItem& item,
                                       const LimitItem& limit,
                                       std::vector<std::string>& rows) const {
-    std::string cmd = header(client, item, limit) +
-                      body(item, limit.maxRows_, FT_SEARCH_OP::kPrefix);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
-    if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http GET Failed: " << cmd;
-        return Status::Error("command failed : %s", cmd.c_str());
-    }
-    return result(ret.value(), rows);
+    return search(client, item, limit, FT_SEARCH_OP::kPrefix, rows);
 }
 
 StatusOr<bool> ESGraphAdapter::wildcard(const HttpClient& client,
                               const DocItem& item,
                               const LimitItem& limit,
                               std::vector<std::string>& rows) const {
-    std::string cmd = header(client, item, limit) +
-                      body(item, limit.maxRows_, FT_SEARCH_OP::kWildcard);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
-    if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http GET Failed: " << cmd;
-        return Status::Error("command failed : %s", cmd.c_str());
-    }
-    return result(ret.value(), rows);
+    return search(client, item, limit, FT_SEARCH_OP::kWildcard, rows);
 }
 
 StatusOr<bool> ESGraphAdapter::regexp(const HttpClient& client,
                                       const DocItem& item,
                                       const LimitItem& limit,
                                       std::vector<std::string>& rows) const {
-    std::string cmd = header(client, item, limit) +
-                      body(item, limit.maxRows_, FT_SEARCH_OP::kRegexp);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
-    if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http GET Failed: " << cmd;
-        return Status::Error("command failed : %s", cmd.c_str());
-    }
-    return result(ret.value(), rows);
+    return search(client, item, limit, FT_SEARCH_OP::kRegexp, rows);
 }
 
 StatusOr<bool> ESGraphAdapter::fuzzy(const HttpClient& client,
@@ -61,31 +40,77 @@ StatusOr<bool> ESGraphAdapter::fuzzy(const HttpClient& client,
                                      const folly::dynamic& fuzziness,
                                      const std::string& op,
                                      std::vector<std::string>& rows) const {
-    std::string cmd = header(client, item, limit) +
-                      body(item, limit.maxRows_, FT_SEARCH_OP::kFuzzy, fuzziness, op);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
+    return search(client, item, limit, FT_SEARCH_OP::kFuzzy, rows, fuzziness, op);
+}
+
+StatusOr<bool> ESGraphAdapter::search(const HttpClient& client,
+                                      const DocItem& item,
+                                      const LimitItem& limit,
+                                      FT_SEARCH_OP type,
+                                      std::vector<std::string>& rows,
+                                      const folly::dynamic& fuzziness,
+                                      const std::string& op) const {
+    auto& cache = FTQueryCache::instance();
+    std::string key;
+    uint64_t generation = 0;
+    if (cache.enabled()) {
+        key = cacheKey(client, item, limit, type, fuzziness, op);
+        if (cache.get(item.index, key, rows)) {
+            return true;
+        }
+        generation = cache.generation(item.index);
+    }
+
+    auto request = client.request("GET",
+                                  searchPath(item, limit),
+                                  CONTENT_JSON,
+                                  body(item, limit.maxRows_, type, fuzziness, op));
+    auto url = request.url;
+    auto ret = http::HttpClient::sendAsync(std::move(request)).get();
     if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http GET Failed: " << cmd;
-        return Status::Error("command failed : %s", cmd.c_str());
+        LOG(ERROR) << "Http GET Failed: " << url;
+        return Status::Error("Http GET failed : %s", url.c_str());
+    }
+    auto offset = rows.size();
+    if (!result(ret.value(), rows)) {
+        return false;
     }
-    return result(ret.value(), rows);
+    if (cache.enabled()) {
+        std::vector<std::string> fetched(rows.begin() + offset, rows.end());
+        cache.put(item.index, std::move(key), fetched, generation);
+    }
+    return true;
 }
 
-std::string ESGraphAdapter::header() const noexcept {
-    std::stringstream os;
-    os << CURL << CURL_CONTENT_JSON;
-    return os.str();
+std::string ESGraphAdapter::cacheKey(const HttpClient& client,
+                                     const DocItem& item,
+                                     const LimitItem& limit,
+                                     FT_SEARCH_OP type,
+                                     const folly::dynamic& fuzziness,
+                                     const std::string& op) const {
+    // Fields are prefixed with their length, so that they could not run into each other
+    std::string key;
+    auto append = [&key] (folly::StringPiece field) {
+        folly::toAppend(field.size(), ':', field, &key);
+    };
+    append(client.url(""));
+    // The results are only shared by those of the same credentials
+    append(client.user);
+    append(client.password);
+    append(item.index);
+    append(item.column);
+    folly::toAppend(static_cast<int32_t>(type), ':', &key);
+    append(item.val);
+    append(fuzziness.isNull() ? "" : folly::toJson(fuzziness));
+    append(op);
+    folly::toAppend(limit.timeout_, ':', limit.maxRows_, &key);
+    return key;
 }
 
-std::string ESGraphAdapter::header(const HttpClient& client,
-                                   const DocItem& item,
-                                   const LimitItem& limit) const noexcept {
-    //    curl -H "Content-Type: application/json; charset=utf-8"
-    //    -XGET http://127.0.0.1:9200/my_temp_index_3/_search?timeout=10ms
-    std::stringstream os;
-    os << CURL << CURL_CONTENT_JSON << XGET;
-    os << client.toString() << item.index << "/_search?timeout=" << limit.timeout_ << "ms" << "\"";
-    return os.str();
+std::string ESGraphAdapter::searchPath(const DocItem& item,
+                                       const LimitItem& limit) const noexcept {
+    //    my_temp_index_3/_search?timeout=10ms
+    return folly::stringPrintf("%s/_search?timeout=%dms", item.index.c_str(), limit.timeout_);
 }
 
 folly::dynamic ESGraphAdapter::columnBody(const std::string& col) const noexcept {
@@ -124,9 +149,7 @@ std::string ESGraphAdapter::body(const DocItem& item,
                                                      ("_source", "value")
                                                      ("size", maxRows)
                                                      ("from", 0);
-    std::stringstream os;
-    os << " -d'" << DocIDTraits::normalizedJson(folly::toJson(itemQuery)) << "'";
-    return os.str();
+    return folly::toJson(itemQuery);
 }
 
 folly::dynamic ESGraphAdapter::prefixBody(const std::string& prefix) const noexcept {
@@ -162,63 +185,58 @@ folly::dynamic ESGraphAdapter::fuzzyBody(const std::string& regexp,
 StatusOr<bool> ESGraphAdapter::createIndex(const HttpClient& client,
                                            const std::string& index,
                                            const std::string&) const {
-    // curl -H "Content-Type: application/json; charset=utf-8"
-    //      -XPUT "http://127.0.0.1:9200/index_exist"
-    std::string cmd = createIndexCmd(client, index);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
+    // PUT http://127.0.0.1:9200/index_exist
+    auto request = createIndexRequest(client, index);
+    auto url = request.url;
+    auto ret = http::HttpClient::sendAsync(std::move(request)).get();
     if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http PUT Failed: " << cmd;
-        return Status::Error("command failed : %s", cmd.c_str());
+        LOG(ERROR) << "Http PUT Failed: " << url;
+        return Status::Error("Http PUT failed : %s", url.c_str());
     }
     return statusCheck(ret.value());
 }
 
-std::string ESGraphAdapter::createIndexCmd(const HttpClient& client,
+http::HttpRequest ESGraphAdapter::createIndexRequest(const HttpClient& client,
     const std::string& index, const std::string&) const noexcept {
-    std::stringstream os;
-    os << header() << XPUT << client.toString() << index << "\"";
-    return os.str();
+    return client.request("PUT", index);
 }
 
 StatusOr<bool> ESGraphAdapter::dropIndex(const HttpClient& client,
                                          const std::string& index) const {
-    // curl -H "Content-Type: application/json; charset=utf-8"
-    //      -XDELETE "http://127.0.0.1:9200/index_exist"
-    std::string cmd = dropIndexCmd(client, index);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
+    // DELETE http://127.0.0.1:9200/index_exist
+    auto request = dropIndexRequest(client, index);
+    auto url = request.url;
+    auto ret = http::HttpClient::sendAsync(std::move(request)).get();
+    FTQueryCache::instance().remove(index);
     if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http DELETE Failed: " << cmd;
-        return Status::Error("command failed : %s", cmd.c_str());
+        LOG(ERROR) << "Http DELETE Failed: " << url;
+        return Status::Error("Http DELETE failed : %s", url.c_str());
     }
     return statusCheck(ret.value());
 }
 
-std::string ESGraphAdapter::dropIndexCmd(const HttpClient& client,
+http::HttpRequest ESGraphAdapter::dropIndexRequest(const HttpClient& client,
     const std::string& index) const noexcept {
-    std::stringstream os;
-    os << header() << XDELETE << client.toString() << index << "\"";
-    return os.str();
+    return client.request("DELETE", index);
 }
 
 StatusOr<bool> ESGraphAdapter::indexExists(const HttpClient& client,
                                            const std::string& index) const {
-    // curl -H "Content-Type: application/json; charset=utf-8"
-    // -XGET "http://127.0.0.1:9200/_cat/indices/index_exist?format=json"
-    std::string cmd = indexExistsCmd(client, index);
-    auto ret = nebula::ProcessUtils::runCommand(cmd.c_str());
+    // GET http://127.0.0.1:9200/_cat/indices/index_exist?format=json
+    auto request = indexExistsRequest(client, index);
+    auto url = request.url;
+    auto ret = http::HttpClient::sendAsync(std::move(request)).get();
     if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http GET Failed: " << cmd;
-        return Status::Error("Http GET Failed: : %s", cmd.c_str());
+        LOG(ERROR) << "Http GET Failed: " << url;
+        return Status::Error("Http GET failed : %s", url.c_str());
     }
     return indexCheck(ret.value());
 }
 
-std::string ESGraphAdapter::indexExistsCmd(const HttpClient& client,
-                                           const std::string& index) const noexcept {
-    std::stringstream os;
-    os << header() << XGET << client.toString()
-       << "_cat/indices/" << index << "?format=json" << "\"";
-    return os.str();
+http::HttpRequest ESGraphAdapter::indexExistsRequest(const HttpClient& client,
+                                                     const std::string& index) const noexcept {
+    return client.request("GET", folly::stringPrintf("_cat/indices/%s?format=json",
+                                                     index.c_str()));
 }
 
 bool ESGraphAdapter::result(const std::string& ret, std::vector<std::string>& rows) const {
@@ -21,6 +21,7 @@ class ESGraphAdapter final : public FTGraphAdapter {
     FRIEND_TEST(FulltextPluginTest, ESFuzzyTest);
     FRIEND_TEST(FulltextPluginTest, ESCreateIndexTest);
     FRIEND_TEST(FulltextPluginTest, ESDropIndexTest);
+    FRIEND_TEST(FulltextPluginTest, ESQueryCacheTest);
 
 public:
     static std::unique_ptr<FTGraphAdapter> kAdapter;
@@ -60,11 +61,23 @@ public:
 private:
     ESGraphAdapter() {}
 
-    std::string header() const noexcept;
+    // The results are served from FTQueryCache if possible
+    StatusOr<bool> search(const HttpClient& client,
+                          const DocItem& item,
+                          const LimitItem& limit,
+                          FT_SEARCH_OP type,
+                          std::vector<std::string>& rows,
+                          const folly::dynamic& fuzziness = nullptr,
+                          const std::string& op = "") const;
+
+    std::string cacheKey(const HttpClient& client,
+                         const DocItem& item,
+                         const LimitItem& limit,
+                         FT_SEARCH_OP type,
+                         const folly::dynamic& fuzziness = nullptr,
+                         const std::string& op = "") const;
 
-    std::string header(const HttpClient& client,
-                       const DocItem& item,
-                       const LimitItem& limit) const noexcept;
+    std::string searchPath(const DocItem& item, const LimitItem& limit) const noexcept;
 
     folly::dynamic columnBody(const std::string& col) const noexcept;
 
@@ -90,15 +103,15 @@ private:
 
     bool indexCheck(const std::string& ret) const;
 
-    std::string createIndexCmd(const HttpClient& client,
-                               const std::string& index,
-                               const std::string& indexTemplate = "") const noexcept;
+    http::HttpRequest createIndexRequest(const HttpClient& client,
+                                         const std::string& index,
+                                         const std::string& indexTemplate = "") const noexcept;
 
-    std::string dropIndexCmd(const HttpClient& client,
-                             const std::string& index) const noexcept;
+    http::HttpRequest dropIndexRequest(const HttpClient& client,
+                                       const std::string& index) const noexcept;
 
-    std::string indexExistsCmd(const HttpClient& client,
-                               const std::string& index) const noexcept;
+    http::HttpRequest indexExistsRequest(const HttpClient& client,
+                                         const std::string& index) const noexcept;
 };
 }  // namespace plugin
 }  // namespace nebula
@@ -4,24 +4,107 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
-#include <common/plugin/fulltext/FTUtils.h>
-#include "common/process/ProcessUtils.h"
+#include "common/http/AsyncHttpClient.h"
+#include "common/plugin/fulltext/FTQueryCache.h"
+#include "common/plugin/fulltext/FTUtils.h"
 #include "common/plugin/fulltext/elasticsearch/ESStorageAdapter.h"
+#include <folly/ScopeGuard.h>
+
+DEFINE_int32(ft_bulk_max_bytes, 4 * 1024 * 1024,
+             "Max size in bytes of the body of one bulk request to the fulltext index");
+DEFINE_int32(ft_bulk_max_inflight, 4,
+             "Max number of bulk requests in flight at the same time");
+DEFINE_int32(ft_bulk_max_retries, 3,
+             "Max times to retry the items failed with a retryable error");
+DEFINE_int32(ft_bulk_retry_interval_ms, 100,
+             "Interval in milliseconds to retry the failed items, which grows every round");
 
 namespace nebula {
 namespace plugin {
+
+namespace {
+
+// Too many requests, or the errors of the server, which may pass in a while
+bool transient(int64_t status) {
+    return status == 429 || status >= 500;
+}
+
+// Just enough JSON scanning to walk through the bulk response without building the document
+
+void skipSpace(folly::StringPiece& s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+        s.advance(1);
+    }
+}
+
+// `s' starts with the opening quote
+bool skipString(folly::StringPiece& s) {
+    for (size_t i = 1; i < s.size(); i++) {
+        if (s[i] == '\\') {
+            i++;
+        } else if (s[i] == '"') {
+            s.advance(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool skipValue(folly::StringPiece& s) {
+    skipSpace(s);
+    if (s.empty()) {
+        return false;
+    }
+    if (s.front() == '"') {
+        return skipString(s);
+    }
+    if (s.front() == '{' || s.front() == '[') {
+        int32_t depth = 0;
+        while (!s.empty()) {
+            auto c = s.front();
+            if (c == '"') {
+                if (!skipString(s)) {
+                    return false;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    s.advance(1);
+                    return true;
+                }
+            }
+            s.advance(1);
+        }
+        return false;
+    }
+    // Number, true, false or null
+    size_t i = 0;
+    while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ']' &&
+           !std::isspace(static_cast<unsigned char>(s[i]))) {
+        i++;
+    }
+    s.advance(i);
+    return i > 0;
+}
+
+}   // namespace
+
 std::unique_ptr<FTStorageAdapter> ESStorageAdapter::kAdapter =
     std::unique_ptr<ESStorageAdapter>(new ESStorageAdapter());
 
-bool ESStorageAdapter::checkPut(const std::string& ret, const std::string& cmd) const {
+bool ESStorageAdapter::checkPut(const std::string& ret, const std::string& url) const {
     // For example :
     //     HostAddr localHost_{"127.0.0.1", 9200};
     //     DocItem item("index1", "col1", 1, 2, "aaaa");
     //
-    // Command should be :
-    //    /usr/bin/curl -H "Content-Type: application/json; charset=utf-8"
-    //    -XPUT "http://127.0.0.1:9200/index1/_doc/0000000001_0000000002_8c43de7b01bca674276c43e09b3ec5ba_aaaa"  // NOLINT
-    //    -d'{"value":"aaaa","schema_id":2,"column_id":"8c43de7b01bca674276c43e09b3ec5ba"}'
+    // Request should be :
+    //    PUT http://127.0.0.1:9200/index1/_doc/0000000001_0000000002_8c43de7b01bca674276c43e09b3ec5ba_aaaa  // NOLINT
+    //    Content-Type: application/json; charset=utf-8
+    //
+    //    {"value":"aaaa","schema_id":2,"column_id":"8c43de7b01bca674276c43e09b3ec5ba"}
     //
     // If successful, the result is returned:
     //    {
@@ -48,23 +131,27 @@ bool ESStorageAdapter::checkPut(const std::string& ret, const std::string& cmd)
     } catch (std::exception &e) {
         LOG(ERROR) << "result error : " << e.what();
     }
-    VLOG(3) << "Command : " <<cmd << "failed : " << ret;
+    VLOG(3) << "Put " << url << " failed : " << ret;
     return false;
 }
 
-bool ESStorageAdapter::checkBulk(const std::string& ret) const {
+bool ESStorageAdapter::checkBulk(const std::string& ret,
+                                 size_t count,
+                                 std::vector<size_t>& retry,
+                                 std::vector<size_t>& failed) const {
     // For example :
     //     HostAddr localHost_{"127.0.0.1", 9200};
     //     DocItem item("bulk_index", "col1", 1, 2, "row_1")
     //                 ("bulk_index", "col1", 1, 2, "row_2")
     //
-    // Command should be :
-    //    curl  -H "Content-Type: application/x-ndjson" -XPOST localhost:9200/_bulk -d '
+    // Request should be :
+    //    POST http://127.0.0.1:9200/_bulk
+    //    Content-Type: application/x-ndjson; charset=utf-8
+    //
     //    { "index" : { "_index" : "bulk_index", "_id" : "1" } }
     //    { "schema_id" : 1 , "column_id" : "col1", "value" : "row_1"}
     //    { "index" : { "_index" : "bulk_index", "_id" : "2" } }
     //    { "schema_id" : 1 , "column_id" : "col1", "value" : "row_2"}
-    //    '
     //
     // If successful, the result is returned:
     //    {
@@ -104,112 +191,268 @@ bool ESStorageAdapter::checkBulk(const std::string& ret) const {
     //            }
     //        }]
     //    }
-    try {
-        auto root = folly::parseJson(ret);
-        auto result = root.find("errors");
-        if (result != root.items().end() && result->second.isBool() && !result->second.getBool()) {
+    //
+    // Only the items are parsed one by one, and only if `errors' is true.
+    folly::StringPiece s(ret);
+    size_t numItems = 0;
+    bool hasItems = false;
+    skipSpace(s);
+    if (!s.removePrefix('{')) {
+        VLOG(3) << "Unrecognized bulk response : " << ret;
+        return false;
+    }
+    skipSpace(s);
+    auto done = s.removePrefix('}');
+    while (!done) {
+        skipSpace(s);
+        auto begin = s;
+        if (!s.startsWith('"') || !skipString(s)) {
+            break;
+        }
+        auto key = begin.subpiece(1, begin.size() - s.size() - 2);
+        skipSpace(s);
+        if (!s.removePrefix(':')) {
+            break;
+        }
+        skipSpace(s);
+        if (key == "errors" && s.startsWith("false")) {
+            // All items succeeded
             return true;
         }
-    } catch (std::exception &e) {
-        LOG(ERROR) << "result error : " << e.what();
+        if (key == "items") {
+            if (!s.removePrefix('[')) {
+                break;
+            }
+            hasItems = true;
+            skipSpace(s);
+            auto end = s.removePrefix(']');
+            while (!end) {
+                skipSpace(s);
+                auto item = s;
+                if (!skipValue(s)) {
+                    break;
+                }
+                item = item.subpiece(0, item.size() - s.size());
+                int64_t status = 0;
+                bool rejected = false;
+                try {
+                    // {"index": {"_id": "1", "status": 429, "error": {...}}}
+                    auto obj = folly::parseJson(item);
+                    if (obj.isObject() && !obj.empty()) {
+                        const auto& result = obj.items().begin()->second;
+                        status = result.getDefault("status", 0).asInt();
+                        // es_rejected_execution_exception, of the full queues of the node
+                        auto* error = result.get_ptr("error");
+                        auto* type = error && error->isObject() ? error->get_ptr("type") : nullptr;
+                        rejected = type && type->isString() &&
+                                   type->getString().find("rejected") != std::string::npos;
+                    }
+                } catch (const std::exception& e) {
+                    LOG(ERROR) << "result error : " << e.what();
+                }
+                if (transient(status) || rejected) {
+                    retry.emplace_back(numItems);
+                } else if (status < 200 || status >= 300) {
+                    VLOG(3) << "Bulk item failed : " << item;
+                    failed.emplace_back(numItems);
+                }
+                numItems++;
+                skipSpace(s);
+                if (s.removePrefix(',')) {
+                    continue;
+                }
+                end = s.removePrefix(']');
+                if (!end) {
+                    break;
+                }
+            }
+            if (!end) {
+                break;
+            }
+        } else if (!skipValue(s)) {
+            break;
+        }
+        skipSpace(s);
+        if (s.removePrefix(',')) {
+            continue;
+        }
+        done = s.removePrefix('}');
+        if (!done) {
+            break;
+        }
     }
-    VLOG(3) << "Bulk insert failed";
-    VLOG(3) << ret;
-    return false;
+    if (!done || !hasItems || numItems != count) {
+        VLOG(3) << "Unrecognized bulk response : " << ret;
+        retry.clear();
+        failed.clear();
+        return false;
+    }
+    return true;
 }
 
 StatusOr<bool> ESStorageAdapter::put(const HttpClient& client, const DocItem& item) const {
-    auto command = putCmd(client, item);
-    auto ret = nebula::ProcessUtils::runCommand(command.c_str());
+    auto request = putRequest(client, item);
+    auto url = request.url;
+    auto ret = http::HttpClient::sendAsync(std::move(request)).get();
+    FTQueryCache::instance().invalidate(item.index);
     if (!ret.ok() || ret.value().empty()) {
-        LOG(ERROR) << "Http PUT Failed: " << command;
-        return Status::Error("command failed : %s", command.c_str());
+        LOG(ERROR) << "Http PUT Failed: " << url;
+        return Status::Error("Http PUT failed : %s", url.c_str());
     }
-    return checkPut(ret.value(), command);
+    return checkPut(ret.value(), url);
 }
 
 StatusOr<bool> ESStorageAdapter::bulk(const HttpClient& client,
                                       const std::vector<DocItem>& items) const {
-    auto command = bulkCmd(client, items);
-    if (command.empty()) {
-        return true;
+    // Items are serialized into size-capped requests, several of which are kept in flight.
+    // Those failed with a retryable error are collected and sent again in the next round.
+    auto maxBytes = static_cast<size_t>(std::max(FLAGS_ft_bulk_max_bytes, 1));
+    auto maxInflight = static_cast<size_t>(std::max(FLAGS_ft_bulk_max_inflight, 1));
+    std::vector<size_t> todo;
+    todo.reserve(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        todo.emplace_back(i);
     }
-    auto ret = nebula::ProcessUtils::runCommand(command.c_str());
-    if (!ret.ok() || ret.value().empty()) {
-        VLOG(3) << "Http PUT Failed";
-        VLOG(3) << command;
-        return Status::Error("bulk command failed");
+    // Lookups cached before are stale once anything is sent, whatever the result is
+    SCOPE_EXIT {
+        std::unordered_set<std::string> indexes;
+        for (const auto& item : items) {
+            if (indexes.emplace(item.index).second) {
+                FTQueryCache::instance().invalidate(item.index);
+            }
+        }
+    };
+    size_t numFailed = 0;
+    Status lastError = Status::OK();
+    for (int32_t round = 0; !todo.empty(); round++) {
+        if (round > FLAGS_ft_bulk_max_retries) {
+            LOG(ERROR) << "Bulk insert gave up " << todo.size() << " items after "
+                       << FLAGS_ft_bulk_max_retries << " retries";
+            if (!lastError.ok()) {
+                return lastError;
+            }
+            numFailed += todo.size();
+            break;
+        }
+        if (round > 0) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(FLAGS_ft_bulk_retry_interval_ms * round));
+        }
+        lastError = Status::OK();
+        std::vector<size_t> retry;
+        // The requests in flight, with the positions in `items' of their items
+        std::deque<std::pair<folly::Future<StatusOr<http::HttpResponse>>, std::vector<size_t>>>
+            inflight;
+        auto reap = [&] () {
+            auto ret = std::move(inflight.front().first).get();
+            auto ids = std::move(inflight.front().second);
+            inflight.pop_front();
+            // The request as a whole failed, retried only if the failure may pass
+            if (!ret.ok()) {
+                lastError = ret.status();
+                retry.insert(retry.end(), ids.begin(), ids.end());
+                return;
+            }
+            const auto& resp = ret.value();
+            if (transient(resp.status)) {
+                lastError = Status::Error("Bulk request failed with status %d", resp.status);
+                retry.insert(retry.end(), ids.begin(), ids.end());
+                return;
+            }
+            std::vector<size_t> retryPos;
+            std::vector<size_t> failedPos;
+            if (resp.status < 200 || resp.status >= 300 ||
+                !checkBulk(resp.body, ids.size(), retryPos, failedPos)) {
+                // e.g. 400 of a bad mapping, which would fail the same again
+                LOG(ERROR) << "Bulk request failed with status " << resp.status << " : "
+                           << resp.body;
+                numFailed += ids.size();
+                return;
+            }
+            for (auto pos : retryPos) {
+                retry.emplace_back(ids[pos]);
+            }
+            numFailed += failedPos.size();
+        };
+
+        std::string body;
+        std::vector<size_t> ids;
+        auto flush = [&] () {
+            while (inflight.size() >= maxInflight) {
+                reap();
+            }
+            auto future = http::AsyncHttpClient::instance().send(
+                bulkRequest(client, std::move(body)));
+            inflight.emplace_back(std::move(future), std::move(ids));
+            body.clear();
+            ids.clear();
+        };
+        for (auto id : todo) {
+            appendBulkItem(items[id], body);
+            ids.emplace_back(id);
+            if (body.size() >= maxBytes) {
+                flush();
+            }
+        }
+        if (!ids.empty()) {
+            flush();
+        }
+        while (!inflight.empty()) {
+            reap();
+        }
+        todo = std::move(retry);
     }
-    return checkBulk(ret.value());
+    if (numFailed > 0) {
+        VLOG(3) << "Bulk insert failed " << numFailed << " of " << items.size() << " items";
+        return false;
+    }
+    return true;
 }
 
-std::string ESStorageAdapter::putHeader(const HttpClient& client,
-                                        const DocItem& item) const noexcept {
-    //    curl -H "Content-Type: application/json; charset=utf-8"
-    //    -XPUT "http://127.0.0.1:9200/my_temp_index_3/_doc/part1|tag4|col4|hello"
-    std::stringstream os;
-    os << CURL << CURL_CONTENT_JSON << XPUT;
-    os << client.toString() << item.index << "/_doc/" << DocIDTraits::docId(item) << "\"";
-    return os.str();
+std::string ESStorageAdapter::putPath(const DocItem& item) const noexcept {
+    //    my_temp_index_3/_doc/part1|tag4|col4|hello
+    return folly::stringPrintf("%s/_doc/%s", item.index.c_str(), DocIDTraits::docId(item).c_str());
 }
 
 std::string ESStorageAdapter::putBody(const DocItem& item) const noexcept {
-    //    -d'{"column_id" : "col4", "value" : "hello"}'
+    //    {"column_id" : "col4", "value" : "hello"}
     folly::dynamic d = folly::dynamic::object("column_id", DocIDTraits::column(item.column))
                                              ("value", DocIDTraits::val(item.val));
-    std::stringstream os;
-    os << " -d'" << DocIDTraits::normalizedJson(folly::toJson(d)) << "'";
-    return os.str();
+    return folly::toJson(d);
 }
 
-std::string ESStorageAdapter::putCmd(const HttpClient& client,
-                                     const DocItem& item) const noexcept {
-    std::stringstream os;
-    os << putHeader(client, item) << putBody(item);
-    return os.str();
+http::HttpRequest ESStorageAdapter::putRequest(const HttpClient& client,
+                                               const DocItem& item) const noexcept {
+    return client.request("PUT", putPath(item), CONTENT_JSON, putBody(item));
 }
 
-std::string ESStorageAdapter::bulkHeader(const HttpClient& client) const noexcept {
-    // curl  -H "Content-Type: application/x-ndjson; charset=utf-8" http://127.0.0.1:9200/_bulk
-    std::stringstream os;
-    os << CURL << CURL_CONTENT_NDJSON << XPOST;
-    os << client.toString() << "_bulk\"";
-    return os.str();
+void ESStorageAdapter::appendBulkItem(const DocItem& item, std::string& body) const {
+    //    { "index" : { "_index" : "bulk_index", "_id" : "1" } }
+    //    { "column_id" : "col1", "value" : "row_1"}
+    folly::dynamic meta = folly::dynamic::object("_id", DocIDTraits::docId(item))
+                                                ("_index", item.index);
+    folly::dynamic data = folly::dynamic::object("value", DocIDTraits::val(item.val))
+                                                ("column_id", DocIDTraits::column(item.column));
+    folly::toAppend(folly::toJson(folly::dynamic::object("index", meta)), "\n", &body);
+    folly::toAppend(folly::toJson(data), "\n", &body);
 }
 
 std::string ESStorageAdapter::bulkBody(const std::vector<DocItem>& items) const noexcept {
-    //    -d '
-    //    { "index" : { "_index" : "bulk_index", "_id" : "1" } }
-    //    { "column_id" : "col1", "value" : "row_1"}
-    //    { "index" : { "_index" : "bulk_index", "_id" : "2" } }
-    //    { "column_id" : "col1", "value" : "row_2"}
-    //    '
-    if (items.empty()) {
-        return "";
-    }
-    std::stringstream os;
-    os << " -d '" << "\n";
+    std::string body;
     for (const auto& item : items) {
-        folly::dynamic meta = folly::dynamic::object("_id", DocIDTraits::docId(item))
-                                                    ("_index", item.index);
-        folly::dynamic data = folly::dynamic::object("value", DocIDTraits::val(item.val))
-                                                    ("column_id", DocIDTraits::column(item.column));
-        os << folly::toJson(folly::dynamic::object("index", meta)) << "\n";
-        os << DocIDTraits::normalizedJson(folly::toJson(data)) << "\n";
+        appendBulkItem(item, body);
     }
-    os << "'";
-    return os.str();
+    return body;
 }
 
-std::string ESStorageAdapter::bulkCmd(const HttpClient& client,
-                                      const std::vector<DocItem>& items) const noexcept {
-    auto body = bulkBody(items);
-    if (body.empty()) {
-        return "";
-    }
-    std::stringstream os;
-    os << bulkHeader(client) << body;
-    return os.str();
+http::HttpRequest ESStorageAdapter::bulkRequest(const HttpClient& client,
+                                                const std::vector<DocItem>& items) const noexcept {
+    return bulkRequest(client, bulkBody(items));
+}
+
+http::HttpRequest ESStorageAdapter::bulkRequest(const HttpClient& client,
+                                                std::string body) const noexcept {
+    return client.request("POST", "_bulk", CONTENT_NDJSON, std::move(body));
 }
 
 }  // namespace plugin
@@ -16,6 +16,7 @@ namespace plugin {
 class ESStorageAdapter final : public FTStorageAdapter {
     FRIEND_TEST(FulltextPluginTest, ESPutTest);
     FRIEND_TEST(FulltextPluginTest, ESBulkTest);
+    FRIEND_TEST(FulltextPluginTest, ESBulkResultTest);
 
 public:
     static std::unique_ptr<FTStorageAdapter> kAdapter;
@@ -27,21 +28,34 @@ public:
 private:
     ESStorageAdapter() {}
 
-    std::string putHeader(const HttpClient& client, const DocItem& item) const noexcept;
+    std::string putPath(const DocItem& item) const noexcept;
 
     std::string putBody(const DocItem& item) const noexcept;
 
-    std::string putCmd(const HttpClient& client, const DocItem& item) const noexcept;
+    http::HttpRequest putRequest(const HttpClient& client, const DocItem& item) const noexcept;
 
-    std::string bulkHeader(const HttpClient& client) const noexcept;
+    // To serialize the action and source lines of an item into the NDJSON body
+    void appendBulkItem(const DocItem& item, std::string& body) const;
 
     std::string bulkBody(const std::vector<DocItem>& items) const noexcept;
 
-    std::string bulkCmd(const HttpClient& client, const std::vector<DocItem>& items) const noexcept;
+    http::HttpRequest bulkRequest(const HttpClient& client,
+                                  const std::vector<DocItem>& items) const noexcept;
 
-    bool checkPut(const std::string& ret, const std::string& cmd) const;
+    http::HttpRequest bulkRequest(const HttpClient& client, std::string body) const noexcept;
 
-    bool checkBulk(const std::string& ret) const;
+    bool checkPut(const std::string& ret, const std::string& url) const;
+
+    /**
+     * To check the response of a bulk request of `count' items.
+     * Positions of the failed items are appended to `retry' if the error is transient,
+     * i.e. 429, 5xx and the rejected execution, or to `failed' otherwise.
+     * Return false if the response is not a recognized bulk response.
+     */
+    bool checkBulk(const std::string& ret,
+                   size_t count,
+                   std::vector<size_t>& retry,
+                   std::vector<size_t>& failed) const;
 };
 
 }  // namespace plugin
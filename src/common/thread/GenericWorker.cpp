@@ -17,6 +17,10 @@ GenericWorker::GenericWorker() = default;
 GenericWorker::~GenericWorker() {
     stop();
     wait();
+    if (ticker_ != nullptr) {
+        event_free(ticker_);
+        ticker_ = nullptr;
+    }
     if (notifier_ != nullptr) {
         event_free(notifier_);
         notifier_ = nullptr;
@@ -58,6 +62,13 @@ bool GenericWorker::start(std::string name) {
     DCHECK(notifier_ != nullptr);
     event_add(notifier_, nullptr);
 
+    // Create the timer which drives the timing wheel
+    auto onTimeout = [] (int, int16_t, void *arg) {
+        reinterpret_cast<GenericWorker*>(arg)->onTimeout();
+    };
+    ticker_ = evtimer_new(evbase_, onTimeout, this);
+    DCHECK(ticker_ != nullptr);
+
     // Launch a new thread to run the event loop
     thread_ = std::make_unique<NamedThread>(name_, &GenericWorker::loop, this);
 
@@ -120,24 +131,11 @@ void GenericWorker::onNotify() {
             std::lock_guard<std::mutex> guard(lock_);
             newcomings.swap(pendingTimers_);
         }
-        auto cb = [] (int fd, int16_t, void *arg) {
-            UNUSED(fd);
-            auto timer = reinterpret_cast<Timer*>(arg);
-            auto worker = timer->owner_;
-            timer->callback_();
-            if (timer->intervalMSec_ == 0.0) {
-                worker->purgeTimerInternal(timer->id_);
-            }
-        };
+        auto now = nowInMSec();
+        // Bring the wheel up to date, so that the new timers are placed relative to `now'
+        processTimers(now);
         for (auto &timer : newcomings) {
-            timer->ev_ = event_new(evbase_, -1, EV_PERSIST, cb, timer.get());
-
-            auto delay = timer->delayMSec_;
-            struct timeval tv;
-            tv.tv_sec = delay / 1000;
-            tv.tv_usec = delay % 1000 * 1000;
-            evtimer_add(timer->ev_, &tv);
-
+            wheel_.schedule(timer.get(), now + timer->delayMSec_);
             auto id = timer->id_;
             activeTimers_[id] = std::move(timer);
         }
@@ -152,16 +150,57 @@ void GenericWorker::onNotify() {
             purgeTimerInternal(id);
         }
     }
+    processTimers(nowInMSec());
 }
 
-GenericWorker::Timer::Timer(std::function<void(void)> cb) {
-    callback_ = std::move(cb);
+void GenericWorker::onTimeout() {
+    tickerExpiry_ = TimerWheel::kNoExpiry;
+    processTimers(nowInMSec());
 }
 
-GenericWorker::Timer::~Timer() {
-    if (ev_ != nullptr) {
-        event_free(ev_);
+void GenericWorker::processTimers(uint64_t now) {
+    expiredTimers_.clear();
+    wheel_.advance(now, expiredTimers_);
+    for (auto *entry : expiredTimers_) {
+        auto *timer = static_cast<Timer*>(entry);
+        timer->callback_();
+        if (timer->intervalMSec_ == 0) {
+            purgeTimerInternal(timer->id_);
+        } else {
+            // Keep the period relative to the last expiration rather than `now',
+            // unless we are lagging behind
+            auto next = timer->expireTick() + timer->intervalMSec_;
+            if (next <= now) {
+                next = now + timer->intervalMSec_;
+            }
+            wheel_.schedule(timer, next);
+        }
+    }
+    expiredTimers_.clear();
+
+    auto expiry = wheel_.nextExpiryTick();
+    if (expiry == tickerExpiry_) {
+        return;
     }
+    if (expiry == TimerWheel::kNoExpiry) {
+        evtimer_del(ticker_);
+    } else {
+        auto delay = expiry > now ? expiry - now : 0UL;
+        struct timeval tv;
+        tv.tv_sec = delay / 1000;
+        tv.tv_usec = delay % 1000 * 1000;
+        evtimer_add(ticker_, &tv);
+    }
+    tickerExpiry_ = expiry;
+}
+
+uint64_t GenericWorker::nowInMSec() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+GenericWorker::Timer::Timer(std::function<void(void)> cb) {
+    callback_ = std::move(cb);
 }
 
 void GenericWorker::purgeTimerTask(uint64_t id) {
@@ -175,7 +214,7 @@ void GenericWorker::purgeTimerTask(uint64_t id) {
 void GenericWorker::purgeTimerInternal(uint64_t id) {
     auto iter = activeTimers_.find(id);
     if (iter != activeTimers_.end()) {
-        evtimer_del(iter->second->ev_);
+        wheel_.cancel(iter->second.get());
         activeTimers_.erase(iter);
     }
 }
@@ -11,6 +11,7 @@
 #include <folly/Unit.h>
 #include "common/cpp/helpers.h"
 #include "common/thread/NamedThread.h"
+#include "common/thread/TimerWheel.h"
 
 /**
  * GenericWorker implements a event-based task executor that executes tasks asynchronously
@@ -19,6 +20,10 @@
  *
  * GenericWorker executes tasks one after one, in the FIFO way, while tasks are non-preemptible.
  *
+ * Timer tasks are kept in a hierarchical timing wheel with the resolution of one millisecond,
+ * which is driven by a single libevent timer. So adding or purging a timer task is O(1),
+ * and all timers expired at the same time are handled in one batch.
+ *
  * Please NOTE that, as the name indicates, this a worker thread for the general purpose,
  * but not for the performance critical situation.
  */
@@ -135,21 +140,22 @@ private:
     void purgeTimerInternal(uint64_t id);
 
 private:
-    struct Timer {
+    struct Timer : public TimerWheel::Entry {
         explicit Timer(std::function<void(void)> cb);
-        ~Timer();
         uint64_t                                id_;
         uint64_t                                delayMSec_;
         uint64_t                                intervalMSec_;
         std::function<void(void)>               callback_;
-        struct event                           *ev_{nullptr};
-        GenericWorker                          *owner_{nullptr};
     };
 
 private:
     void loop();
     void notify();
     void onNotify();
+    void onTimeout();
+    // To run all timers expired by `now', and re-arm the ticker for the next expiration
+    void processTimers(uint64_t now);
+    static uint64_t nowInMSec();
     uint64_t nextTimerId() {
         // !NOTE! `lock_' must be hold
         return (nextTimerId_++ & TIMER_ID_MASK);
@@ -164,12 +170,16 @@ private:
     struct event_base                          *evbase_ = nullptr;
     int                                         evfd_ = -1;
     struct event                               *notifier_ = nullptr;
+    struct event                               *ticker_ = nullptr;
+    uint64_t                                    tickerExpiry_{TimerWheel::kNoExpiry};
     std::mutex                                  lock_;
     std::vector<std::function<void()>>          pendingTasks_;
     using TimerPtr = std::unique_ptr<Timer>;
     std::vector<TimerPtr>                       pendingTimers_;
     std::vector<uint64_t>                       purgingingTimers_;
     std::unordered_map<uint64_t, TimerPtr>      activeTimers_;
+    TimerWheel                                  wheel_;
+    std::vector<TimerWheel::Entry*>             expiredTimers_;
     std::unique_ptr<NamedThread>                thread_;
 };
 
@@ -278,7 +288,6 @@ uint64_t GenericWorker::addTimerTask(size_t delay,
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
     timer->delayMSec_ = delay;
     timer->intervalMSec_ = interval;
-    timer->owner_ = this;
     auto id = 0UL;
     {
         std::lock_guard<std::mutex> guard(lock_);
@@ -0,0 +1,183 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include "common/thread/TimerWheel.h"
+
+namespace nebula {
+namespace thread {
+
+TimerWheel::TimerWheel(uint64_t nowTick) : current_(nowTick) {
+    slots_ = std::make_unique<Entry[]>(kSlots * kLevels);
+    for (auto i = 0U; i < kSlots * kLevels; i++) {
+        slots_[i].prev_ = &slots_[i];
+        slots_[i].next_ = &slots_[i];
+    }
+    std::fill(std::begin(occupied_), std::end(occupied_), 0UL);
+    std::fill(std::begin(levelSize_), std::end(levelSize_), 0UL);
+}
+
+TimerWheel::~TimerWheel() = default;
+
+void TimerWheel::schedule(Entry *entry, uint64_t expireTick) {
+    DCHECK(!entry->isScheduled());
+    entry->expireTick_ = expireTick;
+    place(entry);
+}
+
+void TimerWheel::cancel(Entry *entry) {
+    if (entry->isScheduled()) {
+        unlink(entry);
+    }
+}
+
+size_t TimerWheel::advance(uint64_t nowTick, std::vector<Entry*> &expired) {
+    auto count = expired.size();
+    while (current_ <= nowTick) {
+        if (size_ == 0) {
+            current_ = nowTick + 1;
+            break;
+        }
+        auto index = static_cast<uint32_t>(current_ & kSlotMask);
+        if (index == 0) {
+            // Cascade from the highest level whose lower indices are all zero,
+            // so that entries always fall through to the right level
+            auto top = 1U;
+            while (top < kLevels - 1 &&
+                   ((current_ >> (kSlotBits * top)) & kSlotMask) == 0) {
+                top++;
+            }
+            for (auto level = top; level > 0; level--) {
+                cascade(level);
+            }
+        }
+        // Skip the idle ticks until the next occupied slot or the next cascading
+        auto skip = std::min(nextOccupied(index), kSlots - index);
+        if (skip > 0) {
+            current_ += std::min<uint64_t>(skip, nowTick - current_ + 1);
+            continue;
+        }
+        expire(index, expired);
+        current_++;
+    }
+    return expired.size() - count;
+}
+
+uint64_t TimerWheel::nextExpiryTick() const {
+    if (size_ == 0) {
+        return kNoExpiry;
+    }
+    auto index = static_cast<uint32_t>(current_ & kSlotMask);
+    // Cascading of the current tick, if any, is still pending
+    auto toCascade = index == 0 ? 0 : kSlots - index;
+    if (levelSize_[0] > 0) {
+        auto offset = nextOccupied(index);
+        if (offset < toCascade || levelSize_[0] == size_) {
+            return current_ + offset;
+        }
+    }
+    return current_ + toCascade;
+}
+
+void TimerWheel::place(Entry *entry) {
+    // Already passed ticks expire on the next one
+    auto expire = std::max(entry->expireTick_, current_);
+    auto delta = expire - current_;
+    auto level = 0U;
+    while (level < kLevels - 1 && delta >= (1UL << (kSlotBits * (level + 1)))) {
+        level++;
+    }
+    constexpr auto kMaxDelta = (1UL << (kSlotBits * kLevels)) - 1;
+    if (delta > kMaxDelta) {
+        // Out of range, park it at the farthest slot and re-place it when cascaded
+        expire = current_ + kMaxDelta;
+    }
+    auto index = static_cast<uint32_t>((expire >> (kSlotBits * level)) & kSlotMask);
+    link(level * kSlots + index, entry);
+}
+
+void TimerWheel::link(uint32_t slot, Entry *entry) {
+    auto *head = &slots_[slot];
+    entry->prev_ = head->prev_;
+    entry->next_ = head;
+    head->prev_->next_ = entry;
+    head->prev_ = entry;
+    entry->slot_ = slot;
+    size_++;
+    levelSize_[slot / kSlots]++;
+    if (slot < kSlots) {
+        occupied_[slot / kWordBits] |= (1UL << (slot % kWordBits));
+    }
+}
+
+void TimerWheel::unlink(Entry *entry) {
+    auto slot = entry->slot_;
+    entry->prev_->next_ = entry->next_;
+    entry->next_->prev_ = entry->prev_;
+    entry->prev_ = nullptr;
+    entry->next_ = nullptr;
+    size_--;
+    levelSize_[slot / kSlots]--;
+    if (slot < kSlots) {
+        auto *head = &slots_[slot];
+        if (head->next_ == head) {
+            occupied_[slot / kWordBits] &= ~(1UL << (slot % kWordBits));
+        }
+    }
+}
+
+void TimerWheel::cascade(uint32_t level) {
+    auto index = static_cast<uint32_t>((current_ >> (kSlotBits * level)) & kSlotMask);
+    auto *head = &slots_[level * kSlots + index];
+    // Detach the whole list before re-placing, in case some entry goes back to the same slot
+    auto *entry = head->next_;
+    head->prev_ = head;
+    head->next_ = head;
+    while (entry != head) {
+        auto *next = entry->next_;
+        entry->prev_ = nullptr;
+        entry->next_ = nullptr;
+        size_--;
+        levelSize_[level]--;
+        place(entry);
+        entry = next;
+    }
+}
+
+void TimerWheel::expire(uint32_t slot, std::vector<Entry*> &expired) {
+    auto *head = &slots_[slot];
+    auto *entry = head->next_;
+    head->prev_ = head;
+    head->next_ = head;
+    occupied_[slot / kWordBits] &= ~(1UL << (slot % kWordBits));
+    while (entry != head) {
+        auto *next = entry->next_;
+        entry->prev_ = nullptr;
+        entry->next_ = nullptr;
+        size_--;
+        levelSize_[0]--;
+        expired.emplace_back(entry);
+        entry = next;
+    }
+}
+
+uint32_t TimerWheel::nextOccupied(uint32_t from) const {
+    auto word = from / kWordBits;
+    auto bits = occupied_[word] & (~0UL << (from % kWordBits));
+    // One more round to check the bits before `from' in the starting word
+    for (auto i = 0U; i <= kWords; i++) {
+        if (bits != 0) {
+            auto slot = word * kWordBits + static_cast<uint32_t>(__builtin_ctzl(bits));
+            return (slot + kSlots - from) & kSlotMask;
+        }
+        word = (word + 1) % kWords;
+        bits = occupied_[word];
+    }
+    return kSlots;
+}
+
+}   // namespace thread
+}   // namespace nebula
@@ -0,0 +1,132 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+#ifndef COMMON_THREAD_TIMERWHEEL_H_
+#define COMMON_THREAD_TIMERWHEEL_H_
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+
+/**
+ * TimerWheel is a hierarchical timing wheel, which keeps a large number of timers
+ * with O(1) insertion and cancellation.
+ *
+ * It consists of `kLevels' wheels, each of which has `kSlots' slots. A slot on level `n'
+ * covers `kSlots^n' ticks, so that four levels of 256 slots, with 1ms tick, cover about
+ * 49 days. Timers beyond that range are parked at the last level and re-placed when
+ * their slot is cascaded.
+ *
+ * The wheel does not own the timers, and it knows nothing about the wall clock.
+ * Users embed `TimerWheel::Entry' into their timer objects, `schedule' them with
+ * an absolute expiration tick, and drive the wheel with `advance', which moves
+ * all expired entries out of the wheel in one batch.
+ *
+ * TimerWheel is not thread safe.
+ */
+
+namespace nebula {
+namespace thread {
+
+class TimerWheel final : public nebula::cpp::NonCopyable, public nebula::cpp::NonMovable {
+public:
+    static constexpr uint32_t kSlotBits   = 8;
+    static constexpr uint32_t kSlots      = 1U << kSlotBits;
+    static constexpr uint32_t kSlotMask   = kSlots - 1;
+    static constexpr uint32_t kLevels     = 4;
+    static constexpr uint64_t kNoExpiry   = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * Intrusive node of the wheel, which is intended to be inherited by the timer.
+     */
+    class Entry {
+    public:
+        Entry() = default;
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+
+        bool isScheduled() const {
+            return prev_ != nullptr;
+        }
+
+        uint64_t expireTick() const {
+            return expireTick_;
+        }
+
+    private:
+        friend class TimerWheel;
+        Entry                                  *prev_{nullptr};
+        Entry                                  *next_{nullptr};
+        uint64_t                                expireTick_{0};
+        uint32_t                                slot_{0};
+    };
+
+    explicit TimerWheel(uint64_t nowTick = 0);
+    ~TimerWheel();
+
+    /**
+     * To put an entry into the wheel.
+     * @entry       an unscheduled entry
+     * @expireTick  absolute tick at which the entry expires,
+     *              an already passed tick expires on the next `advance'
+     */
+    void schedule(Entry *entry, uint64_t expireTick);
+
+    /**
+     * To remove a scheduled entry from the wheel, no-op if it is not scheduled.
+     */
+    void cancel(Entry *entry);
+
+    /**
+     * To process all ticks up to and including `nowTick'.
+     * Expired entries are removed from the wheel and appended to `expired',
+     * in the order of their expiration.
+     * @return  number of expired entries
+     */
+    size_t advance(uint64_t nowTick, std::vector<Entry*> &expired);
+
+    /**
+     * The earliest tick at which `advance' could yield expired entries,
+     * or `kNoExpiry' if the wheel is empty.
+     * Note that it may be earlier than the actual expiration, when higher levels
+     * need to be cascaded before then.
+     */
+    uint64_t nextExpiryTick() const;
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+private:
+    void place(Entry *entry);
+    void link(uint32_t slot, Entry *entry);
+    void unlink(Entry *entry);
+    void cascade(uint32_t level);
+    void expire(uint32_t slot, std::vector<Entry*> &expired);
+    // Offset from `from' to the nearest occupied slot on level 0, or kSlots if none
+    uint32_t nextOccupied(uint32_t from) const;
+
+    static constexpr uint32_t kWordBits = 64;
+    static constexpr uint32_t kWords    = kSlots / kWordBits;
+
+private:
+    // The next tick to be processed
+    uint64_t                                    current_{0};
+    size_t                                      size_{0};
+    // Sentinels of the circular lists, `kSlots' per level
+    std::unique_ptr<Entry[]>                    slots_;
+    // Bitmap of non-empty slots on level 0
+    uint64_t                                    occupied_[kWords];
+    // Number of entries on each level
+    size_t                                      levelSize_[kLevels];
+};
+
+}   // namespace thread
+}   // namespace nebula
+
+#endif  // COMMON_THREAD_TIMERWHEEL_H_
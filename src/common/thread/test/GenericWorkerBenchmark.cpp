@@ -0,0 +1,93 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/thread/GenericWorker.h"
+#include "common/thread/TimerWheel.h"
+
+using nebula::thread::GenericWorker;
+using nebula::thread::TimerWheel;
+
+static constexpr size_t kNumTimers = 1000000;
+// Delays spread from milliseconds up to an hour, like deadlines, back-offs and session expiry
+static constexpr uint64_t kMaxDelayMSec = 3600 * 1000;
+
+struct BenchTimer : public TimerWheel::Entry {
+};
+
+BENCHMARK(timer_wheel_schedule_and_cancel_1M) {
+    std::vector<BenchTimer> timers;
+    std::vector<uint64_t> delays;
+    BENCHMARK_SUSPEND {
+        timers = std::vector<BenchTimer>(kNumTimers);
+        delays.reserve(kNumTimers);
+        for (auto i = 0UL; i < kNumTimers; i++) {
+            delays.emplace_back(folly::Random::rand64(1, kMaxDelayMSec));
+        }
+    }
+    TimerWheel wheel;
+    for (auto i = 0UL; i < kNumTimers; i++) {
+        wheel.schedule(&timers[i], delays[i]);
+    }
+    for (auto &timer : timers) {
+        wheel.cancel(&timer);
+    }
+    folly::doNotOptimizeAway(wheel.size());
+}
+
+BENCHMARK(timer_wheel_schedule_and_expire_1M) {
+    std::vector<BenchTimer> timers;
+    std::vector<uint64_t> delays;
+    std::vector<TimerWheel::Entry*> expired;
+    BENCHMARK_SUSPEND {
+        timers = std::vector<BenchTimer>(kNumTimers);
+        delays.reserve(kNumTimers);
+        for (auto i = 0UL; i < kNumTimers; i++) {
+            delays.emplace_back(folly::Random::rand64(1, kMaxDelayMSec));
+        }
+        expired.reserve(kNumTimers);
+    }
+    TimerWheel wheel;
+    for (auto i = 0UL; i < kNumTimers; i++) {
+        wheel.schedule(&timers[i], delays[i]);
+    }
+    // Advance in steps of 10ms, as the worker would when it is busy
+    for (auto now = 0UL; !wheel.empty(); now += 10) {
+        wheel.advance(now, expired);
+    }
+    folly::doNotOptimizeAway(expired.size());
+}
+
+BENCHMARK(generic_worker_add_and_purge_1M) {
+    GenericWorker worker;
+    std::vector<uint64_t> ids;
+    BENCHMARK_SUSPEND {
+        CHECK(worker.start());
+        ids.reserve(kNumTimers);
+    }
+    for (auto i = 0UL; i < kNumTimers; i++) {
+        auto delay = folly::Random::rand64(1, kMaxDelayMSec);
+        ids.emplace_back(worker.addRepeatTask(delay, [] () {}));
+    }
+    for (auto id : ids) {
+        worker.purgeTimerTask(id);
+    }
+    // Wait for the worker to process all of them
+    worker.addTask([] () {}).get();
+    BENCHMARK_SUSPEND {
+        worker.stop();
+        worker.wait();
+    }
+}
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+
+    folly::runBenchmarks();
+    return 0;
+}
@@ -0,0 +1,125 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/thread/TimerWheel.h"
+
+namespace nebula {
+namespace thread {
+
+struct TestTimer : public TimerWheel::Entry {
+    uint64_t        id{0};
+};
+
+static std::vector<uint64_t> collect(const std::vector<TimerWheel::Entry*> &expired) {
+    std::vector<uint64_t> ids;
+    for (auto *entry : expired) {
+        ids.emplace_back(static_cast<TestTimer*>(entry)->id);
+    }
+    return ids;
+}
+
+TEST(TimerWheel, ScheduleAndAdvance) {
+    TimerWheel wheel(1000);
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(TimerWheel::kNoExpiry, wheel.nextExpiryTick());
+
+    std::vector<TestTimer> timers(3);
+    uint64_t delays[] = {10, 300, 70000};
+    for (auto i = 0U; i < timers.size(); i++) {
+        timers[i].id = i;
+        wheel.schedule(&timers[i], 1000 + delays[i]);
+        ASSERT_TRUE(timers[i].isScheduled());
+    }
+    ASSERT_EQ(3UL, wheel.size());
+    ASSERT_EQ(1010UL, wheel.nextExpiryTick());
+
+    std::vector<TimerWheel::Entry*> expired;
+    ASSERT_EQ(0UL, wheel.advance(1009, expired));
+    ASSERT_EQ(1UL, wheel.advance(1010, expired));
+    ASSERT_EQ(std::vector<uint64_t>({0}), collect(expired));
+    ASSERT_FALSE(timers[0].isScheduled());
+
+    expired.clear();
+    ASSERT_EQ(1UL, wheel.advance(1300, expired));
+    ASSERT_EQ(std::vector<uint64_t>({1}), collect(expired));
+
+    expired.clear();
+    ASSERT_EQ(0UL, wheel.advance(70999, expired));
+    ASSERT_EQ(1UL, wheel.advance(71000, expired));
+    ASSERT_EQ(std::vector<uint64_t>({2}), collect(expired));
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, Cancel) {
+    TimerWheel wheel;
+    std::vector<TestTimer> timers(100);
+    for (auto i = 0U; i < timers.size(); i++) {
+        timers[i].id = i;
+        wheel.schedule(&timers[i], i * 1000);
+    }
+    for (auto i = 0U; i < timers.size(); i += 2) {
+        wheel.cancel(&timers[i]);
+        ASSERT_FALSE(timers[i].isScheduled());
+    }
+    // Cancel twice is harmless
+    wheel.cancel(&timers[0]);
+    ASSERT_EQ(50UL, wheel.size());
+
+    std::vector<TimerWheel::Entry*> expired;
+    ASSERT_EQ(50UL, wheel.advance(100 * 1000, expired));
+    auto ids = collect(expired);
+    for (auto i = 0U; i < ids.size(); i++) {
+        ASSERT_EQ(i * 2 + 1, ids[i]);
+    }
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, PassedAndFarAway) {
+    TimerWheel wheel(5000);
+    TestTimer passed;
+    wheel.schedule(&passed, 100);
+    ASSERT_EQ(5000UL, wheel.nextExpiryTick());
+
+    // Beyond the range of all levels
+    TestTimer far;
+    auto farTick = 5000 + (1UL << 33) + 17;
+    wheel.schedule(&far, farTick);
+
+    std::vector<TimerWheel::Entry*> expired;
+    ASSERT_EQ(1UL, wheel.advance(5000, expired));
+    ASSERT_EQ(&passed, expired.front());
+
+    expired.clear();
+    ASSERT_EQ(0UL, wheel.advance(farTick - 1, expired));
+    ASSERT_EQ(1UL, wheel.advance(farTick, expired));
+    ASSERT_EQ(&far, expired.front());
+}
+
+TEST(TimerWheel, ExpireOnTime) {
+    TimerWheel wheel;
+    std::vector<TestTimer> timers(10000);
+    for (auto i = 0U; i < timers.size(); i++) {
+        timers[i].id = folly::Random::rand64(20000000);
+        wheel.schedule(&timers[i], timers[i].id);
+    }
+    // Driven by `nextExpiryTick', every timer expires exactly at its tick
+    std::vector<TimerWheel::Entry*> expired;
+    auto count = 0UL;
+    while (!wheel.empty()) {
+        auto now = wheel.nextExpiryTick();
+        expired.clear();
+        count += wheel.advance(now, expired);
+        for (auto *entry : expired) {
+            ASSERT_EQ(now, entry->expireTick());
+        }
+    }
+    ASSERT_EQ(timers.size(), count);
+}
+
+}   // namespace thread
+}   // namespace nebula
@@ -0,0 +1,342 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/time/Iso8601.h"
+
+#include <array>
+#include <limits>
+
+#include "common/time/TimeConversion.h"
+
+namespace nebula {
+namespace time {
+
+namespace {
+
+constexpr int64_t kMicrosOfSecond = 1000000;
+constexpr int64_t kMicrosOfMinute = 60 * kMicrosOfSecond;
+constexpr int64_t kMicrosOfHour = 60 * kMicrosOfMinute;
+// The digits of a fraction beyond are ignored, which are below 4 microseconds even
+// of an hour, and the fraction times the microseconds of an hour fits in int64_t
+constexpr size_t kMaxFractionDigits = 9;
+
+// The classes of the characters, as bits
+enum CharClass : uint8_t {
+    kDigit          = 1 << 0,
+    kSign           = 1 << 1,
+    kDecimalMark    = 1 << 2,
+    kDesignator     = 1 << 3,
+    kUtc            = 1 << 4,
+};
+
+constexpr std::array<uint8_t, 256> makeCharClasses() {
+    std::array<uint8_t, 256> classes{};
+    for (auto c = '0'; c <= '9'; c++) {
+        classes[c] = kDigit;
+    }
+    classes['+'] = classes['-'] = kSign;
+    classes['.'] = classes[','] = kDecimalMark;
+    classes['T'] = classes['t'] = classes[' '] = kDesignator;
+    classes['Z'] = classes['z'] = kUtc;
+    return classes;
+}
+
+constexpr auto kCharClasses = makeCharClasses();
+
+class Scanner final {
+public:
+    explicit Scanner(folly::StringPiece str) : p_(str.begin()), end_(str.end()) {}
+
+    bool done() const {
+        return p_ == end_;
+    }
+
+    // Whether the next character is of any of `classes'
+    bool is(uint8_t classes) const {
+        return p_ != end_ && (kCharClasses[static_cast<uint8_t>(*p_)] & classes) != 0;
+    }
+
+    // The next character, which is to be there
+    char next() {
+        return *p_++;
+    }
+
+    bool skip(char c) {
+        if (p_ != end_ && *p_ == c) {
+            p_++;
+            return true;
+        }
+        return false;
+    }
+
+    // The number of the digits from here on
+    size_t digits() const {
+        auto *p = p_;
+        while (p != end_ && (kCharClasses[static_cast<uint8_t>(*p)] & kDigit) != 0) {
+            p++;
+        }
+        return p - p_;
+    }
+
+    // Of the next `n' digits, which are to be there
+    int64_t read(size_t n) {
+        int64_t value = 0;
+        for (; n > 0; n--) {
+            value = value * 10 + (*p_++ - '0');
+        }
+        return value;
+    }
+
+    void advance(size_t n) {
+        p_ += n;
+    }
+
+    // Of the next 2 digits if any, otherwise -1
+    int64_t read2() {
+        return digits() >= 2 ? read(2) : -1;
+    }
+
+    // Of the next 1 or 2 digits if no more, otherwise -1, as std::get_time takes
+    // the fields of the extended format unpadded
+    int64_t readUnpadded() {
+        auto n = digits();
+        return n == 1 || n == 2 ? read(n) : -1;
+    }
+
+private:
+    const char         *p_;
+    const char         *end_;
+};
+
+int64_t daysInMonth(int64_t year, int64_t month) {
+    const int64_t *p = TimeConversion::isLeapYear(year) ? kLeapDaysSoFar : kDaysSoFar;
+    return p[month] - p[month - 1];
+}
+
+// Of the days since the epoch
+int64_t daysOf(const Date &date) {
+    return TimeConversion::dateToUnixSeconds(date) / TimeConversion::kSecondsOfDay;
+}
+
+// 1 for Monday, and 7 for Sunday
+int64_t weekdayOf(int64_t days) {
+    // The epoch is a Thursday
+    return ((days + 3) % 7 + 7) % 7 + 1;
+}
+
+bool fromWeekDate(int64_t year, int64_t week, int64_t weekday, Date &date) {
+    // The week 1 is the one of January 4th, and the last one is of December 28th
+    auto jan4 = daysOf(Date(year, 1, 4));
+    auto monday = jan4 - weekdayOf(jan4) + 1;
+    auto weeks = (daysOf(Date(year, 12, 28)) - monday) / 7 + 1;
+    if (week < 1 || week > weeks || weekday < 1 || weekday > 7) {
+        return false;
+    }
+    auto days = monday + (week - 1) * 7 + weekday - 1;
+    date = TimeConversion::unixSecondsToDate(days * TimeConversion::kSecondsOfDay);
+    // Or it wraps out of the years of Date
+    return date.year - year >= -1 && date.year - year <= 1;
+}
+
+bool fromOrdinalDate(int64_t year, int64_t ordinal, Date &date) {
+    const int64_t *p = TimeConversion::isLeapYear(year) ? kLeapDaysSoFar : kDaysSoFar;
+    if (ordinal < 1 || ordinal > p[12]) {
+        return false;
+    }
+    int64_t month = 1;
+    while (ordinal > p[month]) {
+        month++;
+    }
+    date = Date(year, month, ordinal - p[month - 1]);
+    return true;
+}
+
+bool scanDate(Scanner &scanner, Date &date) {
+    int64_t sign = 0;
+    if (scanner.is(kSign)) {
+        sign = scanner.next() == '-' ? -1 : 1;
+    }
+    auto digits = scanner.digits();
+    if (digits < 4) {
+        return false;
+    }
+    // A signed year may be expanded to 6 digits, which are told from the month and the
+    // day of the basic format by the count
+    auto year = scanner.read(sign != 0 && digits <= 6 ? digits : 4) * (sign < 0 ? -1 : 1);
+    if (year < std::numeric_limits<int16_t>::min() || year > std::numeric_limits<int16_t>::max()) {
+        return false;
+    }
+
+    auto extended = scanner.skip('-');
+    if (scanner.skip('W')) {
+        auto week = scanner.read2();
+        int64_t weekday = 1;
+        if (extended ? scanner.skip('-') : scanner.digits() > 0) {
+            if (scanner.digits() == 0) {
+                return false;
+            }
+            weekday = scanner.read(1);
+        }
+        return fromWeekDate(year, week, weekday, date);
+    }
+
+    int64_t month = 1;
+    int64_t day = 1;
+    switch (scanner.digits()) {
+        case 0:
+            // The year only
+            if (extended) {
+                return false;
+            }
+            break;
+        case 1:
+        case 2:
+            if (!extended) {
+                return false;
+            }
+            month = scanner.readUnpadded();
+            if (scanner.skip('-')) {
+                day = scanner.readUnpadded();
+            }
+            break;
+        case 3:
+            return fromOrdinalDate(year, scanner.read(3), date);
+        case 4:
+            if (extended) {
+                return false;
+            }
+            month = scanner.read(2);
+            day = scanner.read(2);
+            break;
+        default:
+            return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+    date = Date(year, month, day);
+    return true;
+}
+
+bool scanOffset(Scanner &scanner, Iso8601::Offset *offset) {
+    if (scanner.done()) {
+        return true;
+    }
+    if (offset == nullptr) {
+        return false;
+    }
+    if (scanner.is(kUtc)) {
+        scanner.next();
+        *offset = 0;
+        return true;
+    }
+    if (!scanner.is(kSign)) {
+        return false;
+    }
+    auto sign = scanner.next() == '-' ? -1 : 1;
+    auto hour = scanner.read2();
+    int64_t minute = 0;
+    if (scanner.skip(':') || scanner.digits() > 0) {
+        minute = scanner.read2();
+    }
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+        return false;
+    }
+    *offset = sign * (hour * TimeConversion::kSecondsOfHour +
+                      minute * TimeConversion::kSecondsOfMinute);
+    return true;
+}
+
+bool scanTime(Scanner &scanner, Time &time, Iso8601::Offset *offset) {
+    auto unpadded = scanner.digits() == 1;
+    auto hour = unpadded ? scanner.read(1) : scanner.read2();
+    int64_t minute = 0;
+    int64_t sec = 0;
+    // Of the last component, to which the fraction belongs
+    auto unit = kMicrosOfHour;
+    auto extended = scanner.skip(':');
+    if (unpadded && !extended) {
+        return false;
+    }
+    if (extended || scanner.digits() > 0) {
+        minute = extended ? scanner.readUnpadded() : scanner.read2();
+        unit = kMicrosOfMinute;
+        if (extended ? scanner.skip(':') : scanner.digits() > 0) {
+            sec = extended ? scanner.readUnpadded() : scanner.read2();
+            unit = kMicrosOfSecond;
+        }
+    }
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || sec < 0 || sec > 59) {
+        return false;
+    }
+
+    int64_t micros = 0;
+    if (scanner.is(kDecimalMark)) {
+        scanner.next();
+        auto digits = scanner.digits();
+        if (digits == 0) {
+            return false;
+        }
+        auto used = std::min(digits, kMaxFractionDigits);
+        auto fraction = scanner.read(used);
+        scanner.advance(digits - used);
+        int64_t scale = 1;
+        for (size_t i = 0; i < used; i++) {
+            scale *= 10;
+        }
+        micros = fraction * unit / scale;
+    }
+    minute += micros / kMicrosOfMinute;
+    micros %= kMicrosOfMinute;
+    sec += micros / kMicrosOfSecond;
+    time = Time(hour, minute, sec, micros % kMicrosOfSecond);
+    return scanOffset(scanner, offset);
+}
+
+}  // namespace
+
+// static
+StatusOr<Date> Iso8601::parseDate(folly::StringPiece str) {
+    Scanner scanner(str);
+    Date date;
+    if (!scanDate(scanner, date) || !scanner.done()) {
+        return Status::Error("`%s' is not a valid ISO 8601 date.", str.str().c_str());
+    }
+    return date;
+}
+
+// static
+StatusOr<Time> Iso8601::parseTime(folly::StringPiece str, Offset *offset) {
+    Scanner scanner(str);
+    // A time may be designated by 'T'
+    scanner.skip('T');
+    Time time;
+    if (!scanTime(scanner, time, offset) || !scanner.done()) {
+        return Status::Error("`%s' is not a valid ISO 8601 time.", str.str().c_str());
+    }
+    return time;
+}
+
+// static
+StatusOr<DateTime> Iso8601::parseDateTime(folly::StringPiece str, Offset *offset) {
+    Scanner scanner(str);
+    Date date;
+    Time time;
+    // The time is required, as it used to be
+    bool valid = scanDate(scanner, date) && scanner.is(kDesignator);
+    if (valid) {
+        scanner.next();
+        valid = scanTime(scanner, time, offset);
+    }
+    if (!valid || !scanner.done()) {
+        return Status::Error("`%s' is not a valid ISO 8601 date time.", str.str().c_str());
+    }
+    return DateTime(date.year, date.month, date.day,
+                    time.hour, time.minute, time.sec, time.microsec);
+}
+
+}  // namespace time
+}  // namespace nebula
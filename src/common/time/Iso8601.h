@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_TIME_ISO8601_H_
+#define COMMON_TIME_ISO8601_H_
+
+#include <optional>
+
+#include <folly/Range.h>
+
+#include "common/base/StatusOr.h"
+#include "common/datatypes/Date.h"
+
+namespace nebula {
+namespace time {
+
+/**
+ * The parser of the dates and the times of ISO 8601, which scans a string once without
+ * allocating, except for the error. Both the extended format and the basic one are
+ * taken, which are
+ *  - for a date, a calendar date, e.g. 2021-03-04 or 20210304, a month, e.g. 2021-03,
+ *    a year, an ordinal date, e.g. 2021-063, or a week date, e.g. 2021-W09-4, of which
+ *    the year may be signed;
+ *  - for a time, the hour, the minute and the second, e.g. 12:30:15 or 123015, of which
+ *    the lower ones may be omitted and the last one may be fractional down to the
+ *    microseconds, e.g. 12:30:15.25, followed by a UTC offset of Z, ±hh:mm, ±hhmm or ±hh;
+ *  - for a date time, a date and a time separated by 'T' or a space.
+ * The month, the day, the hour, the minute and the second of the extended format may be
+ * unpadded, e.g. 2021-3-4T9:05:00, as std::get_time used to take them.
+ */
+class Iso8601 final {
+public:
+    explicit Iso8601(...) = delete;
+
+    // The local time minus the UTC one in seconds, which is absent for a local time
+    using Offset = std::optional<int32_t>;
+
+    static StatusOr<Date> parseDate(folly::StringPiece str);
+
+    // The offset is not allowed if `offset' is nullptr
+    static StatusOr<Time> parseTime(folly::StringPiece str, Offset *offset);
+
+    // The offset is not allowed if `offset' is nullptr
+    static StatusOr<DateTime> parseDateTime(folly::StringPiece str, Offset *offset);
+};
+
+}  // namespace time
+}  // namespace nebula
+
+#endif  // COMMON_TIME_ISO8601_H_
@@ -18,11 +18,16 @@ class TimeConversion {
 public:
     explicit TimeConversion(...) = delete;
 
-    static int64_t dateTimeDiffSeconds(const DateTime &dateTime0, const DateTime &dateTime1);
+    static int64_t dateTimeDiffSeconds(const DateTime &dateTime0, const DateTime &dateTime1) {
+        return dateTimeToUnixSeconds(dateTime0) - dateTimeToUnixSeconds(dateTime1);
+    }
 
     // unix time
     static int64_t dateTimeToUnixSeconds(const DateTime &dateTime) {
-        return dateTimeDiffSeconds(dateTime, kEpoch);
+        auto days = Date::epochDaysOf(dateTime.year, dateTime.month, dateTime.day);
+        return days * kSecondsOfDay + static_cast<int64_t>(dateTime.hour) * kSecondsOfHour +
+               static_cast<int64_t>(dateTime.minute) * kSecondsOfMinute +
+               static_cast<int64_t>(dateTime.sec);
     }
 
     static DateTime unixSecondsToDateTime(int64_t seconds);
@@ -39,7 +44,7 @@ public:
 
     // unix time
     static int64_t dateToUnixSeconds(const Date &date) {
-        return dateTimeDiffSeconds(DateTime(date), kEpoch);
+        return date.toEpochDays() * kSecondsOfDay;
     }
 
     static Date unixSecondsToDate(int64_t seconds) {
@@ -103,17 +108,6 @@ public:
     static constexpr int64_t kSecondsOfMinute = 60;
     static constexpr int64_t kSecondsOfHour = 60 * kSecondsOfMinute;
     static constexpr int64_t kSecondsOfDay = 24 * kSecondsOfHour;
-
-private:
-    // The result of a right-shift of a signed negative number is implementation-dependent
-    // (UB. see https://en.cppreference.com/w/cpp/language/operator_arithmetic).
-    // So make sure the result is what we expected, if right shift not filled highest bit by the
-    // sign bit that the process will falls back to procedure which fill hightest bit by the sign
-    // bit value.
-    static int64_t shr(int64_t a, int b) {
-        int64_t one = 1;
-        return (-one >> 1 == -1 ? a >> b : (a + (a < 0)) / (one << b) - (a < 0));
-    }
 };
 
 }  // namespace time
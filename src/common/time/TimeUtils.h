@@ -16,6 +16,7 @@
 #include "common/datatypes/Date.h"
 #include "common/datatypes/Map.h"
 #include "common/fs/FileUtils.h"
+#include "common/time/Iso8601.h"
 #include "common/time/TimeConversion.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/time/WallClock.h"
@@ -44,43 +45,49 @@ public:
         return Status::OK();
     }
 
-    // TODO(shylock) support more format
+    // Of ISO 8601, in the configured timezone if the UTC offset is absent
     static StatusOr<DateTime> parseDateTime(const std::string &str) {
-        std::tm tm;
-        std::istringstream ss(str);
-        ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
-        if (ss.fail()) {
-            return Status::Error();
+        Iso8601::Offset offset;
+        auto result = Iso8601::parseDateTime(str, &offset);
+        if (!result.ok() || !offset.has_value()) {
+            return result;
         }
-        DateTime dt;
-        dt.year = tm.tm_year + 1900;
-        dt.month = tm.tm_mon + 1;
-        dt.day = tm.tm_mday;
-        dt.hour = tm.tm_hour;
-        dt.minute = tm.tm_min;
-        dt.sec = tm.tm_sec;
-        dt.microsec = 0;
-        NG_RETURN_IF_ERROR(validateDate(dt));
-        return dt;
+        auto dt = TimeConversion::dateTimeShift(result.value(), -*offset);
+        return utcToDateTime(dt);
     }
 
     static StatusOr<DateTime> dateTimeFromMap(const Map &m);
 
-    // utc + offset = local
+    // utc + offset = local, of which the offset is that of the daylight saving time if it
+    // is in effect
     static DateTime dateTimeToUTC(const DateTime &dateTime) {
-        return TimeConversion::dateTimeShift(dateTime,
-                                             -Timezone::getGlobalTimezone().utcOffsetSecs());
+        return dateTimeToUTC(dateTime, Timezone::getGlobalTimezone());
+    }
+
+    static DateTime dateTimeToUTC(const DateTime &dateTime, const Timezone &timezone) {
+        auto seconds = TimeConversion::dateTimeToUnixSeconds(dateTime);
+        auto dt = TimeConversion::unixSecondsToDateTime(seconds -
+                                                        timezone.localOffsetSecs(seconds));
+        dt.microsec = dateTime.microsec;
+        return dt;
     }
 
     static DateTime utcToDateTime(const DateTime &dateTime) {
-        return TimeConversion::dateTimeShift(dateTime,
-                                             Timezone::getGlobalTimezone().utcOffsetSecs());
+        return utcToDateTime(dateTime, Timezone::getGlobalTimezone());
+    }
+
+    static DateTime utcToDateTime(const DateTime &dateTime, const Timezone &timezone) {
+        auto seconds = TimeConversion::dateTimeToUnixSeconds(dateTime);
+        auto dt = TimeConversion::unixSecondsToDateTime(seconds +
+                                                        timezone.utcOffsetSecs(seconds));
+        dt.microsec = dateTime.microsec;
+        return dt;
     }
 
     static DateTime localDateTime() {
         auto time = unixTime();
         auto dt = TimeConversion::unixSecondsToDateTime(
-            time.seconds - Timezone::getGlobalTimezone().utcOffsetSecs());
+            time.seconds - Timezone::getGlobalTimezone().utcOffsetSecs(time.seconds));
         dt.microsec = time.milliseconds * 1000;
         return dt;
     }
@@ -94,20 +101,9 @@ public:
 
     static StatusOr<Date> dateFromMap(const Map &m);
 
-    // TODO(shylock) support more format
+    // Of ISO 8601
     static StatusOr<Date> parseDate(const std::string &str) {
-        std::tm tm;
-        std::istringstream ss(str);
-        ss >> std::get_time(&tm, "%Y-%m-%d");
-        if (ss.fail()) {
-            return Status::Error();
-        }
-        Date d;
-        d.year = tm.tm_year + 1900;
-        d.month = tm.tm_mon + 1;
-        d.day = tm.tm_mday;
-        NG_RETURN_IF_ERROR(validateDate(d));
-        return d;
+        return Iso8601::parseDate(str);
     }
 
     static StatusOr<Date> localDate() {
@@ -116,8 +112,8 @@ public:
         if (unixTime == -1) {
             return Status::Error("Get unix time failed: %s.", std::strerror(errno));
         }
-        return TimeConversion::unixSecondsToDate(unixTime -
-                                                 Timezone::getGlobalTimezone().utcOffsetSecs());
+        return TimeConversion::unixSecondsToDate(
+            unixTime - Timezone::getGlobalTimezone().utcOffsetSecs(unixTime));
     }
 
     static StatusOr<Date> utcDate() {
@@ -131,20 +127,15 @@ public:
 
     static StatusOr<Time> timeFromMap(const Map &m);
 
-    // TODO(shylock) support more format
+    // Of ISO 8601, in the configured timezone if the UTC offset is absent
     static StatusOr<Time> parseTime(const std::string &str) {
-        std::tm tm;
-        std::istringstream ss(str);
-        ss >> std::get_time(&tm, "%H:%M:%S");
-        if (ss.fail()) {
-            return Status::Error();
+        Iso8601::Offset offset;
+        auto result = Iso8601::parseTime(str, &offset);
+        if (!result.ok() || !offset.has_value()) {
+            return result;
         }
-        Time t;
-        t.hour = tm.tm_hour;
-        t.minute = tm.tm_min;
-        t.sec = tm.tm_sec;
-        t.microsec = 0;
-        return t;
+        return TimeConversion::timeShift(
+            result.value(), Timezone::getGlobalTimezone().utcOffsetSecs() - *offset);
     }
 
     // utc + offset = local
@@ -158,8 +149,8 @@ public:
 
     static Time localTime() {
         auto time = unixTime();
-        auto t = TimeConversion::unixSecondsToTime(time.seconds -
-                                                   Timezone::getGlobalTimezone().utcOffsetSecs());
+        auto t = TimeConversion::unixSecondsToTime(
+            time.seconds - Timezone::getGlobalTimezone().utcOffsetSecs(time.seconds));
         t.microsec = time.milliseconds * 1000;
         return t;
     }
@@ -5,6 +5,10 @@
  */
 
 #include <gflags/gflags.h>
+#include <folly/FileUtil.h>
+
+#include <mutex>
+#include <unordered_map>
 
 #include "common/time/TimezoneInfo.h"
 
@@ -12,6 +16,10 @@ DEFINE_string(timezone_file,
               "share/resources/date_time_zonespec.csv",
               "The file path to the timezone file.");
 
+DEFINE_string(timezone_dir,
+              "/usr/share/zoneinfo",
+              "The directory of the IANA tz files, which are preferred to the timezone file.");
+
 // If it's invalid timezone the service initialize will failed.
 // Empty for system default configuration
 DEFINE_string(timezone_name,
@@ -35,17 +43,64 @@ namespace time {
             FLAGS_timezone_name.append(tz);
         }
     }
-    if (!FLAGS_timezone_name.empty()) {
-        if (FLAGS_timezone_name.front() == ':') {
-            NG_RETURN_IF_ERROR(Timezone::init());
-            return globalTimezone.loadFromDb(
-                std::string(FLAGS_timezone_name.begin() + 1, FLAGS_timezone_name.end()));
-        } else {
-            return globalTimezone.parsePosixTimezone(FLAGS_timezone_name);
-        }
-    } else {
+    return globalTimezone.load(FLAGS_timezone_name);
+}
+
+/*static*/ StatusOr<std::shared_ptr<const Timezone>> Timezone::get(const std::string &name) {
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::shared_ptr<const Timezone>> zones;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto iter = zones.find(name);
+    if (iter != zones.end()) {
+        return iter->second;
+    }
+    auto zone = std::make_shared<Timezone>();
+    NG_RETURN_IF_ERROR(zone->load(name));
+    zones.emplace(name, zone);
+    return zone;
+}
+
+Status Timezone::loadFromTzFile(const std::string &region) {
+    // Or it may escape the directory
+    if (region.empty() || region.front() == '/' || region.find("..") != std::string::npos) {
+        return Status::Error("Not supported timezone `%s'.", region.c_str());
+    }
+    auto path = FLAGS_timezone_dir + "/" + region;
+    std::string data;
+    if (!folly::readFile(path.c_str(), data)) {
+        return Status::Error("Failed to read the timezone file `%s'.", path.c_str());
+    }
+    std::string stdZoneName;
+    int32_t utcOffsetSecs = 0;
+    auto transitions = TzTransitions::parseTzif(
+        folly::ByteRange(folly::StringPiece(data)), &stdZoneName, &utcOffsetSecs);
+    if (!transitions.ok()) {
+        return Status::Error("Invalid timezone file `%s': %s",
+                             path.c_str(),
+                             transitions.status().message().c_str());
+    }
+    stdZoneName_ = std::move(stdZoneName);
+    utcOffsetSecs_ = utcOffsetSecs;
+    transitions_ = std::move(transitions).value();
+    return Status::OK();
+}
+
+Status Timezone::load(const std::string &name) {
+    if (name.empty()) {
         return Status::Error("Don't allowed empty timezone.");
     }
+    if (name.front() != ':') {
+        return parsePosixTimezone(name);
+    }
+    auto region = name.substr(1);
+    if (loadFromTzFile(region).ok()) {
+        return Status::OK();
+    }
+    if (tzdb.region_list().empty()) {
+        NG_RETURN_IF_ERROR(Timezone::init());
+    }
+    return loadFromDb(region);
 }
 
 }   // namespace time
@@ -11,11 +11,15 @@
 #include <gflags/gflags_declare.h>
 
 #include <exception>
+#include <memory>
 
 #include "common/base/Base.h"
 #include "common/base/Status.h"
+#include "common/base/StatusOr.h"
+#include "common/time/TzTransitions.h"
 
 DECLARE_string(timezone_file);
+DECLARE_string(timezone_dir);
 
 namespace nebula {
 namespace time {
@@ -36,17 +40,21 @@ public:
     }
 
     MUST_USE_RESULT Status loadFromDb(const std::string &region) {
-        zoneInfo_ = tzdb.time_zone_from_region(region);
-        if (zoneInfo_ == nullptr) {
+        auto zoneInfo = tzdb.time_zone_from_region(region);
+        if (zoneInfo == nullptr) {
             return Status::Error("Not supported timezone `%s'.", region.c_str());
         }
+        setZone(*zoneInfo);
         return Status::OK();
     }
 
+    // Of the IANA tz file of `region' under --timezone_dir, e.g. America/New_York
+    MUST_USE_RESULT Status loadFromTzFile(const std::string &region);
+
     // see the posix timezone literal format in https://man7.org/linux/man-pages/man3/tzset.3.html
     MUST_USE_RESULT Status parsePosixTimezone(const std::string &posixTimezone) {
         try {
-            zoneInfo_.reset(new ::boost::local_time::posix_time_zone(posixTimezone));
+            setZone(::boost::local_time::posix_time_zone(posixTimezone));
         } catch (const std::exception &e) {
             return Status::Error("Malformed timezone format: `%s', exception: `%s'.",
                                  posixTimezone.c_str(),
@@ -56,16 +64,30 @@ public:
     }
 
     std::string stdZoneName() const {
-        return DCHECK_NOTNULL(zoneInfo_)->std_zone_name();
+        return stdZoneName_;
     }
 
-    // offset in seconds
+    // offset of the standard time in seconds
     int32_t utcOffsetSecs() const {
-        return DCHECK_NOTNULL(zoneInfo_)->base_utc_offset().total_seconds();
+        return utcOffsetSecs_;
+    }
+
+    // offset in seconds at the UTC instant `unixSeconds', of the daylight saving time if
+    // it is in effect
+    int32_t utcOffsetSecs(int64_t unixSeconds) const {
+        return transitions_ == nullptr ? utcOffsetSecs_ : transitions_->offsetOf(unixSeconds);
+    }
+
+    // offset in seconds of the local time `localSeconds', see TzTransitions::offsetOfLocal()
+    int32_t localOffsetSecs(int64_t localSeconds) const {
+        return transitions_ == nullptr ? utcOffsetSecs_
+                                       : transitions_->offsetOfLocal(localSeconds);
     }
 
-    // TODO(shylock) Get Timzone info(I.E. GMT offset) directly from IANA tzdb
-    // to support non-global timezone configuration
+    // Of a name of the format of --timezone_name, which is loaded once for the process and
+    // shared since, so that each session may keep its own timezone
+    static StatusOr<std::shared_ptr<const Timezone>> get(const std::string &name);
+
     // See the timezone format from https://man7.org/linux/man-pages/man3/tzset.3.html
     static Status initializeGlobalTimezone();
 
@@ -74,12 +96,24 @@ public:
     }
 
 private:
+    // Of a region prefixed by ':', which is looked up in the IANA tz files, then in the
+    // timezone file, or of a posix timezone literal
+    MUST_USE_RESULT Status load(const std::string &name);
+
+    void setZone(const TzTransitions::BoostZone &zoneInfo) {
+        stdZoneName_ = zoneInfo.std_zone_name();
+        utcOffsetSecs_ = zoneInfo.base_utc_offset().total_seconds();
+        transitions_ = TzTransitions::fromZone(zoneInfo);
+    }
+
     static ::boost::local_time::tz_database tzdb;
 
     static Timezone globalTimezone;
 
-    ::boost::shared_ptr<::boost::date_time::time_zone_base<::boost::posix_time::ptime, char>>
-        zoneInfo_{nullptr};
+    std::string                                 stdZoneName_;
+    int32_t                                     utcOffsetSecs_{0};
+    // nullptr before a zone is loaded, i.e. of UTC
+    std::shared_ptr<const TzTransitions>        transitions_;
 };
 
 }   // namespace time
@@ -0,0 +1,491 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/time/TzTransitions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+#include "common/time/TimeConversion.h"
+
+namespace nebula {
+namespace time {
+
+namespace {
+
+using Transition = TzTransitions::Transition;
+
+// Beyond the UTC offset of any zone, so that a local time is within it of its UTC one
+constexpr int64_t kMaxOffset = TimeConversion::kSecondsOfDay;
+constexpr int64_t kAverageSecondsOfYear = 31556952;
+
+std::atomic<uint64_t> nextId{1};
+
+// The interval of the last search of the thread
+struct LastInterval {
+    uint64_t        id{0};
+    int64_t         begin{0};
+    int64_t         end{0};
+    int32_t         offset{0};
+};
+
+thread_local LastInterval lastInterval;
+
+// Sorts the transitions, dropping those superseded at the same instants and those which
+// change nothing
+std::vector<Transition> normalize(int32_t offset, std::vector<Transition> transitions) {
+    std::stable_sort(transitions.begin(), transitions.end(),
+                     [] (const Transition &lhs, const Transition &rhs) {
+                         return lhs.utc < rhs.utc;
+                     });
+    std::vector<Transition> result;
+    result.reserve(transitions.size());
+    for (const auto &transition : transitions) {
+        if (!result.empty() && result.back().utc == transition.utc) {
+            result.pop_back();
+        }
+        if (transition.offset != (result.empty() ? offset : result.back().offset)) {
+            result.push_back(transition);
+        }
+    }
+    return result;
+}
+
+int64_t daysOf(int64_t year, int64_t month, int64_t day) {
+    return TimeConversion::dateToUnixSeconds(Date(year, month, day)) /
+           TimeConversion::kSecondsOfDay;
+}
+
+/**
+ * Appends the transitions into and out of the daylight saving time of the years from
+ * `from' to kMaxYear, of which the local times are given by `startOf' in the standard
+ * time and by `endOf' in the daylight saving time.
+ */
+template <typename StartOf, typename EndOf>
+void expandYears(int64_t from,
+                 int32_t stdOffset,
+                 int32_t dstOffset,
+                 StartOf startOf,
+                 EndOf endOf,
+                 std::vector<Transition> &transitions) {
+    for (auto year = from; year <= TzTransitions::kMaxYear; year++) {
+        Transition start{startOf(year) - stdOffset, dstOffset};
+        Transition end{endOf(year) - dstOffset, stdOffset};
+        // Of the southern hemisphere, the daylight saving time spans the new year
+        if (end.utc < start.utc) {
+            std::swap(start, end);
+        }
+        transitions.emplace_back(start);
+        transitions.emplace_back(end);
+    }
+}
+
+// The date of a rule of a POSIX TZ string, with the local time of the transition
+struct RuleDate {
+    // 'M' for Mm.w.d, 'J' for Jn, i.e. the day of a year ignoring February 29th, and
+    // 'n' for the zero-based day of a year
+    char            kind{'n'};
+    int64_t         month{0};
+    int64_t         week{0};
+    int64_t         weekday{0};
+    int64_t         day{0};
+    int64_t         time{2 * TimeConversion::kSecondsOfHour};
+};
+
+// The local time of the rule in the year, in the seconds since the local epoch
+int64_t localOf(int64_t year, const RuleDate &date) {
+    int64_t days = 0;
+    switch (date.kind) {
+        case 'M': {
+            auto first = daysOf(year, date.month, 1);
+            auto next = date.month == 12 ? daysOf(year + 1, 1, 1) : daysOf(year, date.month + 1, 1);
+            // The epoch is a Thursday, and 0 is for Sunday
+            auto weekday = ((first + 4) % 7 + 7) % 7;
+            days = first + (date.weekday - weekday + 7) % 7 + (date.week - 1) * 7;
+            // The week 5 is the last one of the month
+            while (days >= next) {
+                days -= 7;
+            }
+            break;
+        }
+        case 'J':
+            days = daysOf(year, 1, 1) + date.day - 1 +
+                   (TimeConversion::isLeapYear(year) && date.day >= 60 ? 1 : 0);
+            break;
+        default:
+            days = daysOf(year, 1, 1) + date.day;
+            break;
+    }
+    return days * TimeConversion::kSecondsOfDay + date.time;
+}
+
+// The rules of the footer of a TZif file, see tzset(3)
+struct PosixTz {
+    std::string     stdName;
+    int32_t         stdOffset{0};
+    bool            hasDst{false};
+    int32_t         dstOffset{0};
+    RuleDate        start;
+    RuleDate        end;
+};
+
+bool scanName(folly::StringPiece &str, std::string &name) {
+    size_t n = 0;
+    if (str.startsWith('<')) {
+        auto end = str.find('>');
+        if (end == folly::StringPiece::npos) {
+            return false;
+        }
+        name = str.subpiece(1, end - 1).str();
+        str.advance(end + 1);
+        return !name.empty();
+    }
+    while (n < str.size() && std::isalpha(static_cast<unsigned char>(str[n]))) {
+        n++;
+    }
+    if (n < 3) {
+        return false;
+    }
+    name = str.subpiece(0, n).str();
+    str.advance(n);
+    return true;
+}
+
+bool scanNumber(folly::StringPiece &str, int64_t &value) {
+    size_t n = 0;
+    value = 0;
+    while (n < str.size() && n < 3 && std::isdigit(static_cast<unsigned char>(str[n]))) {
+        value = value * 10 + (str[n] - '0');
+        n++;
+    }
+    str.advance(n);
+    return n > 0;
+}
+
+// Of [+-]hh[:mm[:ss]], of which the hours are up to 167
+bool scanHms(folly::StringPiece &str, int64_t &seconds) {
+    int64_t sign = 1;
+    if (str.startsWith('+') || str.startsWith('-')) {
+        sign = str.front() == '-' ? -1 : 1;
+        str.advance(1);
+    }
+    int64_t hour = 0;
+    int64_t minute = 0;
+    int64_t sec = 0;
+    if (!scanNumber(str, hour)) {
+        return false;
+    }
+    if (str.startsWith(':')) {
+        str.advance(1);
+        if (!scanNumber(str, minute)) {
+            return false;
+        }
+        if (str.startsWith(':')) {
+            str.advance(1);
+            if (!scanNumber(str, sec)) {
+                return false;
+            }
+        }
+    }
+    if (hour > 167 || minute > 59 || sec > 59) {
+        return false;
+    }
+    seconds = sign * (hour * TimeConversion::kSecondsOfHour +
+                      minute * TimeConversion::kSecondsOfMinute + sec);
+    return true;
+}
+
+bool scanRuleDate(folly::StringPiece &str, RuleDate &date) {
+    if (str.startsWith('M')) {
+        str.advance(1);
+        date.kind = 'M';
+        if (!scanNumber(str, date.month) || !str.startsWith('.')) {
+            return false;
+        }
+        str.advance(1);
+        if (!scanNumber(str, date.week) || !str.startsWith('.')) {
+            return false;
+        }
+        str.advance(1);
+        if (!scanNumber(str, date.weekday)) {
+            return false;
+        }
+        if (date.month < 1 || date.month > 12 || date.week < 1 || date.week > 5 ||
+            date.weekday > 6) {
+            return false;
+        }
+    } else if (str.startsWith('J')) {
+        str.advance(1);
+        date.kind = 'J';
+        if (!scanNumber(str, date.day) || date.day < 1 || date.day > 365) {
+            return false;
+        }
+    } else {
+        date.kind = 'n';
+        if (!scanNumber(str, date.day) || date.day > 365) {
+            return false;
+        }
+    }
+    if (str.startsWith('/')) {
+        str.advance(1);
+        return scanHms(str, date.time);
+    }
+    return true;
+}
+
+// The offsets of a POSIX TZ string are those of UTC from the local time
+bool parsePosixTz(folly::StringPiece str, PosixTz &tz) {
+    int64_t offset = 0;
+    if (!scanName(str, tz.stdName) || !scanHms(str, offset)) {
+        return false;
+    }
+    tz.stdOffset = -offset;
+    if (str.empty()) {
+        return true;
+    }
+    std::string dstName;
+    if (!scanName(str, dstName)) {
+        return false;
+    }
+    tz.hasDst = true;
+    tz.dstOffset = tz.stdOffset + TimeConversion::kSecondsOfHour;
+    if (!str.startsWith(',')) {
+        if (!scanHms(str, offset)) {
+            return false;
+        }
+        tz.dstOffset = -offset;
+    }
+    // The rules are always there in a TZif file
+    if (!str.startsWith(',')) {
+        return false;
+    }
+    str.advance(1);
+    if (!scanRuleDate(str, tz.start) || !str.startsWith(',')) {
+        return false;
+    }
+    str.advance(1);
+    return scanRuleDate(str, tz.end) && str.empty();
+}
+
+uint32_t readUint32(const uint8_t *p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint64_t readUint64(const uint8_t *p) {
+    return (static_cast<uint64_t>(readUint32(p)) << 32) | readUint32(p + 4);
+}
+
+// The header of a data block of a TZif file
+struct TzifHeader {
+    static constexpr size_t kSize = 44;
+
+    uint8_t         version;
+    size_t          isutcnt;
+    size_t          isstdcnt;
+    size_t          leapcnt;
+    size_t          timecnt;
+    size_t          typecnt;
+    size_t          charcnt;
+
+    // Of the data block following, of which the times are of `timeSize' bytes
+    size_t blockSize(size_t timeSize) const {
+        return timecnt * (timeSize + 1) + typecnt * 6 + charcnt + leapcnt * (timeSize + 4) +
+               isstdcnt + isutcnt;
+    }
+};
+
+bool readHeader(folly::ByteRange &data, TzifHeader &header) {
+    if (data.size() < TzifHeader::kSize || std::memcmp(data.data(), "TZif", 4) != 0) {
+        return false;
+    }
+    const auto *p = data.data();
+    header.version = p[4];
+    header.isutcnt = readUint32(p + 20);
+    header.isstdcnt = readUint32(p + 24);
+    header.leapcnt = readUint32(p + 28);
+    header.timecnt = readUint32(p + 32);
+    header.typecnt = readUint32(p + 36);
+    header.charcnt = readUint32(p + 40);
+    data.advance(TzifHeader::kSize);
+    return true;
+}
+
+}  // namespace
+
+TzTransitions::TzTransitions(int32_t initialOffset, std::vector<Transition> transitions)
+    : id_(nextId++),
+      initialOffset_(initialOffset),
+      transitions_(normalize(initialOffset, std::move(transitions))) {
+}
+
+// static
+StatusOr<std::shared_ptr<const TzTransitions>>
+TzTransitions::parseTzif(folly::ByteRange data, std::string *stdName, int32_t *stdOffset) {
+    TzifHeader header;
+    if (!readHeader(data, header)) {
+        return Status::Error("Not a TZif file.");
+    }
+    // The 32-bit data block of the version 1 is followed by a 64-bit one since the version 2
+    size_t timeSize = 4;
+    if (header.version >= '2') {
+        if (data.size() < header.blockSize(4)) {
+            return Status::Error("Truncated TZif file.");
+        }
+        data.advance(header.blockSize(4));
+        if (!readHeader(data, header)) {
+            return Status::Error("Malformed TZif file of the version %c.", header.version);
+        }
+        timeSize = 8;
+    }
+    if (header.typecnt == 0 || header.charcnt == 0 || data.size() < header.blockSize(timeSize)) {
+        return Status::Error("Truncated TZif file.");
+    }
+
+    const auto *times = data.data();
+    const auto *indexes = times + header.timecnt * timeSize;
+    const auto *types = indexes + header.timecnt;
+    const auto *chars = types + header.typecnt * 6;
+    auto offsetOfType = [types] (size_t i) {
+        return static_cast<int32_t>(readUint32(types + i * 6));
+    };
+    auto isDstType = [types] (size_t i) {
+        return types[i * 6 + 4] != 0;
+    };
+
+    std::vector<Transition> transitions;
+    transitions.reserve(header.timecnt);
+    // The last type of the standard time
+    size_t stdType = 0;
+    for (size_t i = 0; i < header.timecnt; i++) {
+        if (indexes[i] >= header.typecnt) {
+            return Status::Error("Malformed TZif file of the type %u.", indexes[i]);
+        }
+        auto utc = timeSize == 8
+            ? static_cast<int64_t>(readUint64(times + i * 8))
+            : static_cast<int64_t>(static_cast<int32_t>(readUint32(times + i * 4)));
+        transitions.emplace_back(Transition{utc, offsetOfType(indexes[i])});
+        if (!isDstType(indexes[i])) {
+            stdType = indexes[i];
+        }
+    }
+    auto desigIndex = types[stdType * 6 + 5];
+    if (desigIndex >= header.charcnt) {
+        return Status::Error("Malformed TZif file of the designation %u.", desigIndex);
+    }
+    const auto *desig = reinterpret_cast<const char *>(chars + desigIndex);
+    std::string name(desig, strnlen(desig, header.charcnt - desigIndex));
+    auto offset = offsetOfType(stdType);
+    data.advance(header.blockSize(timeSize));
+
+    // The footer of the rules beyond the last transition, which is empty if there are none
+    if (timeSize == 8 && data.size() > 1 && data.front() == '\n') {
+        folly::StringPiece footer(data);
+        footer.advance(1);
+        auto end = footer.find('\n');
+        if (end == folly::StringPiece::npos) {
+            return Status::Error("Malformed TZif footer.");
+        }
+        footer = footer.subpiece(0, end);
+        if (!footer.empty()) {
+            PosixTz tz;
+            if (!parsePosixTz(footer, tz)) {
+                return Status::Error("Not supported TZif footer `%s'.", footer.str().c_str());
+            }
+            name = tz.stdName;
+            offset = tz.stdOffset;
+            if (tz.hasDst) {
+                auto last = transitions.empty() ? std::numeric_limits<int64_t>::min()
+                                                : transitions.back().utc;
+                // A year before that of the last transition, as that is approximate
+                auto from = transitions.empty() ? kMinYear : 1969 + last / kAverageSecondsOfYear;
+                from = std::max(kMinYear, std::min(from, kMaxYear + 1));
+                std::vector<Transition> expanded;
+                expandYears(from, tz.stdOffset, tz.dstOffset,
+                            [&tz] (int64_t year) { return localOf(year, tz.start); },
+                            [&tz] (int64_t year) { return localOf(year, tz.end); },
+                            expanded);
+                for (const auto &transition : expanded) {
+                    if (transition.utc > last) {
+                        transitions.emplace_back(transition);
+                    }
+                }
+            }
+        }
+    }
+
+    if (stdName != nullptr) {
+        *stdName = std::move(name);
+    }
+    if (stdOffset != nullptr) {
+        *stdOffset = offset;
+    }
+    // The time type 0 is of the times before the first transition
+    return std::make_shared<const TzTransitions>(offsetOfType(0), std::move(transitions));
+}
+
+// static
+std::shared_ptr<const TzTransitions> TzTransitions::fromZone(const BoostZone &zone) {
+    int32_t stdOffset = zone.base_utc_offset().total_seconds();
+    if (!zone.has_dst()) {
+        return std::make_shared<const TzTransitions>(stdOffset, std::vector<Transition>());
+    }
+    int32_t dstOffset = stdOffset + zone.dst_offset().total_seconds();
+    const ::boost::posix_time::ptime epoch(::boost::gregorian::date(1970, 1, 1));
+    auto secondsOf = [&epoch] (const ::boost::posix_time::ptime &local) {
+        return static_cast<int64_t>((local - epoch).total_seconds());
+    };
+    std::vector<Transition> transitions;
+    transitions.reserve(2 * (kMaxYear - kMinYear + 1));
+    expandYears(kMinYear, stdOffset, dstOffset,
+                [&] (int64_t year) { return secondsOf(zone.dst_local_start_time(year)); },
+                [&] (int64_t year) { return secondsOf(zone.dst_local_end_time(year)); },
+                transitions);
+    // Of the southern hemisphere, a year begins in the daylight saving time
+    auto initialOffset = transitions.front().offset == stdOffset ? dstOffset : stdOffset;
+    return std::make_shared<const TzTransitions>(initialOffset, std::move(transitions));
+}
+
+int32_t TzTransitions::offsetOf(int64_t unixSeconds) const {
+    auto &last = lastInterval;
+    if (last.id == id_ && unixSeconds >= last.begin && unixSeconds < last.end) {
+        return last.offset;
+    }
+    auto it = std::upper_bound(transitions_.begin(), transitions_.end(), unixSeconds,
+                               [] (int64_t utc, const Transition &transition) {
+                                   return utc < transition.utc;
+                               });
+    last.id = id_;
+    if (it == transitions_.begin()) {
+        last.begin = std::numeric_limits<int64_t>::min();
+        last.offset = initialOffset_;
+    } else {
+        last.begin = std::prev(it)->utc;
+        last.offset = std::prev(it)->offset;
+    }
+    last.end = it == transitions_.end() ? std::numeric_limits<int64_t>::max() : it->utc;
+    return last.offset;
+}
+
+int32_t TzTransitions::offsetOfLocal(int64_t localSeconds) const {
+    // The offsets around the local time, which differ if it is near a transition
+    auto before = offsetOf(localSeconds - kMaxOffset);
+    auto after = offsetOf(localSeconds + kMaxOffset);
+    if (before == after || offsetOf(localSeconds - before) == before) {
+        return before;
+    }
+    if (offsetOf(localSeconds - after) == after) {
+        return after;
+    }
+    // Skipped
+    return before;
+}
+
+}  // namespace time
+}  // namespace nebula
@@ -0,0 +1,87 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_TIME_TZTRANSITIONS_H_
+#define COMMON_TIME_TZTRANSITIONS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/local_time/local_time.hpp>
+#include <folly/Range.h>
+
+#include "common/base/StatusOr.h"
+
+namespace nebula {
+namespace time {
+
+/**
+ * The UTC offsets of a timezone over time, compiled into the sorted instants at which
+ * they change, so that the offset of an instant is a binary search. The interval of
+ * the last search is cached per thread, which is hit by most of the instants of a scan.
+ *
+ * The rules of the daylight saving time are expanded up to kMaxYear, beyond which the
+ * offset of the last transition holds.
+ */
+class TzTransitions final {
+public:
+    static constexpr int64_t kMinYear = 1900;
+    static constexpr int64_t kMaxYear = 2100;
+
+    // From `utc' on, the local time is the UTC one plus `offset' seconds
+    struct Transition {
+        int64_t         utc;
+        int32_t         offset;
+    };
+
+    using BoostZone = ::boost::date_time::time_zone_base<::boost::posix_time::ptime, char>;
+
+    // `transitions' are to be sorted by the instants
+    TzTransitions(int32_t initialOffset, std::vector<Transition> transitions);
+
+    /**
+     * Of a TZif file of RFC 8536, i.e. one of the IANA tz database as compiled by zic,
+     * of which the POSIX TZ string in the footer is expanded beyond the transitions.
+     * The name and the offset of the standard time are returned by `stdName' and
+     * `stdOffset' if not nullptr.
+     */
+    static StatusOr<std::shared_ptr<const TzTransitions>> parseTzif(folly::ByteRange data,
+                                                                    std::string *stdName,
+                                                                    int32_t *stdOffset);
+
+    // Of the rules of a zone of boost, from kMinYear to kMaxYear
+    static std::shared_ptr<const TzTransitions> fromZone(const BoostZone &zone);
+
+    // Of the UTC instant `unixSeconds'
+    int32_t offsetOf(int64_t unixSeconds) const;
+
+    /**
+     * Of the local time `localSeconds', i.e. the seconds since the local epoch. The
+     * earlier one is taken for an ambiguous local time, and the one before the transition
+     * for a skipped one, which moves it later by the length of the gap.
+     */
+    int32_t offsetOfLocal(int64_t localSeconds) const;
+
+    int32_t initialOffset() const {
+        return initialOffset_;
+    }
+
+    const std::vector<Transition>& transitions() const {
+        return transitions_;
+    }
+
+private:
+    // Tells the tables apart in the caches of the threads, unlike their addresses
+    const uint64_t                      id_;
+    const int32_t                       initialOffset_;
+    const std::vector<Transition>       transitions_;
+};
+
+}  // namespace time
+}  // namespace nebula
+
+#endif  // COMMON_TIME_TZTRANSITIONS_H_
@@ -0,0 +1,96 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <iomanip>
+#include <folly/Benchmark.h>
+#include "common/time/Iso8601.h"
+
+using nebula::DateTime;
+using nebula::time::Iso8601;
+
+static const std::vector<std::string> kDateTimes = {
+    "2020-08-01T09:00:00",
+    "1984-10-11T12:31:14",
+    "2021-03-04T23:59:59",
+    "1970-01-01T00:00:00",
+};
+
+// As TimeUtils::parseDateTime() used to be
+static bool streamParse(const std::string &str, DateTime &dt) {
+    std::tm tm;
+    std::istringstream ss(str);
+    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    if (ss.fail()) {
+        return false;
+    }
+    dt = DateTime(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                  tm.tm_hour, tm.tm_min, tm.tm_sec, 0);
+    return true;
+}
+
+BENCHMARK(stream_parse, iters) {
+    DateTime dt;
+    for (uint32_t i = 0; i < iters; i++) {
+        folly::doNotOptimizeAway(streamParse(kDateTimes[i % kDateTimes.size()], dt));
+    }
+}
+BENCHMARK_RELATIVE(iso8601_parse, iters) {
+    Iso8601::Offset offset;
+    for (uint32_t i = 0; i < iters; i++) {
+        auto result = Iso8601::parseDateTime(kDateTimes[i % kDateTimes.size()], &offset);
+        folly::doNotOptimizeAway(result);
+    }
+}
+BENCHMARK_RELATIVE(iso8601_parse_fraction_offset, iters) {
+    Iso8601::Offset offset;
+    std::string str = "2020-08-01T09:00:00.123456+08:00";
+    for (uint32_t i = 0; i < iters; i++) {
+        auto result = Iso8601::parseDateTime(str, &offset);
+        folly::doNotOptimizeAway(result);
+    }
+}
+
+BENCHMARK_DRAW_LINE();
+
+// As DateTime::toString() used to be
+BENCHMARK(printf_format, iters) {
+    DateTime dt(2020, 8, 1, 9, 0, 0, 123456);
+    for (uint32_t i = 0; i < iters; i++) {
+        auto str = folly::stringPrintf("%hd-%02hhu-%02hhu"
+                                       "T%02hhu:%02hhu:%02hhu.%u",
+                                       static_cast<int16_t>(dt.year),
+                                       static_cast<uint8_t>(dt.month),
+                                       static_cast<uint8_t>(dt.day),
+                                       static_cast<uint8_t>(dt.hour),
+                                       static_cast<uint8_t>(dt.minute),
+                                       static_cast<uint8_t>(dt.sec),
+                                       static_cast<uint32_t>(dt.microsec));
+        folly::doNotOptimizeAway(str);
+    }
+}
+BENCHMARK_RELATIVE(to_string, iters) {
+    DateTime dt(2020, 8, 1, 9, 0, 0, 123456);
+    for (uint32_t i = 0; i < iters; i++) {
+        auto str = dt.toString();
+        folly::doNotOptimizeAway(str);
+    }
+}
+BENCHMARK_RELATIVE(format_to_buffer, iters) {
+    DateTime dt(2020, 8, 1, 9, 0, 0, 123456);
+    char buf[nebula::kTimeFormatBufferSize];
+    for (uint32_t i = 0; i < iters; i++) {
+        folly::doNotOptimizeAway(dt.format(buf));
+    }
+}
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+
+    folly::runBenchmarks();
+    return 0;
+}
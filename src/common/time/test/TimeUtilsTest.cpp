@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 
 #include "common/base/Base.h"
+#include "common/time/Iso8601.h"
 #include "common/time/TimeUtils.h"
 #include "common/time/TimezoneInfo.h"
 
@@ -163,6 +164,83 @@ TEST(Time, TimezoneShift) {
     }
 }
 
+TEST(Time, Iso8601) {
+    time::Iso8601::Offset offset;
+    // Calendar, ordinal and week dates, in the extended and the basic formats
+    std::vector<std::pair<std::string, Date>> dates{
+        {"2020-08-01", Date(2020, 8, 1)},
+        {"20200801", Date(2020, 8, 1)},
+        {"2020-08", Date(2020, 8, 1)},
+        {"2020", Date(2020, 1, 1)},
+        {"2020-366", Date(2020, 12, 31)},
+        {"2021060", Date(2021, 3, 1)},
+        {"2009-W01-1", Date(2008, 12, 29)},
+        {"2009W537", Date(2010, 1, 3)},
+        {"-0044-03-15", Date(-44, 3, 15)},
+        // Unpadded, as std::get_time takes
+        {"2021-3-4", Date(2021, 3, 4)},
+        {"2021-03-4", Date(2021, 3, 4)},
+    };
+    for (const auto &date : dates) {
+        auto result = time::Iso8601::parseDate(date.first);
+        ASSERT_TRUE(result.ok()) << date.first;
+        EXPECT_EQ(date.second, result.value()) << date.first;
+    }
+    for (auto str : {"", "2021-02-29", "2020-13-01", "2020-0801", "202008", "2021-366",
+                     "2021-W53-1", "2020-08-01T00:00", "2021-3-", "2021-3-123", "202134",
+                     "202-03-04"}) {
+        EXPECT_FALSE(time::Iso8601::parseDate(str).ok()) << str;
+    }
+
+    {
+        auto result = time::Iso8601::parseDateTime("2020-08-01T09:30:15.123456", &offset);
+        ASSERT_TRUE(result.ok());
+        EXPECT_EQ(DateTime(2020, 8, 1, 9, 30, 15, 123456), result.value());
+        EXPECT_FALSE(offset.has_value());
+    }
+    {
+        // Of the fraction of a minute, and an offset
+        auto result = time::Iso8601::parseDateTime("20200801T0930,5-0530", &offset);
+        ASSERT_TRUE(result.ok());
+        EXPECT_EQ(DateTime(2020, 8, 1, 9, 30, 30, 0), result.value());
+        EXPECT_EQ(-(5 * 3600 + 30 * 60), offset.value());
+    }
+    {
+        auto result = time::Iso8601::parseTime("T12:34:56.789Z", &offset);
+        ASSERT_TRUE(result.ok());
+        EXPECT_EQ(Time(12, 34, 56, 789000), result.value());
+        EXPECT_EQ(0, offset.value());
+    }
+    {
+        auto result = time::Iso8601::parseDateTime("2021-3-4T9:5:3", &offset);
+        ASSERT_TRUE(result.ok());
+        EXPECT_EQ(DateTime(2021, 3, 4, 9, 5, 3, 0), result.value());
+    }
+    EXPECT_FALSE(time::Iso8601::parseTime("12:34:56+01:00", nullptr).ok());
+    // The time is required
+    for (auto str : {"2020-08-01", "2020-08-01T", "2020-08-01T24:00", "2020-08-01T12:60",
+                     "2020-08-01T12:00:00.", "2020-08-01T12:00+2400", "2020-08-01T12:00Zx",
+                     "2020-08-01X12:00", "2020-08-01T9", "2020-08-01T9:123"}) {
+        EXPECT_FALSE(time::Iso8601::parseDateTime(str, &offset).ok()) << str;
+    }
+
+    // Accepted as before
+    EXPECT_EQ(Date(2021, 3, 4), time::TimeUtils::parseDate("2021-3-4").value());
+    EXPECT_FALSE(time::TimeUtils::parseDateTime("2021-03-04").ok());
+
+    // In the configured timezone
+    {
+        auto result = time::TimeUtils::parseDateTime("2020-08-01T09:00:00Z");
+        ASSERT_TRUE(result.ok());
+        EXPECT_EQ(DateTime(2020, 8, 1, 9, 0, 0, 0), time::TimeUtils::dateTimeToUTC(result.value()));
+    }
+
+    // Formatted as before
+    EXPECT_EQ("1984-10-11T12:31:14.341", DateTime(1984, 10, 11, 12, 31, 14, 341).toString());
+    EXPECT_EQ("-44-03-05", Date(-44, 3, 5).toString());
+    EXPECT_EQ("01:02:03.000045", Time(1, 2, 3, 45).toString());
+}
+
 }   // namespace nebula
 
 int main(int argc, char **argv) {
@@ -7,6 +7,49 @@
 #include <gtest/gtest.h>
 
 #include "common/time/TimezoneInfo.h"
+#include "common/time/TzTransitions.h"
+
+// A TZif file of the version 2 of the zone of EST and EDT, of which the data block of the
+// version 1 is empty
+static std::string makeTzif(const std::vector<std::pair<int64_t, uint8_t>> &transitions,
+                            const std::string &footer) {
+    std::string data;
+    auto put32 = [&data] (uint32_t value) {
+        for (auto shift = 24; shift >= 0; shift -= 8) {
+            data.push_back(static_cast<char>(value >> shift));
+        }
+    };
+    auto putHeader = [&] (uint32_t timecnt, uint32_t typecnt, uint32_t charcnt) {
+        data.append("TZif2");
+        data.append(15, '\0');
+        // isutcnt, isstdcnt and leapcnt
+        put32(0);
+        put32(0);
+        put32(0);
+        put32(timecnt);
+        put32(typecnt);
+        put32(charcnt);
+    };
+    putHeader(0, 0, 0);
+    putHeader(transitions.size(), 2, 8);
+    for (const auto &transition : transitions) {
+        put32(static_cast<uint64_t>(transition.first) >> 32);
+        put32(static_cast<uint32_t>(transition.first));
+    }
+    for (const auto &transition : transitions) {
+        data.push_back(static_cast<char>(transition.second));
+    }
+    // EST and EDT, of the offset, whether it is the daylight saving time and the designation
+    put32(static_cast<uint32_t>(-5 * 60 * 60));
+    data.push_back(0);
+    data.push_back(0);
+    put32(static_cast<uint32_t>(-4 * 60 * 60));
+    data.push_back(1);
+    data.push_back(4);
+    data.append("EST\0EDT\0", 8);
+    data.append("\n" + footer + "\n");
+    return data;
+}
 
 TEST(TimezoneInfo, PosixTimezone) {
     {
@@ -41,6 +84,87 @@ TEST(TimezoneInfo, PosixTimezoneInvalid) {
     ASSERT_FALSE(tz.parsePosixTimezone(posixTimezone).ok());
 }
 
+TEST(TimezoneInfo, DaylightSavingTime) {
+    const std::string posixTimezone =
+        "EST-05:00:00EDT+01:00:00,M4.1.0/02:00:00,M10.5.0/02:00:00";
+    nebula::time::Timezone tz;
+    ASSERT_TRUE(tz.parsePosixTimezone(posixTimezone).ok());
+
+    // 2021-04-04T07:00:00Z, i.e. 02:00 of the first Sunday of April in EST
+    EXPECT_EQ(-5 * 60 * 60, tz.utcOffsetSecs(1617519600 - 1));
+    EXPECT_EQ(-4 * 60 * 60, tz.utcOffsetSecs(1617519600));
+    // 2021-10-31T06:00:00Z, i.e. 02:00 of the last Sunday of October in EDT
+    EXPECT_EQ(-4 * 60 * 60, tz.utcOffsetSecs(1635660000 - 1));
+    EXPECT_EQ(-5 * 60 * 60, tz.utcOffsetSecs(1635660000));
+    // The standard one
+    EXPECT_EQ(-5 * 60 * 60, tz.utcOffsetSecs());
+
+    // 2021-07-01T12:00:00 of the local time
+    EXPECT_EQ(-4 * 60 * 60, tz.localOffsetSecs(1625140800));
+    // 2021-04-04T02:30:00 of the local time is skipped, which is taken as in EST
+    EXPECT_EQ(-5 * 60 * 60, tz.localOffsetSecs(1617503400));
+    // 2021-10-31T01:30:00 of the local time is ambiguous, which is taken as the earlier
+    EXPECT_EQ(-4 * 60 * 60, tz.localOffsetSecs(1635643800));
+}
+
+TEST(TimezoneInfo, Tzif) {
+    using nebula::time::TzTransitions;
+    // From 2007-03-11T07:00:00Z to 2007-11-04T06:00:00Z in EDT, then by the footer
+    auto data = makeTzif({{1173596400, 1}, {1194156000, 0}}, "EST5EDT,M3.2.0,M11.1.0");
+    std::string stdName;
+    int32_t stdOffset = 0;
+    auto result = TzTransitions::parseTzif(
+        folly::ByteRange(folly::StringPiece(data)), &stdName, &stdOffset);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto transitions = std::move(result).value();
+    EXPECT_EQ("EST", stdName);
+    EXPECT_EQ(-5 * 60 * 60, stdOffset);
+
+    EXPECT_EQ(-5 * 60 * 60, transitions->offsetOf(1173596400 - 1));
+    EXPECT_EQ(-4 * 60 * 60, transitions->offsetOf(1173596400));
+    EXPECT_EQ(-5 * 60 * 60, transitions->offsetOf(1194156000));
+    // 2021-03-14T07:00:00Z and 2021-11-07T06:00:00Z, by the footer
+    EXPECT_EQ(-5 * 60 * 60, transitions->offsetOf(1615705200 - 1));
+    EXPECT_EQ(-4 * 60 * 60, transitions->offsetOf(1615705200));
+    EXPECT_EQ(-4 * 60 * 60, transitions->offsetOf(1636264800 - 1));
+    EXPECT_EQ(-5 * 60 * 60, transitions->offsetOf(1636264800));
+    // Beyond the years expanded
+    EXPECT_EQ(-5 * 60 * 60, transitions->offsetOf(std::numeric_limits<int64_t>::max()));
+
+    // Without a footer, the last offset holds
+    data = makeTzif({{1173596400, 1}}, "");
+    result = TzTransitions::parseTzif(folly::ByteRange(folly::StringPiece(data)), &stdName,
+                                      &stdOffset);
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(-4 * 60 * 60, result.value()->offsetOf(1615705200 - 1));
+
+    // Malformed
+    for (const auto &footer : {"EST5EDT", "EST5EDT,M3.2.0", "EST5EDT,M13.2.0,M11.1.0"}) {
+        data = makeTzif({}, footer);
+        EXPECT_FALSE(TzTransitions::parseTzif(folly::ByteRange(folly::StringPiece(data)),
+                                              nullptr, nullptr).ok()) << footer;
+    }
+    data = makeTzif({{1173596400, 2}}, "");
+    EXPECT_FALSE(TzTransitions::parseTzif(folly::ByteRange(folly::StringPiece(data)),
+                                          nullptr, nullptr).ok());
+    data.resize(60);
+    EXPECT_FALSE(TzTransitions::parseTzif(folly::ByteRange(folly::StringPiece(data)),
+                                          nullptr, nullptr).ok());
+}
+
+TEST(TimezoneInfo, Get) {
+    auto result = nebula::time::Timezone::get("EST-05:00:00EDT+01:00:00,M4.1.0,M10.5.0");
+    ASSERT_TRUE(result.ok()) << result.status();
+    // Loaded once
+    auto again = nebula::time::Timezone::get("EST-05:00:00EDT+01:00:00,M4.1.0,M10.5.0");
+    ASSERT_TRUE(again.ok()) << again.status();
+    EXPECT_EQ(result.value().get(), again.value().get());
+    EXPECT_EQ(-4 * 60 * 60, result.value()->utcOffsetSecs(1625140800));
+
+    EXPECT_FALSE(nebula::time::Timezone::get("").ok());
+    EXPECT_FALSE(nebula::time::Timezone::get(":../etc/passwd").ok());
+}
+
 
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);